@@ -10,6 +10,7 @@ class pkgRecipe(ConanFile):
     requires = [
         "abseil/20240722.0",
         "argparse/3.2",
+        "benchmark/1.9.0",
         "gtest/1.15.0",
     ]
 
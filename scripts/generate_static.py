@@ -20,6 +20,10 @@ ClassDef = TypedDict(
         'note': NotRequired[str],
         'template-arguments-count': NotRequired[int],
         'template-arguments': NotRequired[list[str]],
+        # Whether the type needs complete definitions of its template arguments. Defaults to false for templates declared with
+        # template-arguments-count, because they can't use their arguments. source2gen forward-declares arguments of templates that don't
+        # odr-use them instead of including their headers.
+        'odr-uses-arguments': NotRequired[bool],
     },
 )
 ClassDefs: TypeAlias = dict[str, ClassDef]
@@ -54,13 +58,8 @@ def classes_iter(classes: ClassDefs) -> tuple[str, ClassDef]:
     yield from sorted(classes.items(), key=lambda c: c[0])
 
 
-def assemble_cpp(classes: ClassDefs) -> str:
-    result = [
-        AUTOGENERATED_WARNING,
-        '#pragma once',
-        '#include <string_view>',
-        '',
-    ]
+def cpp_declarations(classes: ClassDefs) -> list[str]:
+    result = []
 
     for name, class_def in classes_iter(classes):
         if template := cpp_gen_template(class_def.get('template-arguments'), class_def.get('template-arguments-count')):
@@ -98,6 +97,34 @@ def assemble_cpp(classes: ClassDefs) -> str:
         )
     )
 
+    return result
+
+
+def assemble_cpp(classes: ClassDefs) -> str:
+    result = [
+        AUTOGENERATED_WARNING,
+        '#pragma once',
+        '#include <string_view>',
+        '',
+        *cpp_declarations(classes),
+    ]
+
+    return '\n'.join(result) + '\n'
+
+
+def assemble_cpp_module(classes: ClassDefs) -> str:
+    result = [
+        AUTOGENERATED_WARNING,
+        'module;',
+        '#include <string_view>',
+        'export module source2sdk.source2gen;',
+        '',
+        '// attached to the global module, so interfaces::g_schema can be defined outside of this module',
+        'export extern "C++" {',
+        *cpp_declarations(classes),
+        '}',
+    ]
+
     return '\n'.join(result) + '\n'
 
 
@@ -122,8 +149,26 @@ def assemble_c(classes: ClassDefs) -> str:
     return '\n'.join(result) + '\n'
 
 
-def dump_to(cwd: Path, language: str, filename: str, content: str) -> None:
-    cpp_dir = cwd / 'sdk-static' / language / 'include' / 'source2sdk' / 'source2gen'
+def odr_uses_arguments(class_def: ClassDef) -> bool:
+    return class_def.get('odr-uses-arguments', 'template-arguments' in class_def)
+
+
+def assemble_non_odr_templates(classes: ClassDefs) -> str:
+    result = [
+        AUTOGENERATED_WARNING.replace('//', '#'),
+        '# Templates that don\'t odr-use their template arguments. Read by source2gen.',
+    ]
+
+    for name, class_def in classes_iter(classes):
+        if class_def.get('template-arguments-count') or class_def.get('template-arguments'):
+            if not odr_uses_arguments(class_def):
+                result.append(name)
+
+    return '\n'.join(result) + '\n'
+
+
+def dump_to(cwd: Path, language: str, filename: str, content: str, directory: Path = Path('include/source2sdk/source2gen')) -> None:
+    cpp_dir = cwd / 'sdk-static' / language / directory
     cpp_dir.mkdir(parents=True, exist_ok=True)
 
     output_file = cpp_dir / filename
@@ -141,9 +186,16 @@ def main() -> None:
     cpp = assemble_cpp(toml_file)
     dump_to(cwd, 'cpp', 'source2gen.hpp', cpp)
 
+    cpp_module = assemble_cpp_module(toml_file)
+    dump_to(cwd, 'cpp-modules', 'source2sdk.source2gen.cppm', cpp_module, Path('modules'))
+
     c = assemble_c(toml_file)
     dump_to(cwd, 'c', 'source2gen.h', c)
 
+    non_odr_templates = assemble_non_odr_templates(toml_file)
+    (cwd / 'sdk-static' / 'non-odr-templates.txt').write_text(non_odr_templates)
+    status(f'Wrote {len(non_odr_templates)} bytes to non-odr-templates.txt')
+
 
 if __name__ == '__main__':
     main()
@@ -0,0 +1,675 @@
+#pragma once
+
+// Reader of schema.bin, which source2gen writes with --emit-language schema-bin.
+// The file is a flat array of records that reference each other by index and refer to names by offset into a string table. It is used as it
+// is, nothing is parsed or copied. Map it with MappedFile, processes that map the same file share its pages.
+//
+//   auto file = source2sdk::schema::MappedFile::Open("sdk/schema.bin");
+//   auto view = source2sdk::schema::View::FromBytes(file->bytes());
+//   auto health = view->FindClass("client", "C_BaseEntity")->FindField("m_iHealth")->offset();
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <optional>
+#include <span>
+#include <string_view>
+#include <utility>
+
+#if defined(_WIN32)
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <Windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace source2sdk::schema {
+    /// Layout of schema.bin. All integers are little-endian, all offsets are relative to the start of the file. Records are 8-byte aligned.
+    namespace format {
+        inline constexpr char kMagic[8] = {'S', '2', 'S', 'C', 'H', 'E', 'M', 'A'};
+        /// Incremented on every change of the layout
+        inline constexpr std::uint32_t kVersion = 1;
+        /// Marks a missing record index, e.g. of a class without base class
+        inline constexpr std::uint32_t kNone = 0xffffffff;
+
+        /// Range of records
+        struct Table {
+            std::uint64_t offset;
+            std::uint64_t count;
+        };
+
+        /// Range of @ref Header::strings. Strings are null-terminated, the terminator is not included in @ref size.
+        struct String {
+            std::uint32_t offset;
+            std::uint32_t size;
+        };
+
+        /// Range of records in another table
+        struct Range {
+            std::uint32_t first;
+            std::uint32_t count;
+        };
+
+        struct Header {
+            char magic[8];
+            std::uint32_t version;
+            std::uint32_t reserved;
+            std::uint64_t file_size;
+            /// Characters
+            Table strings;
+            /// @ref Module, sorted by name
+            Table modules;
+            /// @ref Class, grouped by module, sorted by name within a module
+            Table classes;
+            /// @ref Field
+            Table fields;
+            /// @ref Enum, grouped by module, sorted by name within a module
+            Table enums;
+            /// @ref Enumerator
+            Table enumerators;
+            /// @ref Metadata
+            Table metadata;
+            /// @ref NameIndex of @ref classes, sorted by hash
+            Table class_index;
+            /// @ref NameIndex of @ref enums, sorted by hash
+            Table enum_index;
+        };
+
+        struct Module {
+            String name;
+            Range classes;
+            Range enums;
+        };
+
+        struct Class {
+            String name;
+            String module;
+            std::uint32_t size;
+            /// Alignment the game has registered for the class, 0 if it hasn't
+            std::uint32_t alignment;
+            /// SchemaClassFlags_t
+            std::uint32_t flags;
+            /// Index into @ref Header::classes, @ref kNone if the class has no base class or its base class is not in the file
+            std::uint32_t base_class;
+            Range fields;
+            Range metadata;
+        };
+
+        struct Field {
+            String name;
+            /// Schema name of the type, e.g. "CHandle< C_BaseEntity >"
+            String type_name;
+            std::uint32_t offset;
+            /// 0 if unknown
+            std::uint32_t size;
+            Range metadata;
+        };
+
+        struct Enum {
+            String name;
+            String module;
+            std::uint32_t size;
+            std::uint32_t alignment;
+            Range enumerators;
+            Range metadata;
+        };
+
+        struct Enumerator {
+            String name;
+            Range metadata;
+            std::uint64_t value;
+        };
+
+        struct Metadata {
+            String name;
+            /// Empty if the entry has no value
+            String value;
+        };
+
+        struct NameIndex {
+            /// @ref HashName() of the record's name
+            std::uint64_t hash;
+            std::uint32_t record;
+            std::uint32_t reserved;
+        };
+
+        /// FNV-1a
+        [[nodiscard]] constexpr std::uint64_t HashName(std::string_view name) {
+            std::uint64_t hash = 0xcbf29ce484222325ull;
+
+            for (const auto c : name) {
+                hash = (hash ^ static_cast<std::uint8_t>(c)) * 1099511628211ull;
+            }
+
+            return hash;
+        }
+    } // namespace format
+
+    class View;
+
+    /// A record of @ref View. Lifetime bound to the view.
+    template <typename Record>
+    class RecordView {
+    public:
+        RecordView(const View& view, const Record& record) : _view(&view), _record(&record) { }
+
+        [[nodiscard]] const Record& record() const {
+            return *_record;
+        }
+
+    protected:
+        const View* _view;
+        const Record* _record;
+    };
+
+    /// Records of @p Record in a @ref format::Range, wrapped in @p Wrapper
+    template <typename Record, typename Wrapper>
+    class RangeView {
+    public:
+        class iterator {
+        public:
+            using value_type = Wrapper;
+            using difference_type = std::ptrdiff_t;
+
+            iterator() = default;
+            iterator(const View* view, const Record* record) : _view(view), _record(record) { }
+
+            [[nodiscard]] Wrapper operator*() const {
+                return Wrapper{*_view, *_record};
+            }
+
+            iterator& operator++() {
+                ++_record;
+                return *this;
+            }
+
+            iterator operator++(int) {
+                auto result = *this;
+                ++_record;
+                return result;
+            }
+
+            [[nodiscard]] bool operator==(const iterator& other) const {
+                return _record == other._record;
+            }
+
+        private:
+            const View* _view{};
+            const Record* _record{};
+        };
+
+        RangeView(const View& view, std::span<const Record> records) : _view(&view), _records(records) { }
+
+        [[nodiscard]] iterator begin() const {
+            return iterator{_view, _records.data()};
+        }
+
+        [[nodiscard]] iterator end() const {
+            return iterator{_view, _records.data() + _records.size()};
+        }
+
+        [[nodiscard]] std::size_t size() const {
+            return _records.size();
+        }
+
+        [[nodiscard]] bool empty() const {
+            return _records.empty();
+        }
+
+        [[nodiscard]] Wrapper operator[](std::size_t i) const {
+            return Wrapper{*_view, _records[i]};
+        }
+
+    private:
+        const View* _view;
+        std::span<const Record> _records;
+    };
+
+    class MetadataView : public RecordView<format::Metadata> {
+    public:
+        using RecordView::RecordView;
+
+        [[nodiscard]] std::string_view name() const;
+        [[nodiscard]] std::string_view value() const;
+    };
+
+    using MetadataRange = RangeView<format::Metadata, MetadataView>;
+
+    class FieldView : public RecordView<format::Field> {
+    public:
+        using RecordView::RecordView;
+
+        [[nodiscard]] std::string_view name() const;
+        [[nodiscard]] std::string_view type_name() const;
+
+        [[nodiscard]] std::uint32_t offset() const {
+            return _record->offset;
+        }
+
+        [[nodiscard]] std::uint32_t size() const {
+            return _record->size;
+        }
+
+        [[nodiscard]] MetadataRange metadata() const;
+    };
+
+    class ClassView : public RecordView<format::Class> {
+    public:
+        using RecordView::RecordView;
+
+        [[nodiscard]] std::string_view name() const;
+        [[nodiscard]] std::string_view module() const;
+
+        [[nodiscard]] std::uint32_t size() const {
+            return _record->size;
+        }
+
+        [[nodiscard]] std::uint32_t alignment() const {
+            return _record->alignment;
+        }
+
+        [[nodiscard]] std::uint32_t flags() const {
+            return _record->flags;
+        }
+
+        [[nodiscard]] std::optional<ClassView> base_class() const;
+        [[nodiscard]] RangeView<format::Field, FieldView> fields() const;
+        [[nodiscard]] MetadataRange metadata() const;
+
+        /// Only searches fields that are declared by this class, not those of its base classes
+        [[nodiscard]] std::optional<FieldView> FindField(std::string_view field_name) const;
+    };
+
+    class EnumeratorView : public RecordView<format::Enumerator> {
+    public:
+        using RecordView::RecordView;
+
+        [[nodiscard]] std::string_view name() const;
+
+        [[nodiscard]] std::uint64_t value() const {
+            return _record->value;
+        }
+
+        [[nodiscard]] MetadataRange metadata() const;
+    };
+
+    class EnumView : public RecordView<format::Enum> {
+    public:
+        using RecordView::RecordView;
+
+        [[nodiscard]] std::string_view name() const;
+        [[nodiscard]] std::string_view module() const;
+
+        [[nodiscard]] std::uint32_t size() const {
+            return _record->size;
+        }
+
+        [[nodiscard]] std::uint32_t alignment() const {
+            return _record->alignment;
+        }
+
+        [[nodiscard]] RangeView<format::Enumerator, EnumeratorView> enumerators() const;
+        [[nodiscard]] MetadataRange metadata() const;
+
+        [[nodiscard]] std::optional<EnumeratorView> FindEnumerator(std::string_view enumerator_name) const;
+    };
+
+    class ModuleView : public RecordView<format::Module> {
+    public:
+        using RecordView::RecordView;
+
+        [[nodiscard]] std::string_view name() const;
+        [[nodiscard]] RangeView<format::Class, ClassView> classes() const;
+        [[nodiscard]] RangeView<format::Enum, EnumView> enums() const;
+    };
+
+    /// Queries a schema.bin in memory without copying it. The bytes must outlive the view and must be 8-byte aligned, which memory mappings are.
+    class View {
+    public:
+        /// Checks the header and that every table is inside of @p bytes. Record indices and string offsets are checked when they are used.
+        /// @return @ref std::nullopt if @p bytes is not a schema.bin of this version
+        [[nodiscard]] static std::optional<View> FromBytes(std::span<const std::byte> bytes) {
+            if ((bytes.size() < sizeof(format::Header)) || ((reinterpret_cast<std::uintptr_t>(bytes.data()) % alignof(format::Header)) != 0)) {
+                return std::nullopt;
+            }
+
+            const auto* header = reinterpret_cast<const format::Header*>(bytes.data());
+
+            if ((std::memcmp(header->magic, format::kMagic, sizeof(format::kMagic)) != 0) || (header->version != format::kVersion) ||
+                (header->file_size != bytes.size())) {
+                return std::nullopt;
+            }
+
+            View result{bytes};
+
+            const bool tables_fit = result.IsTableValid<char>(header->strings) && result.IsTableValid<format::Module>(header->modules) &&
+                                    result.IsTableValid<format::Class>(header->classes) && result.IsTableValid<format::Field>(header->fields) &&
+                                    result.IsTableValid<format::Enum>(header->enums) &&
+                                    result.IsTableValid<format::Enumerator>(header->enumerators) &&
+                                    result.IsTableValid<format::Metadata>(header->metadata) &&
+                                    result.IsTableValid<format::NameIndex>(header->class_index) &&
+                                    result.IsTableValid<format::NameIndex>(header->enum_index);
+
+            if (!tables_fit) {
+                return std::nullopt;
+            }
+
+            return result;
+        }
+
+        [[nodiscard]] const format::Header& header() const {
+            return *reinterpret_cast<const format::Header*>(_bytes.data());
+        }
+
+        [[nodiscard]] RangeView<format::Module, ModuleView> modules() const {
+            return {*this, GetTable<format::Module>(header().modules)};
+        }
+
+        [[nodiscard]] RangeView<format::Class, ClassView> classes() const {
+            return {*this, GetTable<format::Class>(header().classes)};
+        }
+
+        [[nodiscard]] RangeView<format::Enum, EnumView> enums() const {
+            return {*this, GetTable<format::Enum>(header().enums)};
+        }
+
+        /// Binary search in the module table
+        [[nodiscard]] std::optional<ModuleView> FindModule(std::string_view module_name) const {
+            const auto modules = GetTable<format::Module>(header().modules);
+            const auto it = std::lower_bound(modules.begin(), modules.end(), module_name,
+                                             [this](const format::Module& module, std::string_view name) { return GetString(module.name) < name; });
+
+            if ((it != modules.end()) && (GetString(it->name) == module_name)) {
+                return ModuleView{*this, *it};
+            }
+
+            return std::nullopt;
+        }
+
+        /// Binary search in the class name index
+        /// @return The first class named @p class_name if there is more than one
+        [[nodiscard]] std::optional<ClassView> FindClass(std::string_view class_name) const {
+            return FindByName<format::Class, ClassView>(header().class_index, header().classes, {}, class_name);
+        }
+
+        [[nodiscard]] std::optional<ClassView> FindClass(std::string_view module_name, std::string_view class_name) const {
+            return FindByName<format::Class, ClassView>(header().class_index, header().classes, module_name, class_name);
+        }
+
+        /// @return The first enum named @p enum_name if there is more than one
+        [[nodiscard]] std::optional<EnumView> FindEnum(std::string_view enum_name) const {
+            return FindByName<format::Enum, EnumView>(header().enum_index, header().enums, {}, enum_name);
+        }
+
+        [[nodiscard]] std::optional<EnumView> FindEnum(std::string_view module_name, std::string_view enum_name) const {
+            return FindByName<format::Enum, EnumView>(header().enum_index, header().enums, module_name, enum_name);
+        }
+
+        /// @return An empty string if @p string is out of bounds
+        [[nodiscard]] std::string_view GetString(format::String string) const {
+            const auto strings = GetTable<char>(header().strings);
+
+            if ((static_cast<std::uint64_t>(string.offset) + string.size) > strings.size()) {
+                return {};
+            }
+
+            return {strings.data() + string.offset, string.size};
+        }
+
+        /// @return An empty span if @p range is out of bounds
+        template <typename Record>
+        [[nodiscard]] std::span<const Record> GetRange(const format::Table& table, format::Range range) const {
+            const auto records = GetTable<Record>(table);
+
+            if ((static_cast<std::uint64_t>(range.first) + range.count) > records.size()) {
+                return {};
+            }
+
+            return records.subspan(range.first, range.count);
+        }
+
+        template <typename Record>
+        [[nodiscard]] std::span<const Record> GetTable(const format::Table& table) const {
+            return {reinterpret_cast<const Record*>(_bytes.data() + table.offset), static_cast<std::size_t>(table.count)};
+        }
+
+    private:
+        explicit View(std::span<const std::byte> bytes) : _bytes(bytes) { }
+
+        template <typename Record>
+        [[nodiscard]] bool IsTableValid(const format::Table& table) const {
+            return ((table.offset % alignof(Record)) == 0) && (table.offset <= _bytes.size()) &&
+                   (table.count <= ((_bytes.size() - table.offset) / sizeof(Record)));
+        }
+
+        /// @param module_name Empty to accept any module
+        template <typename Record, typename Wrapper>
+        [[nodiscard]] std::optional<Wrapper> FindByName(const format::Table& index_table, const format::Table& record_table,
+                                                        std::string_view module_name, std::string_view name) const {
+            const auto index = GetTable<format::NameIndex>(index_table);
+            const auto records = GetTable<Record>(record_table);
+            const auto hash = format::HashName(name);
+            auto it = std::lower_bound(index.begin(), index.end(), hash, [](const format::NameIndex& entry, std::uint64_t value) { return entry.hash < value; });
+
+            for (; (it != index.end()) && (it->hash == hash); ++it) {
+                if (it->record >= records.size()) {
+                    continue;
+                }
+
+                const auto& record = records[it->record];
+
+                if ((GetString(record.name) == name) && (module_name.empty() || (GetString(record.module) == module_name))) {
+                    return Wrapper{*this, record};
+                }
+            }
+
+            return std::nullopt;
+        }
+
+        std::span<const std::byte> _bytes;
+    };
+
+    inline std::string_view MetadataView::name() const {
+        return _view->GetString(_record->name);
+    }
+
+    inline std::string_view MetadataView::value() const {
+        return _view->GetString(_record->value);
+    }
+
+    inline std::string_view FieldView::name() const {
+        return _view->GetString(_record->name);
+    }
+
+    inline std::string_view FieldView::type_name() const {
+        return _view->GetString(_record->type_name);
+    }
+
+    inline MetadataRange FieldView::metadata() const {
+        return {*_view, _view->GetRange<format::Metadata>(_view->header().metadata, _record->metadata)};
+    }
+
+    inline std::string_view ClassView::name() const {
+        return _view->GetString(_record->name);
+    }
+
+    inline std::string_view ClassView::module() const {
+        return _view->GetString(_record->module);
+    }
+
+    inline std::optional<ClassView> ClassView::base_class() const {
+        const auto classes = _view->GetTable<format::Class>(_view->header().classes);
+
+        if (_record->base_class >= classes.size()) {
+            return std::nullopt;
+        }
+
+        return ClassView{*_view, classes[_record->base_class]};
+    }
+
+    inline RangeView<format::Field, FieldView> ClassView::fields() const {
+        return {*_view, _view->GetRange<format::Field>(_view->header().fields, _record->fields)};
+    }
+
+    inline MetadataRange ClassView::metadata() const {
+        return {*_view, _view->GetRange<format::Metadata>(_view->header().metadata, _record->metadata)};
+    }
+
+    inline std::optional<FieldView> ClassView::FindField(std::string_view field_name) const {
+        for (const auto field : fields()) {
+            if (field.name() == field_name) {
+                return field;
+            }
+        }
+
+        return std::nullopt;
+    }
+
+    inline std::string_view EnumeratorView::name() const {
+        return _view->GetString(_record->name);
+    }
+
+    inline MetadataRange EnumeratorView::metadata() const {
+        return {*_view, _view->GetRange<format::Metadata>(_view->header().metadata, _record->metadata)};
+    }
+
+    inline std::string_view EnumView::name() const {
+        return _view->GetString(_record->name);
+    }
+
+    inline std::string_view EnumView::module() const {
+        return _view->GetString(_record->module);
+    }
+
+    inline RangeView<format::Enumerator, EnumeratorView> EnumView::enumerators() const {
+        return {*_view, _view->GetRange<format::Enumerator>(_view->header().enumerators, _record->enumerators)};
+    }
+
+    inline MetadataRange EnumView::metadata() const {
+        return {*_view, _view->GetRange<format::Metadata>(_view->header().metadata, _record->metadata)};
+    }
+
+    inline std::optional<EnumeratorView> EnumView::FindEnumerator(std::string_view enumerator_name) const {
+        for (const auto enumerator : enumerators()) {
+            if (enumerator.name() == enumerator_name) {
+                return enumerator;
+            }
+        }
+
+        return std::nullopt;
+    }
+
+    inline std::string_view ModuleView::name() const {
+        return _view->GetString(_record->name);
+    }
+
+    inline RangeView<format::Class, ClassView> ModuleView::classes() const {
+        return {*_view, _view->GetRange<format::Class>(_view->header().classes, _record->classes)};
+    }
+
+    inline RangeView<format::Enum, EnumView> ModuleView::enums() const {
+        return {*_view, _view->GetRange<format::Enum>(_view->header().enums, _record->enums)};
+    }
+
+    /// Read-only, shared memory mapping of a file
+    class MappedFile {
+    public:
+        /// @return @ref std::nullopt if the file can't be opened or mapped
+        [[nodiscard]] static std::optional<MappedFile> Open(const char* path) {
+#if defined(_WIN32)
+            const auto file = CreateFileA(path, GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+            if (file == INVALID_HANDLE_VALUE) {
+                return std::nullopt;
+            }
+
+            LARGE_INTEGER size{};
+            const auto mapping = GetFileSizeEx(file, &size) ? CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr) : nullptr;
+            CloseHandle(file);
+
+            if (mapping == nullptr) {
+                return std::nullopt;
+            }
+
+            const auto* data = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+            CloseHandle(mapping);
+
+            if (data == nullptr) {
+                return std::nullopt;
+            }
+
+            return MappedFile{static_cast<const std::byte*>(data), static_cast<std::size_t>(size.QuadPart)};
+#else
+            const auto file = open(path, O_RDONLY | O_CLOEXEC);
+            if (file == -1) {
+                return std::nullopt;
+            }
+
+            struct stat status {};
+            void* data = MAP_FAILED;
+
+            if ((fstat(file, &status) == 0) && (status.st_size > 0)) {
+                data = mmap(nullptr, static_cast<std::size_t>(status.st_size), PROT_READ, MAP_SHARED, file, 0);
+            }
+
+            close(file);
+
+            if (data == MAP_FAILED) {
+                return std::nullopt;
+            }
+
+            return MappedFile{static_cast<const std::byte*>(data), static_cast<std::size_t>(status.st_size)};
+#endif
+        }
+
+        MappedFile(MappedFile&& other) noexcept : _data(std::exchange(other._data, nullptr)), _size(std::exchange(other._size, 0)) { }
+
+        MappedFile& operator=(MappedFile&& other) noexcept {
+            if (this != &other) {
+                Unmap();
+                _data = std::exchange(other._data, nullptr);
+                _size = std::exchange(other._size, 0);
+            }
+
+            return *this;
+        }
+
+        MappedFile(const MappedFile&) = delete;
+        MappedFile& operator=(const MappedFile&) = delete;
+
+        ~MappedFile() {
+            Unmap();
+        }
+
+        [[nodiscard]] std::span<const std::byte> bytes() const {
+            return {_data, _size};
+        }
+
+    private:
+        MappedFile(const std::byte* data, std::size_t size) : _data(data), _size(size) { }
+
+        void Unmap() {
+            if (_data == nullptr) {
+                return;
+            }
+
+#if defined(_WIN32)
+            UnmapViewOfFile(_data);
+#else
+            munmap(const_cast<std::byte*>(_data), _size);
+#endif
+            _data = nullptr;
+        }
+
+        const std::byte* _data;
+        std::size_t _size;
+    };
+} // namespace source2sdk::schema
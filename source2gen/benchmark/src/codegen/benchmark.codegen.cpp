@@ -0,0 +1,167 @@
+#include "tools/codegen/cpp.h"
+#include <benchmark/benchmark.h>
+#include <format>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace {
+    constexpr std::size_t kFileCount = 500;
+    constexpr std::size_t kFieldCount = 60;
+
+    struct SyntheticField {
+        std::string type_name{};
+        std::string name{};
+        int offset{};
+    };
+
+    [[nodiscard]] std::vector<SyntheticField> MakeFields() {
+        std::vector<SyntheticField> result(kFieldCount);
+
+        for (std::size_t i = 0; i < result.size(); ++i) {
+            result[i] = SyntheticField{.type_name = (i % 3 == 0) ? "source2sdk::client::CSyntheticHandle" : "std::int32_t",
+                                       .name = std::format("m_nSyntheticField{}", i),
+                                       .offset = static_cast<int>(8 + i * 4)};
+        }
+
+        return result;
+    }
+
+    /// The line emission of the generators before they wrote to a reusable buffer. Every line created a string of spaces and was flushed with
+    /// std::endl, @ref str() copied the stream.
+    class LegacyGenerator {
+    public:
+        LegacyGenerator& begin_namespace(std::string_view namespace_name) {
+            return begin_block(std::format("namespace {}", namespace_name));
+        }
+
+        LegacyGenerator& end_namespace() {
+            return end_block();
+        }
+
+        LegacyGenerator& begin_class(const std::string& class_name, const std::string& access_modifier = "public") {
+            return begin_block(std::format("class {}", codegen::detail::c_family::escape_name(class_name)), access_modifier);
+        }
+
+        LegacyGenerator& end_class() {
+            return end_block();
+        }
+
+        LegacyGenerator& comment(const std::string& text, const bool move_cursor_to_next_line = true) {
+            return push_line(std::format("// {}", text), move_cursor_to_next_line);
+        }
+
+        LegacyGenerator& prop(codegen::Prop prop, bool move_cursor_to_next_line = true) {
+            const auto line =
+                std::format("{} {}{};{}", prop.type_name, prop.name, prop.bitfield_size.has_value() ? std::format(": {}", prop.bitfield_size.value()) : "",
+                            move_cursor_to_next_line ? "" : " ");
+            return push_line(line, move_cursor_to_next_line);
+        }
+
+        LegacyGenerator& static_assert_offset(std::string_view class_name, std::string_view prop_name, int expected_offset,
+                                              const bool move_cursor_to_next_line) {
+            return push_line(std::format("static_assert(offsetof({}, {}) == {:#x});", class_name, prop_name, expected_offset), move_cursor_to_next_line);
+        }
+
+        [[nodiscard]] std::string str() const {
+            return _stream.str();
+        }
+
+    private:
+        LegacyGenerator& begin_block(const std::string& text, const std::string& access_modifier = "") {
+            push_line(text);
+            push_line("{");
+
+            if (!access_modifier.empty())
+                push_line(std::format("{}:", access_modifier));
+
+            ++_tabs_count;
+            return *this;
+        }
+
+        LegacyGenerator& end_block() {
+            if (_tabs_count)
+                --_tabs_count;
+
+            return push_line("};");
+        }
+
+        LegacyGenerator& push_line(const std::string& line, bool move_cursor_to_next_line = true) {
+            _stream << std::string(_tabs_count * codegen::kIndentWidth, codegen::kSpaceSym) // insert spaces
+                    << line;
+
+            if (move_cursor_to_next_line) {
+                _stream << std::endl;
+            }
+            return *this;
+        }
+
+        std::stringstream _stream{};
+        std::size_t _tabs_count{};
+    };
+
+    template <typename Generator>
+    void AssembleFile(Generator& generator, const std::vector<SyntheticField>& fields) {
+        generator.begin_namespace("source2sdk");
+        generator.begin_namespace("client");
+        generator.begin_class("CSyntheticClass");
+
+        for (const auto& field : fields) {
+            generator.comment(std::format("offset: {:#x}", field.offset));
+            generator.prop(codegen::Prop{.type_name = field.type_name, .name = field.name});
+        }
+
+        generator.end_class();
+
+        for (const auto& field : fields) {
+            generator.static_assert_offset("source2sdk::client::CSyntheticClass", field.name, field.offset, true);
+        }
+
+        generator.end_namespace();
+        generator.end_namespace();
+    }
+
+    void EmitLegacy(benchmark::State& state) {
+        const auto fields = MakeFields();
+        std::size_t bytes = 0;
+
+        for (auto _ : state) {
+            for (std::size_t i = 0; i < kFileCount; ++i) {
+                auto generator = std::make_unique<LegacyGenerator>();
+                AssembleFile(*generator, fields);
+
+                const auto contents = generator->str();
+                bytes += contents.size();
+                benchmark::DoNotOptimize(contents.data());
+            }
+        }
+
+        state.SetBytesProcessed(static_cast<std::int64_t>(bytes));
+        state.SetItemsProcessed(static_cast<std::int64_t>(state.iterations() * kFileCount));
+    }
+
+    /// Like sdk.cpp, one generator is reused for every file and the contents are moved out of it
+    void EmitPooled(benchmark::State& state) {
+        const auto fields = MakeFields();
+        std::size_t bytes = 0;
+        codegen::generator_cpp_t generator{};
+
+        for (auto _ : state) {
+            for (std::size_t i = 0; i < kFileCount; ++i) {
+                generator.reset();
+                AssembleFile(generator, fields);
+
+                const auto contents = generator.take();
+                bytes += contents.size();
+                benchmark::DoNotOptimize(contents.data());
+            }
+        }
+
+        state.SetBytesProcessed(static_cast<std::int64_t>(bytes));
+        state.SetItemsProcessed(static_cast<std::int64_t>(state.iterations() * kFileCount));
+    }
+} // namespace
+
+BENCHMARK(EmitLegacy)->Name("Codegen/EmitFile/StringStreamEndl");
+BENCHMARK(EmitPooled)->Name("Codegen/EmitFile/PooledOutputBuffer");
@@ -0,0 +1,81 @@
+#include "tools/codegen/c.h"
+#include "tools/codegen/cpp.h"
+#include <benchmark/benchmark.h>
+#include <format>
+#include <string>
+#include <vector>
+
+namespace {
+    constexpr std::size_t kClassCount = 200;
+    constexpr std::size_t kFieldCount = 60;
+
+    struct SyntheticField {
+        std::string type_name{};
+        std::string name{};
+        std::ptrdiff_t offset{};
+        std::size_t padding{};
+    };
+
+    [[nodiscard]] std::vector<SyntheticField> MakeFields() {
+        std::vector<SyntheticField> result(kFieldCount);
+
+        for (std::size_t i = 0; i < result.size(); ++i) {
+            result[i] = SyntheticField{.type_name = "int32_t", .name = std::format("m_n{}", i), .offset = static_cast<std::ptrdiff_t>(i * 8), .padding = i % 2};
+        }
+
+        return result;
+    }
+
+    /// The calls sdk.cpp makes per field: metadata comments, a pad, the prop and its offset comment
+    template <typename Generator>
+    void AssembleClass(Generator& generator, const std::vector<SyntheticField>& fields) {
+        generator.begin_namespace("source2sdk");
+        generator.begin_namespace("client");
+        generator.pack_push(1);
+        generator.begin_class("CSyntheticClass");
+
+        for (const auto& field : fields) {
+            generator.comment("metadata: MNetworkEnable");
+
+            if (field.padding != 0) {
+                generator.struct_padding(codegen::Padding{.pad_offset = field.offset - 4, .size = codegen::Padding::Bytes{field.padding}}, false)
+                    .reset_tabs_count()
+                    .comment("0x0")
+                    .restore_tabs_count();
+            }
+
+            generator.prop(codegen::Prop{.type_name = field.type_name, .name = field.name}, false);
+            generator.reset_tabs_count().comment("0x0", false).restore_tabs_count();
+        }
+
+        generator.end_class();
+        generator.pack_pop();
+        generator.end_namespace();
+        generator.end_namespace();
+    }
+
+    /// @param Generator @ref codegen::IGenerator for virtual dispatch
+    template <typename Generator, typename Concrete>
+    void Assemble(benchmark::State& state) {
+        const auto fields = MakeFields();
+        Concrete concrete{};
+        // Hides the dynamic type from the optimizer, sdk.cpp didn't know it either
+        Generator* generator = &concrete;
+        benchmark::DoNotOptimize(generator);
+
+        for (auto _ : state) {
+            for (std::size_t i = 0; i < kClassCount; ++i) {
+                generator->reset();
+                AssembleClass(*generator, fields);
+                benchmark::DoNotOptimize(generator->take());
+            }
+        }
+
+        state.SetItemsProcessed(static_cast<std::int64_t>(state.iterations() * kClassCount));
+    }
+} // namespace
+
+BENCHMARK(Assemble<codegen::IGenerator, codegen::generator_cpp_t>)->Name("Codegen/AssembleClass/Cpp/Virtual");
+BENCHMARK(Assemble<codegen::generator_cpp_t, codegen::generator_cpp_t>)->Name("Codegen/AssembleClass/Cpp/Static");
+BENCHMARK(Assemble<codegen::IGenerator, codegen::generator_c_t>)->Name("Codegen/AssembleClass/C/Virtual");
+BENCHMARK(Assemble<codegen::generator_c_t, codegen::generator_c_t>)->Name("Codegen/AssembleClass/C/Static");
@@ -0,0 +1,124 @@
+#include "sdk/field_table.h"
+#include <algorithm>
+#include <benchmark/benchmark.h>
+#include <format>
+#include <random>
+#include <string>
+#include <tuple>
+#include <unordered_map>
+#include <vector>
+
+namespace {
+    /// About as many fields as CS2 has
+    constexpr std::size_t kClassCount = 2'000;
+    constexpr std::size_t kFieldsPerClass = 20;
+
+    /// Names are as long as the game's, e.g. "CNmBoneMaskBlendNode__CDefinition" and "m_flSimulationTime"
+    [[nodiscard]] sdk::snapshot::Snapshot MakeSnapshot() {
+        using namespace sdk::snapshot;
+
+        Snapshot result{.types = {Type{.name = "float32", .category = ETypeCategory::Schema_Builtin, .size = 4, .alignment = 4}}};
+
+        for (std::size_t i = 0; i < kClassCount; ++i) {
+            const auto module = (i % 2 == 0) ? "client" : "animationsystem";
+            Class class_{.name = std::format("CSyntheticGameClass_{}__CDefinition", i), .module = module};
+
+            for (std::size_t field = 0; field < kFieldsPerClass; ++field) {
+                class_.fields.emplace_back(
+                    Field{.name = std::format("m_flSyntheticField{}", field), .type = 0, .offset = static_cast<std::int32_t>(field * 4)});
+            }
+
+            result.modules[module].classes.emplace_back(static_cast<Index>(result.classes.size()));
+            result.classes.emplace_back(std::move(class_));
+        }
+
+        return result;
+    }
+
+    using Query = std::tuple<std::string_view, std::string_view, std::string_view>;
+
+    /// Every field once, in random order
+    [[nodiscard]] std::vector<Query> MakeQueries(const sdk::snapshot::Snapshot& schema) {
+        std::vector<Query> result{};
+
+        for (const auto& class_ : schema.classes) {
+            for (const auto& field : class_.fields) {
+                result.emplace_back(class_.module, class_.name, field.name);
+            }
+        }
+
+        std::ranges::shuffle(result, std::mt19937{42});
+
+        return result;
+    }
+
+    /// Keyed by "<module>::<class>::<field>". The key buffer is reused, so lookups don't allocate either.
+    class StringMap {
+    public:
+        explicit StringMap(const sdk::snapshot::Snapshot& schema) {
+            for (const auto& class_ : schema.classes) {
+                for (const auto& field : class_.fields) {
+                    _fields.emplace(MakeKey(class_.module, class_.name, field.name),
+                                    sdk::FieldInfo{.offset = static_cast<std::uint32_t>(field.offset), .size = 4});
+                }
+            }
+        }
+
+        [[nodiscard]] const sdk::FieldInfo* Find(std::string_view module, std::string_view class_name, std::string_view field_name) {
+            const auto it = _fields.find(MakeKey(module, class_name, field_name));
+            return (it != _fields.end()) ? &it->second : nullptr;
+        }
+
+    private:
+        [[nodiscard]] const std::string& MakeKey(std::string_view module, std::string_view class_name, std::string_view field_name) {
+            _key.clear();
+            _key.append(module).append("::").append(class_name).append("::").append(field_name);
+            return _key;
+        }
+
+        std::unordered_map<std::string, sdk::FieldInfo> _fields{};
+        std::string _key{};
+    };
+
+    void FindUnorderedMap(benchmark::State& state) {
+        const auto schema = MakeSnapshot();
+        const auto queries = MakeQueries(schema);
+        StringMap map{schema};
+
+        for (auto _ : state) {
+            for (const auto& [module, class_name, field_name] : queries) {
+                benchmark::DoNotOptimize(map.Find(module, class_name, field_name));
+            }
+        }
+
+        state.SetItemsProcessed(static_cast<std::int64_t>(state.iterations() * queries.size()));
+    }
+
+    void FindPerfectHash(benchmark::State& state) {
+        const auto schema = MakeSnapshot();
+        const auto queries = MakeQueries(schema);
+        const auto table = sdk::BuildFieldTable(schema);
+
+        for (auto _ : state) {
+            for (const auto& [module, class_name, field_name] : queries) {
+                benchmark::DoNotOptimize(table.Find(module, class_name, field_name));
+            }
+        }
+
+        state.SetItemsProcessed(static_cast<std::int64_t>(state.iterations() * queries.size()));
+    }
+
+    void Build(benchmark::State& state) {
+        const auto schema = MakeSnapshot();
+
+        for (auto _ : state) {
+            benchmark::DoNotOptimize(sdk::BuildFieldTable(schema));
+        }
+
+        state.SetItemsProcessed(static_cast<std::int64_t>(state.iterations() * kClassCount * kFieldsPerClass));
+    }
+} // namespace
+
+BENCHMARK(FindUnorderedMap)->Name("FieldTable/Find/UnorderedMap");
+BENCHMARK(FindPerfectHash)->Name("FieldTable/Find/PerfectHash");
+BENCHMARK(Build)->Name("FieldTable/Build")->Unit(benchmark::kMillisecond);
@@ -0,0 +1,93 @@
+#include "sdk/sdk.h"
+#include <benchmark/benchmark.h>
+#include <format>
+#include <map>
+
+namespace {
+    constexpr std::size_t kClassCount = 30'000;
+
+    /// Class names are as long as the game's, e.g. "CNmBoneMaskBlendNode__CDefinition"
+    [[nodiscard]] std::vector<sdk::snapshot::Class> MakeClasses() {
+        std::vector<sdk::snapshot::Class> result(kClassCount);
+
+        for (std::size_t i = 0; i < result.size(); ++i) {
+            result[i].name = std::format("CSyntheticGameClass_{}__CDefinition", i);
+            result[i].module = (i % 2 == 0) ? "client" : "animationsystem";
+        }
+
+        return result;
+    }
+
+    /// The memo before it was keyed by address. Every lookup built a @ref sdk::TypeIdentifier and walked a tree of names.
+    class NameKeyedMemo {
+    public:
+        template <typename Fn>
+        [[nodiscard]] std::optional<int> GetOrCompute(const sdk::snapshot::Class& class_, Fn&& compute) {
+            const auto id = sdk::TypeIdentifier{.module = class_.module, .name = class_.name};
+            Entry* entry = nullptr;
+
+            {
+                std::scoped_lock lock{_mutex};
+                auto& slot = _entries[id];
+                if (slot == nullptr) {
+                    slot = std::make_unique<Entry>();
+                }
+                entry = slot.get();
+            }
+
+            std::call_once(entry->once, [&]() { entry->value = std::forward<Fn>(compute)(); });
+
+            return entry->value;
+        }
+
+    private:
+        struct Entry {
+            std::once_flag once{};
+            std::optional<int> value{};
+        };
+
+        std::mutex _mutex{};
+        std::map<sdk::TypeIdentifier, std::unique_ptr<Entry>> _entries{};
+    };
+
+    /// Generating a class looks up the alignment of the class and of every field, most lookups hit
+    template <typename Memo>
+    void LookUpWarm(benchmark::State& state) {
+        const auto classes = MakeClasses();
+        Memo memo{};
+
+        for (const auto& class_ : classes) {
+            (void)memo.GetOrCompute(class_, []() { return std::make_optional(8); });
+        }
+
+        for (auto _ : state) {
+            for (const auto& class_ : classes) {
+                benchmark::DoNotOptimize(memo.GetOrCompute(class_, []() { return std::make_optional(8); }));
+            }
+        }
+
+        state.SetItemsProcessed(static_cast<std::int64_t>(state.iterations() * classes.size()));
+    }
+
+    template <typename Memo>
+    void FillCold(benchmark::State& state) {
+        const auto classes = MakeClasses();
+
+        for (auto _ : state) {
+            Memo memo{};
+
+            for (const auto& class_ : classes) {
+                benchmark::DoNotOptimize(memo.GetOrCompute(class_, []() { return std::make_optional(8); }));
+            }
+        }
+
+        state.SetItemsProcessed(static_cast<std::int64_t>(state.iterations() * classes.size()));
+    }
+
+    using AddressKeyedMemo = sdk::ConcurrentTypeMemo<sdk::snapshot::Class, std::optional<int>>;
+} // namespace
+
+BENCHMARK(LookUpWarm<NameKeyedMemo>)->Name("GeneratorCache/LookUpWarm/NameKeyedMap");
+BENCHMARK(LookUpWarm<AddressKeyedMemo>)->Name("GeneratorCache/LookUpWarm/AddressKeyedFlatHashMap");
+BENCHMARK(FillCold<NameKeyedMemo>)->Name("GeneratorCache/FillCold/NameKeyedMap");
+BENCHMARK(FillCold<AddressKeyedMemo>)->Name("GeneratorCache/FillCold/AddressKeyedFlatHashMap");
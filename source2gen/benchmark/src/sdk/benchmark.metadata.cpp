@@ -0,0 +1,171 @@
+#include "sdk/metadata.h"
+#include "tools/fnv.h"
+#include <algorithm>
+#include <array>
+#include <benchmark/benchmark.h>
+#include <string>
+#include <vector>
+
+namespace {
+    constexpr std::size_t kEntryCount = 200'000;
+
+    /// Like the game's field metadata, most entries don't have a value
+    constexpr std::array kNames = {
+        "MNetworkEnable",
+        "MNetworkEnable",
+        "MNetworkDisable",
+        "MNetworkChangeCallback",
+        "MNetworkVarNames",
+        "MNetworkEnable",
+        "MPropertyFriendlyName",
+        "MNetworkBitCount",
+        "MNetworkMinValue",
+        "MNetworkMaxValue",
+        "MNetworkEnable",
+        "MNetworkEncoder",
+        "MPropertyDescription",
+        "MNetworkPriority",
+        "MNetworkSerializer",
+        "MNetworkEnable",
+        "MResourceTypeForInfoType",
+        "MVDataOutlinerIcon",
+        "MParticleOperatorType",
+        "MPropertyStartGroup",
+    };
+
+    [[nodiscard]] std::vector<std::string> MakeNames() {
+        std::vector<std::string> result(kEntryCount);
+
+        for (std::size_t i = 0; i < result.size(); ++i) {
+            result[i] = kNames[(i * 7) % kNames.size()];
+        }
+
+        return result;
+    }
+
+    /// The tables before they were merged into a perfect hash table. Every table was searched linearly, entries without a value searched all
+    /// of them.
+    namespace linear {
+        constexpr std::array string_metadata_entries = {
+            FNV32("MCellForDomain"),
+            FNV32("MCustomFGDMetadata"),
+            FNV32("MFieldVerificationName"),
+            FNV32("MKV3TransferName"),
+            FNV32("MNetworkAlias"),
+            FNV32("MNetworkChangeCallback"),
+            FNV32("MNetworkEncoder"),
+            FNV32("MNetworkExcludeByName"),
+            FNV32("MNetworkExcludeByUserGroup"),
+            FNV32("MNetworkIncludeByName"),
+            FNV32("MNetworkIncludeByUserGroup"),
+            FNV32("MNetworkReplayCompatField"),
+            FNV32("MNetworkSerializer"),
+            FNV32("MNetworkTypeAlias"),
+            FNV32("MNetworkUserGroup"),
+            FNV32("MNetworkUserGroupProxy"),
+            FNV32("MParticleReplacementOp"),
+            FNV32("MPropertyArrayElementNameKey"),
+            FNV32("MPropertyAttributeChoiceName"),
+            FNV32("MPropertyAttributeEditor"),
+            FNV32("MPropertyAttributeRange"),
+            FNV32("MPropertyAttributeSuggestionName"),
+            FNV32("MPropertyCustomEditor"),
+            FNV32("MPropertyCustomFGDType"),
+            FNV32("MPropertyDescription"),
+            FNV32("MPropertyDescription"),
+            FNV32("MPropertyExtendedEditor"),
+            FNV32("MPropertyFriendlyName"),
+            FNV32("MPropertyFriendlyName"),
+            FNV32("MPropertyGroupName"),
+            FNV32("MPropertyIconName"),
+            FNV32("MPropertyStartGroup"),
+            FNV32("MPropertySuppressExpr"),
+            FNV32("MPulseCellOutflowHookInfo"),
+            FNV32("MPulseEditorHeaderIcon"),
+            FNV32("MPulseProvideFeatureTag"),
+            FNV32("MResourceBlockType"),
+            FNV32("MScriptDescription"),
+            FNV32("MSrc1ImportAttributeName"),
+            FNV32("MSrc1ImportDmElementType"),
+            FNV32("MVDataOutlinerIcon"),
+            FNV32("MVDataOutlinerIconExpr"),
+            FNV32("MVDataUniqueMonotonicInt"),
+            FNV32("MVectorIsSometimesCoordinate"),
+        };
+
+        constexpr std::array string_class_metadata_entries = {
+            FNV32("MResourceTypeForInfoType"),
+            FNV32("MDiskDataForResourceType"),
+        };
+
+        constexpr std::array var_name_string_class_metadata_entries = {
+            FNV32("MNetworkVarNames"), FNV32("MNetworkOverride"), FNV32("MNetworkVarTypeOverride"), FNV32("MScriptDescription"), FNV32("MParticleDomainTag"),
+        };
+
+        constexpr std::array integer_metadata_entries = {
+            FNV32("MNetworkVarEmbeddedFieldOffsetDelta"),
+            FNV32("MNetworkBitCount"),
+            FNV32("MNetworkPriority"),
+            FNV32("MParticleOperatorType"),
+            FNV32("MPropertySortPriority"),
+            FNV32("MParticleMinVersion"),
+            FNV32("MParticleMaxVersion"),
+            FNV32("MNetworkEncodeFlags"),
+            FNV32("MResourceVersion"),
+            FNV32("MVDataNodeType"),
+            FNV32("MVDataOverlayType"),
+            FNV32("MAlignment"),
+            FNV32("MGenerateArrayKeynamesFirstIndex"),
+        };
+
+        constexpr std::array float_metadata_entries = {
+            FNV32("MNetworkMinValue"),
+            FNV32("MNetworkMaxValue"),
+        };
+
+        [[nodiscard]] sdk::MetadataValueKind GetMetadataValueKind(const char* name) {
+            const auto value_hash_name = fnv32::hash_runtime(name);
+
+            if (std::ranges::find(var_name_string_class_metadata_entries, value_hash_name) != var_name_string_class_metadata_entries.end()) {
+                return sdk::MetadataValueKind::var_name;
+            } else if (std::ranges::find(string_class_metadata_entries, value_hash_name) != string_class_metadata_entries.end()) {
+                return sdk::MetadataValueKind::inline_string;
+            } else if (std::ranges::find(string_metadata_entries, value_hash_name) != string_metadata_entries.end()) {
+                return sdk::MetadataValueKind::string;
+            } else if (std::ranges::find(integer_metadata_entries, value_hash_name) != integer_metadata_entries.end()) {
+                return sdk::MetadataValueKind::integer;
+            } else if (std::ranges::find(float_metadata_entries, value_hash_name) != float_metadata_entries.end()) {
+                return sdk::MetadataValueKind::floating_point;
+            }
+
+            return sdk::MetadataValueKind::unknown;
+        }
+    } // namespace linear
+
+    void ClassifyLinear(benchmark::State& state) {
+        const auto names = MakeNames();
+
+        for (auto _ : state) {
+            for (const auto& name : names) {
+                benchmark::DoNotOptimize(linear::GetMetadataValueKind(name.c_str()));
+            }
+        }
+
+        state.SetItemsProcessed(static_cast<std::int64_t>(state.iterations() * names.size()));
+    }
+
+    void ClassifyPerfectHash(benchmark::State& state) {
+        const auto names = MakeNames();
+
+        for (auto _ : state) {
+            for (const auto& name : names) {
+                benchmark::DoNotOptimize(sdk::GetMetadataValueKind(name));
+            }
+        }
+
+        state.SetItemsProcessed(static_cast<std::int64_t>(state.iterations() * names.size()));
+    }
+} // namespace
+
+BENCHMARK(ClassifyLinear)->Name("Metadata/Classify/LinearScan");
+BENCHMARK(ClassifyPerfectHash)->Name("Metadata/Classify/PerfectHash");
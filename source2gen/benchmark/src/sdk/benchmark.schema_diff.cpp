@@ -0,0 +1,113 @@
+#include "sdk/schema_binary.h"
+#include "sdk/schema_diff.h"
+#include "sdk/sdk.h"
+#include <benchmark/benchmark.h>
+#include <filesystem>
+#include <format>
+#include <fstream>
+
+namespace {
+    /// 100k fields
+    constexpr std::size_t kClassCount = 10'000;
+    constexpr std::size_t kFieldsPerClass = 10;
+
+    [[nodiscard]] sdk::snapshot::Snapshot MakeSnapshot() {
+        using namespace sdk::snapshot;
+
+        Snapshot result{.types = {Type{.name = "float32", .category = ETypeCategory::Schema_Builtin, .size = 4, .alignment = 4},
+                                  Type{.name = "CHandle< C_BaseEntity >", .category = ETypeCategory::Schema_Atomic, .size = 4, .alignment = 4}}};
+
+        for (std::size_t i = 0; i < kClassCount; ++i) {
+            const auto module = (i % 2 == 0) ? "client" : "server";
+            Class class_{.name = std::format("CSyntheticGameClass_{}", i),
+                         .module = module,
+                         .size = static_cast<std::int32_t>(kFieldsPerClass * 4),
+                         .static_metadata = {Metadata{.name = "MNetworkVarNames", .value = "float32 m_flSyntheticField0"}}};
+
+            for (std::size_t field = 0; field < kFieldsPerClass; ++field) {
+                class_.fields.emplace_back(Field{.name = std::format("m_flSyntheticField{}", field),
+                                                 .type = static_cast<Index>(field % 2),
+                                                 .offset = static_cast<std::int32_t>(field * 4),
+                                                 .metadata = {Metadata{.name = "MNetworkEnable"}}});
+            }
+
+            result.modules[module].classes.emplace_back(static_cast<Index>(result.classes.size()));
+            result.classes.emplace_back(std::move(class_));
+        }
+
+        return result;
+    }
+
+    /// A game update that adds a field to @p percent of the classes
+    [[nodiscard]] sdk::snapshot::Snapshot MakeUpdatedSnapshot(std::int64_t percent) {
+        auto result = MakeSnapshot();
+
+        for (std::size_t i = 0; i < result.classes.size(); ++i) {
+            if (static_cast<std::int64_t>(i % 100) >= percent) {
+                continue;
+            }
+
+            auto& class_ = result.classes[i];
+            class_.fields.insert(class_.fields.begin(), sdk::snapshot::Field{.name = "m_nNewField", .type = 0, .offset = 0});
+            for (std::size_t field = 1; field < class_.fields.size(); ++field) {
+                class_.fields[field].offset += 4;
+            }
+            class_.size += 4;
+        }
+
+        return result;
+    }
+
+    bool SaveSchemaBinary(const sdk::snapshot::Snapshot& schema, const std::filesystem::path& path) {
+        std::ofstream file{path, std::ios::binary};
+        file << sdk::SerializeSchemaBinary(schema);
+        return file.good();
+    }
+
+    /// Unchanged classes are skipped by their hash, the time grows with the number of changed classes
+    void Compare(benchmark::State& state) {
+        const auto old_schema = MakeSnapshot();
+        const auto new_schema = MakeUpdatedSnapshot(state.range(0));
+
+        for (auto _ : state) {
+            benchmark::DoNotOptimize(sdk::diff::Compare(old_schema, new_schema));
+        }
+
+        state.SetItemsProcessed(static_cast<std::int64_t>(state.iterations() * kClassCount));
+    }
+
+    /// What "source2gen diff" does with two files written by @p Save, minus the report
+    template <bool (*Save)(const sdk::snapshot::Snapshot&, const std::filesystem::path&)>
+    void LoadAndCompare(benchmark::State& state) {
+        const auto directory = std::filesystem::temp_directory_path() / "source2gen-benchmark-schema-diff";
+        std::filesystem::create_directories(directory);
+
+        if (!Save(MakeSnapshot(), directory / "old.bin") || !Save(MakeUpdatedSnapshot(state.range(0)), directory / "new.bin")) {
+            state.SkipWithError("Failed to write the schemas");
+            return;
+        }
+
+        for (auto _ : state) {
+            const auto old_schema = sdk::diff::LoadSchema(directory / "old.bin");
+            const auto new_schema = sdk::diff::LoadSchema(directory / "new.bin");
+            benchmark::DoNotOptimize(sdk::diff::Compare(old_schema.value(), new_schema.value()));
+        }
+
+        state.SetItemsProcessed(static_cast<std::int64_t>(state.iterations() * kClassCount));
+        std::filesystem::remove_all(directory);
+    }
+} // namespace
+
+BENCHMARK(Compare)->Name("SchemaDiff/Compare")->ArgName("changed_percent")->Arg(0)->Arg(1)->Arg(10)->Arg(100)->Unit(benchmark::kMillisecond);
+BENCHMARK(LoadAndCompare<sdk::snapshot::Save>)
+    ->Name("SchemaDiff/LoadAndCompare/Snapshot")
+    ->ArgName("changed_percent")
+    ->Arg(1)
+    ->Arg(100)
+    ->Unit(benchmark::kMillisecond);
+BENCHMARK(LoadAndCompare<SaveSchemaBinary>)
+    ->Name("SchemaDiff/LoadAndCompare/SchemaBinary")
+    ->ArgName("changed_percent")
+    ->Arg(1)
+    ->Arg(100)
+    ->Unit(benchmark::kMillisecond);
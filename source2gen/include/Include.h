@@ -9,6 +9,10 @@ namespace source2_gen {
     /// Logs errors. Calls @ref std::abort() on fatal errors.
     /// @return true on success
     bool Dump(Options options);
+
+    /// Compares the schemas of @p options, prints a summary, and writes the report if requested. Logs errors.
+    /// @return Exit code, 0 if the schemas are equal, 1 if they differ, 2 on errors
+    int Diff(const DiffOptions& options);
 } // namespace source2_gen
 
 constexpr std::string_view kPoweredByMessage = {"Powered by github.com/neverlosecc/source2gen"};
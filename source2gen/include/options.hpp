@@ -1,6 +1,13 @@
 #pragma once
 
+#include "tools/writer/writer.h"
+#include <cstddef>
+#include <filesystem>
 #include <optional>
+#include <set>
+#include <string>
+#include <string_view>
+#include <vector>
 
 namespace source2_gen {
     enum class Language {
@@ -12,12 +19,74 @@ namespace source2_gen {
         /// - no `#include` macros
         /// - no `static_assert`
         c_ida,
+        /// C++20 named modules, one module interface unit per module, "modules/source2sdk.<module>.cppm"
+        cpp_modules,
+        /// C++, but every class is a namespace of `constexpr` field offsets, size, and alignment. Headers don't include each other.
+        cpp_offsets,
+        /// No source code, but a single "schema.bin" of all classes, fields, and enums that can be memory-mapped and queried without parsing it.
+        /// See sdk-static/schema-bin.
+        schema_bin,
+        /// No source code, but a single "schema.json" of all classes, fields, and enums. See sdk-static/json.
+        json,
+    };
+
+    /// Number of enumerators of @ref Language
+    constexpr std::size_t kLanguageCount = 7;
+
+    /// @return Name of @p language as accepted by "--emit-language"
+    [[nodiscard]]
+    std::string_view get_language_name(Language language);
+
+    /// How the headers of the C++ SDK are merged, see "--amalgamate"
+    enum class Amalgamation {
+        /// One header per type
+        none,
+        /// One header per module, "amalgamated/source2sdk/<module>.hpp"
+        module,
+        /// One header for the whole SDK, "amalgamated/source2sdk.hpp"
+        sdk,
+    };
+
+    /// Arguments of "source2gen diff <old> <new>"
+    struct DiffOptions {
+        /// Snapshot or schema.bin, see @ref sdk::diff::LoadSchema()
+        std::filesystem::path old_schema{};
+        std::filesystem::path new_schema{};
+        /// File to write the changes to as JSON, see @ref sdk::diff::WriteReport()
+        std::optional<std::filesystem::path> report{};
     };
 
     struct Options {
-        Language emit_language{};
+        /// All languages are generated in a single pass. They share the schema and the @ref sdk::GeneratorCache.
+        std::vector<Language> emit_languages{Language::cpp};
+        /// Ignored by languages that don't support static members, see @ref sdk::GetEmitTargets()
         bool static_members{};
+        /// Ignored by languages that don't support static assertions, see @ref sdk::GetEmitTargets()
         bool static_assertions{};
+        /// Number of generator threads. 0 uses all hardware threads.
+        std::size_t jobs{};
+        /// File to read the previous run's generation timings from, and to write this run's timings to. The timings are used to schedule
+        /// expensive types first.
+        std::optional<std::filesystem::path> timing_history{};
+        util::WriteBackend write_backend{util::kDefaultWriteBackend};
+        /// File to save a snapshot of the schema system to, see @ref sdk::snapshot::Snapshot
+        std::optional<std::filesystem::path> save_snapshot{};
+        /// Generate from a snapshot file instead of loading the game's modules
+        std::optional<std::filesystem::path> from_snapshot{};
+        /// Only used by @ref Language::cpp
+        Amalgamation amalgamation{Amalgamation::none};
+        /// Don't write one header per type if @ref amalgamation is set
+        bool amalgamation_only{};
+        /// File to write the number of direct and transitive includes of every header to, see @ref sdk::GeneratorResult::include_report
+        std::optional<std::filesystem::path> include_report{};
+        /// Templates that don't odr-use their template arguments. Their arguments are forward-declared instead of included.
+        /// Loaded from "sdk-static/non-odr-templates.txt", which is generated from sdk-static.toml. Defaults to the templates that are needed to
+        /// break include cycles.
+        std::set<std::string, std::less<>> non_odr_templates{"CHandle"};
+        /// Write a perfect hash table of all fields to "source2sdk/field_table.hpp" of the C++ and C++ offsets SDK, see @ref sdk::BuildFieldTable()
+        bool field_table{};
+        /// Set by "source2gen diff". Two schemas are compared instead of generating an SDK, the game is not loaded.
+        std::optional<DiffOptions> diff{};
 
         /// @return @ref std::nullopt if "--help" was passed or parsing failed
         [[nodiscard]]
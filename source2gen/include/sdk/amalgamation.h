@@ -0,0 +1,47 @@
+// Copyright (C) 2024 neverlosecc
+// See end of file for extended copyright information.
+#pragma once
+
+#include "sdk/sdk.h"
+#include "tools/writer/async_writer.h"
+#include <span>
+#include <vector>
+
+namespace sdk {
+    /// @return @p files in an order in which every file comes after the files it includes. Files are otherwise ordered by path, so the order is
+    /// the same in every run. Include cycles are broken at the file that closes the cycle.
+    [[nodiscard]] std::vector<const GeneratedFile*> SortByIncludes(std::span<const GeneratedFile> files);
+
+    /// Merges the files of a C++ target into one header per module, "amalgamated/source2sdk/<module>.hpp", or into a single header,
+    /// "amalgamated/source2sdk.hpp", depending on @ref EmitTarget::amalgamation. Types are ordered by @ref SortByIncludes(), forward declarations
+    /// are hoisted to the top. Module headers include the headers of the modules they depend on.
+    /// Hands the headers to @p writer, they might not have been written when this function returns.
+    /// @param files @ref GeneratorResult::files of @p target
+    void AmalgamateSdk(const EmitTarget& target, std::span<const GeneratedFile> files, util::AsyncFileWriter& writer);
+
+    /// Merges the files of a @ref source2_gen::Language::cpp_modules target into one module interface unit per module,
+    /// "modules/source2sdk.<module>.cppm", which exports module "source2sdk.<module>". Types are ordered like in @ref AmalgamateSdk(). Units
+    /// re-export the modules they include or forward-declare types of, and sdk-static's module "source2sdk.source2gen".
+    /// Forward declarations are moved into the unit of the module that defines the type, because a type that is declared in two modules is two
+    /// different types. Modules can't import each other in a cycle, so modules that depend on each other share one unit, the one of the first
+    /// module by name. The other modules' units re-export it.
+    /// Does nothing for other languages. Hands the units to @p writer, they might not have been written when this function returns.
+    /// @param files @ref GeneratorResult::files of @p target
+    void AssembleModuleUnits(const EmitTarget& target, std::span<const GeneratedFile> files, util::AsyncFileWriter& writer);
+} // namespace sdk
+
+// source2gen - Source2 games SDK generator
+// Copyright 2024 neverlosecc
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
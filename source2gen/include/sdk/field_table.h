@@ -0,0 +1,86 @@
+// Copyright (C) 2024 neverlosecc
+// See end of file for extended copyright information.
+#pragma once
+
+#include "sdk/sdk.h"
+#include "sdk/snapshot.h"
+#include "tools/writer/async_writer.h"
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace sdk {
+    /// What @ref FieldTable::Find() returns for a field
+    struct FieldInfo {
+        /// Relative to the class that declares the field
+        std::uint32_t offset{};
+        /// 0 if the game doesn't know the size of the field's type
+        std::uint32_t size{};
+        /// Index into @ref FieldTable::type_names
+        std::uint32_t type_id{};
+
+        bool operator==(const FieldInfo&) const = default;
+    };
+
+    struct FieldTableSlot {
+        /// See @ref HashFieldKey()
+        std::uint64_t key_hash{};
+        /// Range of @ref FieldTable::keys that contains "<module>\0<class>\0<field>". @ref key_size is 0 for unused slots.
+        std::uint32_t key_offset{};
+        std::uint32_t key_size{};
+        FieldInfo field{};
+    };
+
+    /// Perfect hash table of the fields of all classes, keyed by (module, class, field). A key's hash selects a bucket, the bucket's
+    /// displacement selects the key's slot. Displacements are chosen so that no two keys share a slot, a lookup hashes the key once and
+    /// compares one slot. The generated "source2sdk/field_table.hpp" implements the same lookup, see @ref EmitFieldTable().
+    struct FieldTable {
+        /// Size is a power of 2
+        std::vector<std::uint32_t> displacements{};
+        /// Size is a power of 2
+        std::vector<FieldTableSlot> slots{};
+        /// Keys of all slots, back to back
+        std::string keys{};
+        /// Schema names of the fields' types, e.g. "CHandle< C_BaseEntity >". Sorted, each name is stored once.
+        std::vector<std::string> type_names{};
+
+        /// @return nullptr if @p class_name of @p module has no field named @p field_name. Fields of base classes are only found in their
+        /// own class.
+        [[nodiscard]] const FieldInfo* Find(std::string_view module, std::string_view class_name, std::string_view field_name) const;
+    };
+
+    /// Hashes @p module, @p class_name, and @p field_name 8 bytes at a time
+    [[nodiscard]] std::uint64_t HashFieldKey(std::string_view module, std::string_view class_name, std::string_view field_name);
+
+    /// @param slot_mask Size of @ref FieldTable::slots minus 1
+    /// @return Index of the slot of a key with hash @p key_hash in a bucket with @p displacement
+    [[nodiscard]] std::size_t GetFieldSlot(std::uint64_t key_hash, std::uint32_t displacement, std::uint64_t slot_mask);
+
+    /// Contains the fields of every class of every module of @p schema, the same fields @ref GenerateSdk() emits. If a module has more than
+    /// one class with the same name, the first one in @ref snapshot::ModuleTypes::classes is used.
+    [[nodiscard]] FieldTable BuildFieldTable(const snapshot::Snapshot& schema);
+
+    /// @return C++ header that contains @p table and `source2sdk::field_table::Find()`, which doesn't allocate and can be evaluated at
+    /// compile time
+    [[nodiscard]] std::string EmitFieldTable(const FieldTable& table);
+
+    /// Hands "include/source2sdk/field_table.hpp" to @p writer if @ref EmitTarget::field_table is set, does nothing otherwise
+    void WriteFieldTable(const EmitTarget& target, const FieldTable& table, util::AsyncFileWriter& writer);
+} // namespace sdk
+
+// source2gen - Source2 games SDK generator
+// Copyright 2024 neverlosecc
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
@@ -0,0 +1,61 @@
+// Copyright (C) 2024 neverlosecc
+// See end of file for extended copyright information.
+#pragma once
+
+#include "sdk/sdk.h"
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <span>
+#include <vector>
+
+namespace sdk {
+    /// Headers and the headers they include. Nodes are numbered by the caller.
+    /// Transitive closures are computed once per strongly connected component, so include cycles are allowed. Closures are bit sets, 10000 headers
+    /// take about 12 MB.
+    class IncludeGraph {
+    public:
+        /// @param includes Element i are the nodes node i includes directly
+        explicit IncludeGraph(std::vector<std::vector<std::size_t>> includes);
+
+        /// @return Nodes @p node includes directly
+        [[nodiscard]] std::span<const std::size_t> GetIncludes(std::size_t node) const;
+
+        /// @return Whether @p from includes @p to directly or indirectly
+        [[nodiscard]] bool Reaches(std::size_t from, std::size_t to) const;
+
+        /// @return Number of nodes @p node includes directly or indirectly. Counts @p node if it's part of an include cycle.
+        [[nodiscard]] std::size_t GetClosureSize(std::size_t node) const;
+
+        /// @return The direct includes of @p node without those that are already included by another of its includes, in their original order.
+        /// Includes that include each other are kept.
+        [[nodiscard]] std::vector<std::size_t> GetMinimalIncludes(std::size_t node) const;
+
+    private:
+        std::vector<std::vector<std::size_t>> _includes{};
+        /// Strongly connected component of every node
+        std::vector<std::size_t> _components{};
+        /// Nodes every component reaches, one bit per node
+        std::vector<std::vector<std::uint64_t>> _closures{};
+    };
+
+    /// Writes @p entries to @p path, one line per header, tab-separated. Logs errors.
+    /// @return true on success
+    bool SaveIncludeReport(const std::filesystem::path& path, std::span<const IncludeReportEntry> entries);
+} // namespace sdk
+
+// source2gen - Source2 games SDK generator
+// Copyright 2024 neverlosecc
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
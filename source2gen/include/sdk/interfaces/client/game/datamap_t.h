@@ -2,7 +2,9 @@
 // See end of file for extended copyright information.
 #pragma once
 
+#include <cstdint>
 #include <sdk/interfaces/common/CUtlVector.h>
+#include <string>
 
 class ISaveRestoreOps;
 class typedescription_t;
@@ -935,6 +935,12 @@ public:
         return m_szName.data();
     }
 
+    /// Types that are not declared in this scope are looked up in the global scope
+    /// @return nullptr for the global scope
+    [[nodiscard]] const CSchemaSystemTypeScope* GetGlobalTypeScope() const {
+        return (m_pGlobalTypeScope == this) ? nullptr : m_pGlobalTypeScope;
+    }
+
     [[nodiscard]] CUtlTSHash<CSchemaClassBinding*> GetClassBindings() const {
         return m_ClassBindings;
     }
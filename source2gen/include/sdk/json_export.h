@@ -0,0 +1,35 @@
+// Copyright (C) 2024 neverlosecc
+// See end of file for extended copyright information.
+#pragma once
+
+#include "sdk/sdk.h"
+#include "sdk/snapshot.h"
+#include <ostream>
+
+namespace sdk {
+    /// Streams the modules of @p schema to @p out as a single JSON document, see sdk-static/json/source2sdk.schema.json for its layout.
+    /// Types are written one at a time, memory usage doesn't depend on the size of the schema.
+    void ExportJson(const snapshot::Snapshot& schema, std::ostream& out);
+
+    /// Writes "schema.json" if @p target is a @ref source2_gen::Language::json target, does nothing otherwise. The file is written directly,
+    /// not through a @ref util::AsyncFileWriter, which would need the entire file in memory.
+    /// Logs errors
+    /// @return true on success
+    bool WriteJsonSchema(const EmitTarget& target, const snapshot::Snapshot& schema);
+} // namespace sdk
+
+// source2gen - Source2 games SDK generator
+// Copyright 2024 neverlosecc
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
@@ -0,0 +1,49 @@
+// Copyright (C) 2024 neverlosecc
+// See end of file for extended copyright information.
+#pragma once
+
+#include <sdk/interfaces/schemasystem/schema.h>
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+namespace sdk {
+    /// How the value of a metadata entry is stored in @ref CSchemaNetworkValue
+    enum class MetadataValueKind : std::uint8_t {
+        /// The entry has no value or source2gen doesn't know its type
+        unknown,
+        /// @ref CSchemaNetworkValue::m_VarValue
+        var_name,
+        /// @ref CSchemaNetworkValue::m_szValue
+        inline_string,
+        /// @ref CSchemaNetworkValue::m_pszValue
+        string,
+        /// @ref CSchemaNetworkValue::m_nValue
+        integer,
+        /// @ref CSchemaNetworkValue::m_fValue
+        floating_point,
+    };
+
+    /// Looks @p name up in a perfect hash table that is built at compile time for the current game
+    [[nodiscard]] MetadataValueKind GetMetadataValueKind(std::string_view name);
+
+    /// Decodes the value of a metadata entry. The type of the value depends on the entry's name.
+    /// @return An empty string if the entry has no value or its type is unknown
+    [[nodiscard]] std::string GetMetadataValue(const SchemaMetadataEntryData_t& metadata_entry);
+} // namespace sdk
+
+// source2gen - Source2 games SDK generator
+// Copyright 2024 neverlosecc
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
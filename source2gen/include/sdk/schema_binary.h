@@ -0,0 +1,33 @@
+// Copyright (C) 2024 neverlosecc
+// See end of file for extended copyright information.
+#pragma once
+
+#include "sdk/sdk.h"
+#include "sdk/snapshot.h"
+#include "tools/writer/async_writer.h"
+#include <string>
+
+namespace sdk {
+    /// Serializes the modules of @p schema into the format of sdk-static's "source2sdk/schema_view.hpp", which can be memory-mapped and queried
+    /// without parsing it. Classes and enums are sorted by module and name, so the same schema always results in the same bytes.
+    [[nodiscard]] std::string SerializeSchemaBinary(const snapshot::Snapshot& schema);
+
+    /// Hands "schema.bin" to @p writer if @p target is a @ref source2_gen::Language::schema_bin target, does nothing otherwise
+    void WriteSchemaBinary(const EmitTarget& target, const snapshot::Snapshot& schema, util::AsyncFileWriter& writer);
+} // namespace sdk
+
+// source2gen - Source2 games SDK generator
+// Copyright 2024 neverlosecc
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
@@ -0,0 +1,138 @@
+// Copyright (C) 2024 neverlosecc
+// See end of file for extended copyright information.
+#pragma once
+
+#include "sdk/snapshot.h"
+#include <cstdint>
+#include <expected>
+#include <filesystem>
+#include <optional>
+#include <ostream>
+#include <source2sdk/schema_view.hpp>
+#include <string>
+#include <vector>
+
+/// Compares two schemas, e.g. before and after a game update. Only what both snapshots and schema.bin contain is compared: sizes,
+/// alignments, flags, base classes, fields, enumerators, and metadata. Static fields and datamaps are ignored.
+namespace sdk::diff {
+    struct FieldState {
+        /// Schema name of the type, e.g. "CHandle< C_BaseEntity >"
+        std::string type{};
+        std::int32_t offset{};
+        /// @ref std::nullopt if the game doesn't know the size
+        std::optional<int> size{};
+
+        bool operator==(const FieldState&) const = default;
+    };
+
+    /// A field that has been added (@ref old_field is unset), removed (@ref new_field is unset), or changed
+    struct FieldChange {
+        std::string name{};
+        std::optional<FieldState> old_field{};
+        std::optional<FieldState> new_field{};
+        /// Only set if the field exists in both schemas
+        bool metadata_changed{};
+    };
+
+    struct ClassState {
+        std::int32_t size{};
+        std::optional<int> alignment{};
+        std::uint32_t flags{};
+        /// "<module>::<class>", empty if the class has no base class
+        std::string base_class{};
+
+        bool operator==(const ClassState&) const = default;
+    };
+
+    /// A class that has been added (@ref old_class is unset), removed (@ref new_class is unset), or changed
+    struct ClassChange {
+        std::string module{};
+        std::string name{};
+        std::optional<ClassState> old_class{};
+        std::optional<ClassState> new_class{};
+        /// Fields of changed classes. Removed and changed fields are in their old order, followed by added fields in their new order.
+        std::vector<FieldChange> fields{};
+        /// Of the class itself, see @ref FieldChange::metadata_changed for fields
+        bool metadata_changed{};
+    };
+
+    struct EnumeratorChange {
+        std::string name{};
+        std::optional<std::uint64_t> old_value{};
+        std::optional<std::uint64_t> new_value{};
+        bool metadata_changed{};
+    };
+
+    struct EnumState {
+        std::uint8_t size{};
+        std::uint8_t alignment{};
+
+        bool operator==(const EnumState&) const = default;
+    };
+
+    struct EnumChange {
+        std::string module{};
+        std::string name{};
+        std::optional<EnumState> old_enum{};
+        std::optional<EnumState> new_enum{};
+        std::vector<EnumeratorChange> enumerators{};
+        bool metadata_changed{};
+    };
+
+    struct SchemaDiff {
+        /// Sorted by module and name
+        std::vector<ClassChange> classes{};
+        /// Sorted by module and name
+        std::vector<EnumChange> enums{};
+        std::size_t unchanged_classes{};
+        std::size_t unchanged_enums{};
+        /// Modules whose binaries differ between the game builds both schemas have been captured from, or that have only been loaded for
+        /// one of them. Sorted by name, empty if both have been captured from the same build. @ref std::nullopt if a schema doesn't record
+        /// the hashes of the modules, e.g. schema.bin.
+        std::optional<std::vector<std::string>> changed_modules{};
+
+        /// Only considers types. Schemas of different game builds can be equal.
+        [[nodiscard]] bool empty() const {
+            return classes.empty() && enums.empty();
+        }
+    };
+
+    /// Hash of everything @ref Compare() compares, a class with the same hash in both schemas is skipped without looking at its fields.
+    /// Doesn't depend on the index of the class or its types, so it can be compared across schemas. Hashes are only stable within one process.
+    [[nodiscard]] std::uint64_t HashClass(const snapshot::Snapshot& schema, const snapshot::Class& class_);
+
+    /// See @ref HashClass()
+    [[nodiscard]] std::uint64_t HashEnum(const snapshot::Enum& enum_);
+
+    /// Compares the types of the modules of both schemas, and the hashes of the game modules they have been captured from. Types are
+    /// identified by module and name.
+    [[nodiscard]] SchemaDiff Compare(const snapshot::Snapshot& old_schema, const snapshot::Snapshot& new_schema);
+
+    /// Converts a file written by @ref WriteSchemaBinary() into a snapshot that only contains what @ref Compare() needs
+    [[nodiscard]] snapshot::Snapshot FromSchemaBinary(const source2sdk::schema::View& view);
+
+    /// Loads a snapshot saved by "--save-snapshot", or a schema.bin written by "--emit-language schema-bin"
+    [[nodiscard]] std::expected<snapshot::Snapshot, std::string> LoadSchema(const std::filesystem::path& path);
+
+    /// Writes @p diff as JSON
+    void WriteReport(const SchemaDiff& diff, std::ostream& out);
+
+    /// Writes a summary for humans, one line per changed type and field
+    void PrintSummary(const SchemaDiff& diff, std::ostream& out);
+} // namespace sdk::diff
+
+// source2gen - Source2 games SDK generator
+// Copyright 2024 neverlosecc
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
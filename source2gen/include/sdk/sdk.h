@@ -5,13 +5,22 @@
 #include <sdk/interfaces/schemasystem/schema.h>
 
 #include "options.hpp"
+#include "sdk/snapshot.h"
+#include "tools/writer/async_writer.h"
+#include <absl/container/flat_hash_map.h>
+#include <array>
 #include <filesystem>
-#include <map>
+#include <memory>
+#include <mutex>
 #include <sdk/interfaceregs.h>
 #include <sdk/interfaces/client/game/datamap_t.h>
 #include <sdk/interfaces/schemasystem/schema.h>
+#include <set>
+#include <span>
 #include <string>
+#include <unordered_map>
 #include <unordered_set>
+#include <vector>
 
 namespace sdk {
     inline CSchemaSystem* g_schema = nullptr;
@@ -24,24 +33,161 @@ namespace sdk {
         auto operator<=>(const TypeIdentifier&) const = default;
     };
 
+    /// Memoizes a value per type. Safe to share between threads.
+    /// Every value is computed exactly once, even if multiple threads ask for the same type at the same time.
+    /// Computations may recurse into other types, but must not recurse into the type they are computing.
+    /// @tparam Type Types are identified by their address, e.g. an element of @ref snapshot::Snapshot::classes. The memo must not outlive them.
+    template <typename Type, typename Value>
+    class ConcurrentTypeMemo {
+    public:
+        /// @param compute Called without holding any locks of this memo
+        /// @return Lifetime bound to this memo
+        template <typename Fn>
+        [[nodiscard]] const Value& GetOrCompute(const Type& type, Fn&& compute) {
+            Entry* entry = nullptr;
+
+            {
+                std::scoped_lock lock{_mutex};
+                auto& slot = _entries[&type];
+                if (slot == nullptr) {
+                    slot = std::make_unique<Entry>();
+                }
+                entry = slot.get();
+            }
+
+            std::call_once(entry->once, [&]() { entry->value = std::forward<Fn>(compute)(); });
+
+            return entry->value;
+        }
+
+    private:
+        struct Entry {
+            std::once_flag once{};
+            Value value{};
+        };
+
+        std::mutex _mutex{};
+        /// Entries are never removed, so pointers to them stay valid after the lock has been released.
+        /// Hashing a pointer is much cheaper than comparing names, and this is looked up for every field.
+        absl::flat_hash_map<const Type*, std::unique_ptr<Entry>> _entries{};
+    };
+
+    enum class NameSource {
+        include,
+        forward_declaration,
+    };
+
+    /// A type that has to be declared before a class that uses it can be defined
+    struct NameLookup {
+        std::string module{};
+
+        /// Decayed
+        std::string type_name{};
+
+        NameSource source{};
+
+        auto operator<=>(const NameLookup&) const = default;
+    };
+
+    /// A type as it is spelled in the generated SDK
+    struct ResolvedType {
+        /// Fully qualified. Without array extents for fixed arrays.
+        std::string name{};
+        /// Extents of fixed arrays, outermost first. Empty for other types.
+        std::vector<std::size_t> array_sizes{};
+    };
+
     /// Stores results of expensive function calls, like those that recurse through classes.
+    /// Shared between all generator threads. Only valid for the @ref snapshot::Snapshot it has been used with.
     struct GeneratorCache {
-        /// Key is {module,class}
         /// If an entry exists for a class, but its value is @ref std::nullopt, we have already tried finding its alignment but couldn't figure it out.
-        std::map<TypeIdentifier, std::optional<int>> class_alignment{};
-        /// Key is {module,class}
-        std::map<TypeIdentifier, bool> class_has_standard_layout{};
+        ConcurrentTypeMemo<snapshot::Class, std::optional<int>> class_alignment{};
+        ConcurrentTypeMemo<snapshot::Class, bool> class_has_standard_layout{};
+        /// Names a field of a type needs to be included or forward-declared. Doesn't depend on the language.
+        ConcurrentTypeMemo<snapshot::Type, std::set<NameLookup>> required_names{};
+        /// Index is the @ref source2_gen::Language, because type names are spelled differently in every language.
+        /// Common types, e.g. "CHandle< C_BaseEntity >", are used by thousands of fields, but only resolved once.
+        std::array<ConcurrentTypeMemo<snapshot::Type, ResolvedType>, source2_gen::kLanguageCount> resolved_types{};
+    };
+
+    /// An SDK in one language
+    struct EmitTarget {
+        source2_gen::Language language{};
+        /// Root of the SDK, e.g. "sdk"
+        std::filesystem::path directory{};
+        bool static_members{};
+        bool static_assertions{};
+        /// Keep a copy of every generated file in @ref GeneratorResult::files, e.g. to amalgamate them
+        bool keep_files{};
+        /// Write one file per type. Files are still kept if this is unset.
+        bool write_type_files{true};
+        /// Unset for languages that don't generate source code, their files are written after @ref GenerateSdk()
+        bool generates_types{true};
+        /// See @ref AmalgamateSdk(). @ref source2_gen::Amalgamation::none for languages other than C++.
+        source2_gen::Amalgamation amalgamation{};
+        /// Write "<module>/all.<extension>" for every module, which includes all headers of the module
+        bool umbrella_headers{};
+        /// Classes are namespaces of field offsets without includes, see @ref source2_gen::Language::cpp_offsets
+        bool offsets_only{};
+        /// Write "include/source2sdk/field_table.hpp", see @ref WriteFieldTable()
+        bool field_table{};
+    };
+
+    /// Every language of @p options is generated into "sdk/<language>" if there is more than one, otherwise into "sdk"
+    [[nodiscard]] std::vector<EmitTarget> GetEmitTargets(const source2_gen::Options& options);
+
+    /// The file of one generated type
+    struct GeneratedFile {
+        std::filesystem::path path{};
+        std::string module{};
+        /// Paths of the generated files this file includes. Contains paths of types that are referenced but have not been generated.
+        std::vector<std::filesystem::path> includes{};
+        /// Types this file declares without including them
+        std::vector<TypeIdentifier> forward_declarations{};
+        std::string contents{};
+        /// Offset of the type's definition in @ref contents. Everything before it are the preamble, includes, and forward declarations.
+        std::size_t definition_offset{};
+    };
+
+    /// Number of headers a header includes, see @ref GeneratorResult::include_report
+    struct IncludeReportEntry {
+        TypeIdentifier type{};
+        /// Headers that are included directly
+        std::size_t includes_before{};
+        std::size_t includes_after{};
+        /// Headers that are included directly or indirectly
+        std::size_t closure_before{};
+        std::size_t closure_after{};
     };
 
     // Wrapping the file list in a struct in case we need to return more properties in the future
     struct GeneratorResult {
-        /// All generated files
-        std::unordered_set<std::filesystem::path> generated_files{};
+        /// All generated files, one set per @ref EmitTarget in the order they were passed to @ref GenerateSdk()
+        std::vector<std::unordered_set<std::filesystem::path>> generated_files{};
+        /// One entry per @ref EmitTarget, empty unless @ref EmitTarget::keep_files is set. Files are in the same order in every run.
+        std::vector<std::vector<GeneratedFile>> files{};
+        /// Only filled if @ref source2_gen::Options::include_report is set. "Before" is without the configured
+        /// @ref source2_gen::Options::non_odr_templates and without removing redundant includes. Sorted by @ref IncludeReportEntry::closure_before,
+        /// largest first.
+        std::vector<IncludeReportEntry> include_report{};
     };
 
-    GeneratorResult GenerateTypeScopeSdk(const source2_gen::Options& options, GeneratorCache& cache, std::string_view module_name,
-                                         const std::unordered_set<const CSchemaEnumBinding*>& enums,
-                                         const std::unordered_set<const CSchemaClassBinding*>& classes);
+    /// All types declared in a module
+    struct ModuleDump {
+        std::unordered_set<const CSchemaEnumBinding*> enums{};
+        std::unordered_set<const CSchemaClassBinding*> classes{};
+    };
+
+    class TimingHistory;
+
+    /// Generates all types of all modules in @p schema on a single, global work queue. Types are ordered by their estimated cost, largest first,
+    /// so large modules don't form a long tail.
+    /// Every type is resolved once and then emitted for all @p targets.
+    /// Doesn't access the schema system, @p schema can be captured from the running game or loaded from a file.
+    /// @param writer Receives all generated files. Call @ref util::AsyncFileWriter::Finish() to wait for them to be written.
+    /// @param history Refines cost estimates if it contains timings of a previous run. Receives the timings of this run.
+    GeneratorResult GenerateSdk(const source2_gen::Options& options, std::span<const EmitTarget> targets, GeneratorCache& cache,
+                                util::AsyncFileWriter& writer, const snapshot::Snapshot& schema, TimingHistory& history);
 } // namespace sdk
 
 // source2gen - Source2 games SDK generator
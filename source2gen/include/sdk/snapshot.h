@@ -0,0 +1,221 @@
+// Copyright (C) 2024 neverlosecc
+// See end of file for extended copyright information.
+#pragma once
+
+#include <cstdint>
+#include <expected>
+#include <filesystem>
+#include <limits>
+#include <map>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+enum class ETypeCategory : std::uint8_t;
+enum class fieldtype_t : std::uint8_t;
+
+namespace sdk {
+    struct ModuleDump;
+} // namespace sdk
+
+/// A copy of everything the generator reads from the schema system. Snapshots can be saved to a compact binary file and don't reference any
+/// memory of the game modules, so the modules can be unloaded once a snapshot has been captured.
+/// Entries reference each other by index. Every type is stored once and resolved when it is captured.
+namespace sdk::snapshot {
+    /// Index into one of the tables of @ref Snapshot
+    using Index = std::uint32_t;
+    constexpr Index kNone = std::numeric_limits<Index>::max();
+
+    /// Identifies the game module a snapshot has been captured from
+    struct ModuleHash {
+        /// File name, e.g. "libclient.so"
+        std::string name{};
+        /// fnv64 of the module binary
+        std::uint64_t hash{};
+
+        bool operator==(const ModuleHash&) const = default;
+    };
+
+    struct Metadata {
+        std::string name{};
+        /// See @ref sdk::GetMetadataValue(). Empty if the entry has no value.
+        std::string value{};
+
+        bool operator==(const Metadata&) const = default;
+    };
+
+    struct Scope {
+        std::string name{};
+        /// Results of @ref CSchemaSystemTypeScope::FindDeclaredClass() and @ref CSchemaSystemTypeScope::FindDeclaredEnum() for every name the
+        /// generator looks up in this scope. Key is a decayed type name, value is the module that declares the type. Names that are not declared
+        /// in this scope are absent.
+        std::map<std::string, std::string, std::less<>> declared_types{};
+
+        bool operator==(const Scope&) const = default;
+    };
+
+    /// A @ref CSchemaType
+    struct Type {
+        std::string name{};
+        /// @ref kNone for built-in types
+        Index scope{kNone};
+        ETypeCategory category{};
+        /// @ref std::nullopt if the game doesn't know the size
+        std::optional<int> size{};
+        /// Only set if @ref size is set
+        std::optional<int> alignment{};
+        /// For declared classes. @ref kNone if the game has no class info for it.
+        Index declared_class{kNone};
+        /// For pointers, the innermost type that is being pointed to. See @ref CSchemaType::GetRefClass().
+        Index pointee{kNone};
+        /// For fixed arrays
+        Index element_type{kNone};
+        /// For fixed arrays
+        int element_count{};
+
+        bool operator==(const Type&) const = default;
+    };
+
+    struct Field {
+        std::string name{};
+        Index type{kNone};
+        std::int32_t offset{};
+        std::vector<Metadata> metadata{};
+
+        bool operator==(const Field&) const = default;
+    };
+
+    /// A @ref SchemaStaticFieldData_t. The instance lives in the game module, so only its name and type are captured.
+    struct StaticField {
+        std::string name{};
+        Index type{kNone};
+        std::vector<Metadata> metadata{};
+
+        bool operator==(const StaticField&) const = default;
+    };
+
+    /// An entry of a class' field metadata overrides. Only contains entries that have a name.
+    struct DatamapField {
+        std::string name{};
+        fieldtype_t type{};
+        std::uint16_t size{};
+        std::int32_t offset{};
+        /// Class name of embedded fields
+        std::string embedded_class{};
+
+        bool operator==(const DatamapField&) const = default;
+    };
+
+    struct Class {
+        std::string name{};
+        std::string module{};
+        Index scope{kNone};
+        /// The type that describes this class
+        Index self_type{kNone};
+        std::int32_t size{};
+        /// See @ref CSchemaClassInfo::GetRegisteredAlignment()
+        std::optional<int> registered_alignment{};
+        /// @ref SchemaClassFlags_t
+        std::uint32_t flags{};
+        /// source2gen doesn't support multiple inheritance, this is the first base class
+        Index base_class{kNone};
+        std::vector<Field> fields{};
+        /// In the order of the class' static field array, getters index it
+        std::vector<StaticField> static_fields{};
+        std::vector<Metadata> static_metadata{};
+        /// Empty if the class has no more than one override
+        std::vector<DatamapField> datamap{};
+
+        bool operator==(const Class&) const = default;
+    };
+
+    struct Enumerator {
+        std::string name{};
+        /// Truncated to the enum's alignment
+        std::uint64_t value{};
+        std::vector<Metadata> metadata{};
+
+        bool operator==(const Enumerator&) const = default;
+    };
+
+    struct Enum {
+        std::string name{};
+        std::string module{};
+        std::uint8_t size{};
+        std::uint8_t alignment{};
+        std::vector<Enumerator> enumerators{};
+        std::vector<Metadata> static_metadata{};
+
+        bool operator==(const Enum&) const = default;
+    };
+
+    /// Types declared in a module
+    struct ModuleTypes {
+        /// Indices into @ref Snapshot::enums
+        std::vector<Index> enums{};
+        /// Indices into @ref Snapshot::classes
+        std::vector<Index> classes{};
+
+        bool operator==(const ModuleTypes&) const = default;
+    };
+
+    struct Snapshot {
+        /// Value of SOURCE2GEN_GAME the snapshot has been captured with
+        std::string game{};
+        std::vector<ModuleHash> module_hashes{};
+        std::vector<Scope> scopes{};
+        std::vector<Type> types{};
+        /// Contains the classes of @ref modules and all classes they reference
+        std::vector<Class> classes{};
+        std::vector<Enum> enums{};
+        /// Key is the module name
+        std::map<std::string, ModuleTypes> modules{};
+
+        bool operator==(const Snapshot&) const = default;
+    };
+
+    /// @return The game this build of source2gen has been compiled for
+    [[nodiscard]] std::string_view GetCurrentGame();
+
+    /// @return @ref std::nullopt if the file cannot be read
+    [[nodiscard]] std::optional<std::uint64_t> HashModuleBinary(const std::filesystem::path& path);
+
+    struct CaptureStats {
+        /// Names looked up in type scopes
+        std::size_t lookups{};
+        /// Calls to @ref CSchemaSystemTypeScope::FindDeclaredClass() and @ref CSchemaSystemTypeScope::FindDeclaredEnum() that have been
+        /// answered by an index of the scopes' bindings instead
+        std::size_t avoided_virtual_calls{};
+    };
+
+    /// Copies all types of @p modules and everything they reference out of the schema system
+    /// @param modules Key is the module name
+    /// @param stats Receives counters of the capture if set
+    [[nodiscard]] Snapshot Capture(const std::unordered_map<std::string, ModuleDump>& modules, std::vector<ModuleHash> module_hashes,
+                                   CaptureStats* stats = nullptr);
+
+    /// Logs errors
+    /// @return true on success
+    bool Save(const Snapshot& snapshot, const std::filesystem::path& path);
+
+    /// @return An error message if the file cannot be read, has been written by an incompatible version of source2gen, or is corrupt
+    [[nodiscard]] std::expected<Snapshot, std::string> Load(const std::filesystem::path& path);
+} // namespace sdk::snapshot
+
+// source2gen - Source2 games SDK generator
+// Copyright 2024 neverlosecc
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
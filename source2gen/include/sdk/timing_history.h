@@ -0,0 +1,60 @@
+// Copyright (C) 2024 neverlosecc
+// See end of file for extended copyright information.
+#pragma once
+
+#include "sdk/sdk.h"
+#include <chrono>
+#include <filesystem>
+#include <map>
+#include <mutex>
+#include <optional>
+#include <utility>
+
+namespace sdk {
+    /// Time it took to generate each type, persisted between runs.
+    /// The generator uses the timings of the previous run to order its work queue.
+    class TimingHistory {
+    public:
+        TimingHistory() = default;
+
+        /// Not thread-safe, don't move a history that is being recorded into
+        TimingHistory(TimingHistory&& other) noexcept : _timings(std::move(other._timings)) { }
+
+        /// A missing file is not an error, it results in an empty history.
+        /// Malformed lines are skipped.
+        [[nodiscard]] static TimingHistory Load(const std::filesystem::path& path);
+
+        /// Logs errors
+        /// @return true on success
+        bool Save(const std::filesystem::path& path) const;
+
+        [[nodiscard]] std::optional<std::chrono::nanoseconds> Find(const TypeIdentifier& id) const;
+
+        /// Thread-safe
+        void Record(const TypeIdentifier& id, std::chrono::nanoseconds duration);
+
+        [[nodiscard]] bool IsEmpty() const {
+            return _timings.empty();
+        }
+
+    private:
+        mutable std::mutex _mutex{};
+        std::map<TypeIdentifier, std::chrono::nanoseconds> _timings{};
+    };
+} // namespace sdk
+
+// source2gen - Source2 games SDK generator
+// Copyright 2024 neverlosecc
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
@@ -2,16 +2,19 @@
 
 #include "codegen.h"
 #include "detail/c_family.h"
+#include "output_buffer.h"
 #include "tools/fnv.h"
 #include <absl/strings/str_join.h>
 #include <absl/strings/str_split.h>
 #include <cassert>
 #include <list>
 #include <set>
-#include <sstream>
+#include <type_traits>
 
 namespace codegen {
     struct generator_c_t final : public IGenerator {
+        using self_ref = std::add_lvalue_reference_t<generator_c_t>;
+
         std::string get_uint(std::size_t bits_count) const override {
             return detail::c_family::get_uint(bits_count);
         }
@@ -55,7 +58,7 @@ namespace codegen {
             return push_line(std::format("#include {}{}{}{}", open_bracket, module_or_file_name, maybe_file_extension, close_bracket));
         }
 
-        self_ref pack_push(const std::size_t alignment) override {
+        self_ref pack_push(const std::size_t alignment = 1) override {
             return push_line(std::format("#pragma pack(push, {})", alignment));
         }
 
@@ -154,7 +157,7 @@ namespace codegen {
         self_ref enum_item(const std::string& name, std::uint64_t value) override {
             assert(_current_class_or_enum.has_value() && "called enum_item() without calling begin_enum_class()");
 
-            return push_line(std::format("{}_{} = {:#x},", detail::c_family::escape_name(_current_class_or_enum.value()), name, value));
+            return push_line_format(true, "{}_{} = {:#x},", detail::c_family::escape_name(_current_class_or_enum.value()), name, value);
         }
 
         // @todo: @es3n1n: add func params
@@ -172,6 +175,10 @@ namespace codegen {
             return push_line(std::format("return {};", value), move_cursor_to_next_line);
         }
 
+        self_ref statement(std::string_view expression, const bool move_cursor_to_next_line = true) override {
+            return push_line_format(move_cursor_to_next_line, "{};", expression);
+        }
+
         self_ref static_field_getter([[maybe_unused]] const std::string& type_name, [[maybe_unused]] const std::string& prop_name,
                                      [[maybe_unused]] const std::string& mod_name, [[maybe_unused]] const std::string& decl_class,
                                      [[maybe_unused]] const std::size_t index) override {
@@ -179,7 +186,7 @@ namespace codegen {
             return *this;
         }
 
-        self_ref static_assert_size(std::string_view type_name, int expected_size, const bool move_cursor_to_next_line) override {
+        self_ref static_assert_size(std::string_view type_name, int expected_size, const bool move_cursor_to_next_line = true) override {
             assert(expected_size > 0);
 
             return push_line(std::format("static_assert(sizeof(struct {}) == {:#x});", detail::c_family::escape_name(type_name), expected_size),
@@ -187,7 +194,7 @@ namespace codegen {
         }
 
         self_ref static_assert_offset(std::string_view class_name, std::string_view prop_name, int expected_offset,
-                                      const bool move_cursor_to_next_line) override {
+                                      const bool move_cursor_to_next_line = true) override {
             assert(expected_offset >= 0);
 
             return push_line(std::format("static_assert(offsetof(struct {}, {}) == {:#x});", detail::c_family::escape_name(class_name),
@@ -195,8 +202,13 @@ namespace codegen {
                              move_cursor_to_next_line);
         }
 
-        self_ref comment(const std::string& text, const bool move_cursor_to_next_line = true) override {
-            return push_line(std::format("// {}", text), move_cursor_to_next_line);
+        self_ref constant(std::string_view type_name, std::string_view name, std::int64_t value, const bool move_cursor_to_next_line = true) override {
+            // C23
+            return push_line_format(move_cursor_to_next_line, "constexpr {} {} = {:#x};", type_name, detail::c_family::escape_name(name), value);
+        }
+
+        self_ref comment(std::string_view text, const bool move_cursor_to_next_line = true) override {
+            return push_line_format(move_cursor_to_next_line, "// {}", text);
         }
 
         self_ref begin_multi_line_comment(const bool move_cursor_to_next_line = true) override {
@@ -225,10 +237,10 @@ namespace codegen {
                 return "";
             }();
 
-            const auto line =
-                std::format("{}{} {}{};{}", type_category_prefix, detail::c_family::escape_name(prop.type_name), detail::c_family::escape_name(prop.name),
-                            prop.bitfield_size.has_value() ? std::format(": {}", prop.bitfield_size.value()) : "", move_cursor_to_next_line ? "" : " ");
-            return push_line(line, move_cursor_to_next_line);
+            return push_line_format(move_cursor_to_next_line, "{}{} {}{};{}", type_category_prefix, detail::c_family::escape_name(prop.type_name),
+                                    detail::c_family::escape_name(prop.name),
+                                    prop.bitfield_size.has_value() ? std::format(": {}", prop.bitfield_size.value()) : "",
+                                    move_cursor_to_next_line ? "" : " ");
         }
 
         self_ref forward_declaration(const std::string& text) override {
@@ -244,7 +256,7 @@ namespace codegen {
             return push_line(std::format("struct {};", encode_current_namespace(detail::c_family::escape_name(text))));
         }
 
-        self_ref struct_padding(Padding options, bool move_cursor_to_next_line) override {
+        self_ref struct_padding(Padding options, bool move_cursor_to_next_line = true) override {
             const auto is_bitfield = std::holds_alternative<Padding::Bits>(options.size);
 
             std::string type_name = is_bitfield ? detail::c_family::guess_bitfield_type(std::get<Padding::Bits>(options.size).value) : "uint8_t";
@@ -281,7 +293,26 @@ namespace codegen {
 
     public:
         [[nodiscard]] std::string str() const override {
-            return _stream.str();
+            return std::string{_buffer.view()};
+        }
+
+        [[nodiscard]] std::size_t size() const override {
+            return _buffer.view().size();
+        }
+
+        [[nodiscard]] std::string take() override {
+            return _buffer.take();
+        }
+
+        void reset() override {
+            _buffer.clear();
+            _tabs_count = 0;
+            _tabs_count_backup = 0;
+            _pads_count = 0;
+            _forward_decls.clear();
+            _current_class_or_enum = std::nullopt;
+            _current_struct_has_properties = false;
+            _namespaces.clear();
         }
 
     private:
@@ -317,12 +348,24 @@ namespace codegen {
             return *this;
         }
 
-        self_ref push_line(const std::string& line, bool move_cursor_to_next_line = true) {
-            _stream << std::string(_tabs_count * kIndentWidth, kSpaceSym) // insert spaces
-                    << line;
+        self_ref push_line(std::string_view line, bool move_cursor_to_next_line = true) {
+            _buffer.indent(_tabs_count);
+            _buffer.append(line);
+
+            if (move_cursor_to_next_line) {
+                _buffer.append('\n');
+            }
+            return *this;
+        }
+
+        /// Like @ref push_line(), but formats directly into the buffer
+        template <typename... Args>
+        self_ref push_line_format(bool move_cursor_to_next_line, std::format_string<Args...> format, Args&&... args) {
+            _buffer.indent(_tabs_count);
+            _buffer.append_format(format, std::forward<Args>(args)...);
 
             if (move_cursor_to_next_line) {
-                _stream << std::endl;
+                _buffer.append('\n');
             }
             return *this;
         }
@@ -355,7 +398,7 @@ namespace codegen {
         };
 
     private:
-        std::stringstream _stream = {};
+        OutputBuffer _buffer = {};
         std::size_t _tabs_count = 0, _tabs_count_backup = 0;
         std::size_t _pads_count = 0;
         std::optional<std::string> _current_class_or_enum{std::nullopt};
@@ -149,6 +149,13 @@ namespace codegen {
 
         virtual self_ref return_value(const std::string& value, bool move_cursor_to_next_line = true) = 0;
 
+        /// An expression statement in a function body, e.g. a call
+        virtual self_ref statement(std::string_view expression, bool move_cursor_to_next_line = true) = 0;
+
+        /// A getter for a static field, "Get_<prop_name>()". The field is looked up in the schema system on the first call, later calls return
+        /// the cached instance.
+        /// @param mod_name Name of the type scope that declares @p decl_class, e.g. "client.dll"
+        /// @param index Index of the field in the class' static fields
         virtual self_ref static_field_getter(const std::string& type_name, const std::string& prop_name, const std::string& mod_name,
                                              const std::string& decl_class, const std::size_t index) = 0;
 
@@ -158,7 +165,11 @@ namespace codegen {
         virtual self_ref static_assert_offset(std::string_view class_name, std::string_view prop_name, int expected_offset,
                                               const bool move_cursor_to_next_line = true) = 0;
 
-        virtual self_ref comment(const std::string& text, bool move_cursor_to_next_line = true) = 0;
+        /// A named compile-time constant, e.g. a field offset
+        /// @param type_name Fully qualified integer type
+        virtual self_ref constant(std::string_view type_name, std::string_view name, std::int64_t value, bool move_cursor_to_next_line = true) = 0;
+
+        virtual self_ref comment(std::string_view text, bool move_cursor_to_next_line = true) = 0;
 
         /// Not to be used for inline comments
         virtual self_ref begin_multi_line_comment(const bool move_cursor_to_next_line = true) = 0;
@@ -182,6 +193,15 @@ namespace codegen {
 
         virtual std::string str() const = 0;
 
+        /// Number of characters that have been generated
+        [[nodiscard]] virtual std::size_t size() const = 0;
+
+        /// Moves the generated code out of the generator. Cheaper than @ref str().
+        [[nodiscard]] virtual std::string take() = 0;
+
+        /// Prepares the generator for the next file, as if it had just been constructed. Keeps allocated memory.
+        virtual void reset() = 0;
+
         virtual ~IGenerator() = default;
     };
 
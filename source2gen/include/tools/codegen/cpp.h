@@ -6,21 +6,30 @@
 #include <cstdint>
 
 #include <set>
-#include <sstream>
 #include <string>
 #include <type_traits>
 
 #include "codegen.h"
 #include "detail/c_family.h"
+#include "output_buffer.h"
 #include "tools/fnv.h"
 #include <cassert>
 #include <list>
 #include <set>
-#include <sstream>
 
 namespace codegen {
-    struct generator_cpp_t final : public IGenerator {
-        using self_ref = std::add_lvalue_reference_t<generator_cpp_t>;
+    /// What the generated C++ code is used for
+    enum class CppDialect : std::uint8_t {
+        header,
+        /// C++20 module interface units. Top-level namespaces are exported and the preamble is a global module fragment.
+        module_interface,
+        /// Headers without dependencies, the preamble doesn't include sdk-static
+        offsets,
+    };
+
+    template <CppDialect kDialect>
+    struct basic_generator_cpp_t final : public IGenerator {
+        using self_ref = std::add_lvalue_reference_t<basic_generator_cpp_t>;
 
         std::string get_uint(std::size_t bits_count) const override {
             return std::format("std::{}", detail::c_family::get_uint(bits_count));
@@ -43,7 +52,7 @@ namespace codegen {
         }
 
         std::string get_file_extension() const override {
-            return "hpp";
+            return (kDialect == CppDialect::module_interface) ? "cppm" : "hpp";
         }
 
         std::string escape_type_name(std::string_view name) const override {
@@ -51,9 +60,19 @@ namespace codegen {
         }
 
         self_ref preamble() override {
+            if constexpr (kDialect == CppDialect::module_interface) {
+                // Only the standard headers, sdk-static is imported as module source2sdk.source2gen
+                push_line("module;");
+                include("cstddef", IncludeOptions{.local = false, .system = true});
+                include("cstdint", IncludeOptions{.local = false, .system = true});
+                return *this;
+            }
+
             push_line("#pragma once");
             push_line("");
-            include("source2sdk/source2gen/source2gen", IncludeOptions{.local = true, .system = false});
+            if constexpr (kDialect != CppDialect::offsets) {
+                include("source2sdk/source2gen/source2gen", IncludeOptions{.local = true, .system = false});
+            }
             include("cstddef", IncludeOptions{.local = false, .system = true});
             include("cstdint", IncludeOptions{.local = false, .system = true});
 
@@ -68,7 +87,7 @@ namespace codegen {
             return push_line(std::format("#include {}{}{}{}", open_bracket, module_or_file_name, maybe_file_extension, close_bracket));
         }
 
-        self_ref pack_push(const std::size_t alignment) override {
+        self_ref pack_push(const std::size_t alignment = 1) override {
             return push_line(std::format("#pragma pack(push, {})", alignment));
         }
 
@@ -123,10 +142,17 @@ namespace codegen {
         }
 
         self_ref begin_namespace(std::string_view namespace_name) override {
-            return begin_block(std::format("namespace {}", namespace_name));
+            // Declarations in nested namespaces are exported with their enclosing namespace
+            const auto* export_keyword = ((kDialect == CppDialect::module_interface) && (_namespace_depth == 0)) ? "export " : "";
+            ++_namespace_depth;
+
+            return begin_block(std::format("{}namespace {}", export_keyword, namespace_name));
         }
 
         self_ref end_namespace() override {
+            assert(_namespace_depth > 0);
+            --_namespace_depth;
+
             return end_block();
         }
 
@@ -140,7 +166,7 @@ namespace codegen {
         }
 
         self_ref enum_item(const std::string& name, std::uint64_t value) override {
-            return push_line(std::format("{} = {:#x},", name, value));
+            return push_line_format(true, "{} = {:#x},", name, value);
         }
 
         // @todo: @es3n1n: add func params
@@ -158,6 +184,10 @@ namespace codegen {
             return push_line(std::format("return {};", value), move_cursor_to_next_line);
         }
 
+        self_ref statement(std::string_view expression, const bool move_cursor_to_next_line = true) override {
+            return push_line_format(move_cursor_to_next_line, "{};", expression);
+        }
+
         self_ref static_field_getter(const std::string& type_name, const std::string& prop_name, const std::string& mod_name,
                                      const std::string& decl_class, const std::size_t index) override {
             begin_function("static ", type_name, std::format("&Get_{}", prop_name), false, false);
@@ -167,10 +197,12 @@ namespace codegen {
             const auto backup_tabs_count = _tabs_count;
             _tabs_count = 0;
 
-            const auto getter = std::format(
-                R"(*reinterpret_cast<{}*>(interfaces::g_schema->FindTypeScopeForModule("{}")->FindDeclaredClass("{}")->GetStaticFields()[{}]->m_pInstance))",
-                type_name, mod_name, decl_class, index);
-            return_value(getter, false);
+            // Function-local statics are initialized once, thread-safely. The lookup doesn't happen again on later calls.
+            push_line_format(false,
+                             R"(static auto* const instance = reinterpret_cast<{}*>(interfaces::g_schema->FindTypeScopeForModule("{}"))"
+                             R"(->FindDeclaredClass("{}")->GetStaticFields()[{}]->m_pInstance); )",
+                             type_name, mod_name, decl_class, index);
+            return_value("*instance", false);
             end_function(false, true);
 
             // @note: @es3n1n: restore tabs count
@@ -179,21 +211,25 @@ namespace codegen {
             return *this;
         }
 
-        self_ref static_assert_size(std::string_view type_name, int expected_size, const bool move_cursor_to_next_line) override {
+        self_ref static_assert_size(std::string_view type_name, int expected_size, const bool move_cursor_to_next_line = true) override {
             assert(expected_size > 0);
 
-            return push_line(std::format("static_assert(sizeof({}) == {:#x});", type_name, expected_size), move_cursor_to_next_line);
+            return push_line_format(move_cursor_to_next_line, "static_assert(sizeof({}) == {:#x});", type_name, expected_size);
         }
 
         self_ref static_assert_offset(std::string_view class_name, std::string_view prop_name, int expected_offset,
-                                      const bool move_cursor_to_next_line) override {
+                                      const bool move_cursor_to_next_line = true) override {
             assert(expected_offset >= 0);
 
-            return push_line(std::format("static_assert(offsetof({}, {}) == {:#x});", class_name, prop_name, expected_offset), move_cursor_to_next_line);
+            return push_line_format(move_cursor_to_next_line, "static_assert(offsetof({}, {}) == {:#x});", class_name, prop_name, expected_offset);
         }
 
-        self_ref comment(const std::string& text, const bool move_cursor_to_next_line = true) override {
-            return push_line(std::format("// {}", text), move_cursor_to_next_line);
+        self_ref constant(std::string_view type_name, std::string_view name, std::int64_t value, const bool move_cursor_to_next_line = true) override {
+            return push_line_format(move_cursor_to_next_line, "constexpr {} {} = {:#x};", type_name, name, value);
+        }
+
+        self_ref comment(std::string_view text, const bool move_cursor_to_next_line = true) override {
+            return push_line_format(move_cursor_to_next_line, "// {}", text);
         }
 
         self_ref begin_multi_line_comment(const bool move_cursor_to_next_line = true) override {
@@ -205,10 +241,9 @@ namespace codegen {
         }
 
         self_ref prop(Prop prop, bool move_cursor_to_next_line = true) override {
-            const auto line =
-                std::format("{} {}{};{}", prop.type_name, prop.name, prop.bitfield_size.has_value() ? std::format(": {}", prop.bitfield_size.value()) : "",
-                            move_cursor_to_next_line ? "" : " ");
-            return push_line(line, move_cursor_to_next_line);
+            return push_line_format(move_cursor_to_next_line, "{} {}{};{}", prop.type_name, prop.name,
+                                    prop.bitfield_size.has_value() ? std::format(": {}", prop.bitfield_size.value()) : "",
+                                    move_cursor_to_next_line ? "" : " ");
         }
 
         self_ref forward_declaration(const std::string& text) override {
@@ -224,7 +259,7 @@ namespace codegen {
             return push_line(std::format("struct {};", detail::c_family::escape_name(text)));
         }
 
-        self_ref struct_padding(Padding options, bool move_cursor_to_next_line) override {
+        self_ref struct_padding(Padding options, bool move_cursor_to_next_line = true) override {
             const auto is_bitfield{std::holds_alternative<Padding::Bits>(options.size)};
 
             // @note: @es3n1n: mark private fields as maybe_unused to silence -Wunused-private-field
@@ -263,7 +298,24 @@ namespace codegen {
 
     public:
         [[nodiscard]] std::string str() const override {
-            return _stream.str();
+            return std::string{_buffer.view()};
+        }
+
+        [[nodiscard]] std::size_t size() const override {
+            return _buffer.view().size();
+        }
+
+        [[nodiscard]] std::string take() override {
+            return _buffer.take();
+        }
+
+        void reset() override {
+            _buffer.clear();
+            _tabs_count = 0;
+            _tabs_count_backup = 0;
+            _pads_count = 0;
+            _namespace_depth = 0;
+            _forward_decls.clear();
         }
 
     private:
@@ -300,12 +352,24 @@ namespace codegen {
             return *this;
         }
 
-        self_ref push_line(const std::string& line, bool move_cursor_to_next_line = true) {
-            _stream << std::string(_tabs_count * kIndentWidth, kSpaceSym) // insert spaces
-                    << line;
+        self_ref push_line(std::string_view line, bool move_cursor_to_next_line = true) {
+            _buffer.indent(_tabs_count);
+            _buffer.append(line);
+
+            if (move_cursor_to_next_line) {
+                _buffer.append('\n');
+            }
+            return *this;
+        }
+
+        /// Like @ref push_line(), but formats directly into the buffer
+        template <typename... Args>
+        self_ref push_line_format(bool move_cursor_to_next_line, std::format_string<Args...> format, Args&&... args) {
+            _buffer.indent(_tabs_count);
+            _buffer.append_format(format, std::forward<Args>(args)...);
 
             if (move_cursor_to_next_line) {
-                _stream << std::endl;
+                _buffer.append('\n');
             }
             return *this;
         }
@@ -324,9 +388,19 @@ namespace codegen {
         }
 
     private:
-        std::stringstream _stream = {};
+        OutputBuffer _buffer = {};
         std::size_t _tabs_count = 0, _tabs_count_backup = 0;
         std::size_t _pads_count = 0;
+        std::size_t _namespace_depth = 0;
         std::set<fnv32::hash> _forward_decls = {};
     };
+
+    using generator_cpp_t = basic_generator_cpp_t<CppDialect::header>;
+
+    /// C++20 named modules. Generates the contents of module interface units, the module declaration and imports are added by
+    /// @ref sdk::AssembleModuleUnits().
+    using generator_cpp_modules_t = basic_generator_cpp_t<CppDialect::module_interface>;
+
+    /// Field offsets and enums only, see @ref source2_gen::Language::cpp_offsets
+    using generator_cpp_offsets_t = basic_generator_cpp_t<CppDialect::offsets>;
 } // namespace codegen
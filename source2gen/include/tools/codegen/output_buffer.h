@@ -0,0 +1,94 @@
+// Copyright (C) 2024 neverlosecc
+// See end of file for extended copyright information.
+#pragma once
+
+#include "codegen.h"
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <format>
+#include <iterator>
+#include <string>
+#include <string_view>
+#include <utility>
+
+namespace codegen {
+    /// Append-only text buffer of a generated file.
+    /// The contents are handed to the writer with @ref take() without copying them. The buffer then reserves as much memory as the previous
+    /// file needed, so a generator that is reused for many files rarely has to grow its buffer.
+    class OutputBuffer {
+    public:
+        /// Deepest indentation that is served from @ref kIndentation. Deeper indentation is appended in steps.
+        static constexpr std::size_t kMaxIndentationDepth = 16;
+
+        void indent(std::size_t tabs_count) {
+            while (tabs_count > 0) {
+                const auto depth = std::min(tabs_count, kMaxIndentationDepth);
+                append(kIndentation.substr(0, depth * kIndentWidth));
+                tabs_count -= depth;
+            }
+        }
+
+        void append(std::string_view text) {
+            _data.append(text);
+        }
+
+        void append(char c) {
+            _data.push_back(c);
+        }
+
+        /// Formats directly into the buffer without creating a temporary string
+        template <typename... Args>
+        void append_format(std::format_string<Args...> format, Args&&... args) {
+            std::format_to(std::back_inserter(_data), format, std::forward<Args>(args)...);
+        }
+
+        [[nodiscard]] std::string_view view() const {
+            return _data;
+        }
+
+        /// Leaves the buffer empty
+        [[nodiscard]] std::string take() {
+            _size_hint = std::max(_size_hint, _data.size());
+
+            auto result = std::exchange(_data, std::string{});
+            _data.reserve(_size_hint);
+
+            return result;
+        }
+
+        /// Keeps the allocated memory
+        void clear() {
+            _data.clear();
+        }
+
+    private:
+        static constexpr auto kIndentationStorage = []() {
+            std::array<char, kMaxIndentationDepth * kIndentWidth> result{};
+            result.fill(kSpaceSym);
+            return result;
+        }();
+
+        static constexpr std::string_view kIndentation{kIndentationStorage.data(), kIndentationStorage.size()};
+
+        std::string _data{};
+        /// Size of the largest file that has been taken out of this buffer
+        std::size_t _size_hint{};
+    };
+} // namespace codegen
+
+// source2gen - Source2 games SDK generator
+// Copyright 2024 neverlosecc
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
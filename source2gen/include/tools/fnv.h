@@ -2,6 +2,7 @@
 // See end of file for extended copyright information.
 #pragma once
 #include <cstdint>
+#include <string_view>
 #include <type_traits>
 
 // Implements FNV-1a hash algorithm
@@ -60,12 +61,23 @@ namespace detail {
 
             return result;
         }
+
+        /// Unlike @ref hash_runtime(), this hashes embedded nulls and returns the offset basis for empty input
+        static constexpr auto hash_bytes(std::string_view data) -> hash {
+            auto result = hash_init();
+            for (const auto c : data)
+                result = hash_byte(result, static_cast<std::uint8_t>(c));
+
+            return result;
+        }
     };
 } // namespace detail
 
 using fnv32 = ::detail::FnvHash<32>;
 #define FNV32(str) (std::integral_constant<fnv32::hash, fnv32::hash_constexpr(str)>::value)
 
+using fnv64 = ::detail::FnvHash<64>;
+
 // source2gen - Source2 games SDK generator
 // Copyright 2024 neverlosecc
 //
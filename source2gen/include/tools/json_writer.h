@@ -0,0 +1,83 @@
+// Copyright (C) 2024 neverlosecc
+// See end of file for extended copyright information.
+#pragma once
+
+#include <charconv>
+#include <concepts>
+#include <cstddef>
+#include <ostream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace util {
+    /// Writes JSON to a stream as it is produced, without building a document. Memory usage only depends on @ref kBufferSize and the nesting
+    /// depth, not on the size of the output.
+    /// Commas and colons are inserted automatically. Values inside of an object must be preceded by @ref Key().
+    class JsonWriter {
+    public:
+        /// Output is collected up to this size before it's handed to the stream
+        static constexpr std::size_t kBufferSize = 64 * 1024;
+
+        explicit JsonWriter(std::ostream& out);
+
+        JsonWriter(const JsonWriter&) = delete;
+        JsonWriter& operator=(const JsonWriter&) = delete;
+
+        /// Calls @ref Flush()
+        ~JsonWriter();
+
+        void BeginObject();
+        void EndObject();
+        void BeginArray();
+        void EndArray();
+
+        void Key(std::string_view key);
+
+        void String(std::string_view value);
+        void Bool(bool value);
+        void Null();
+
+        template <std::integral T>
+        void Number(T value) {
+            BeginValue();
+
+            char digits[24]{};
+            const auto result = std::to_chars(std::begin(digits), std::end(digits), value);
+            _buffer.append(digits, result.ptr);
+
+            FlushIfFull();
+        }
+
+        /// Hands buffered output to the stream
+        void Flush();
+
+    private:
+        /// Writes the separator in front of a value
+        void BeginValue();
+        void FlushIfFull();
+
+        std::ostream& _out;
+        std::string _buffer{};
+        /// One entry per open object or array, whether it has at least one element
+        std::vector<bool> _has_elements{};
+        /// A key has been written, its value is next
+        bool _after_key{};
+    };
+} // namespace util
+
+// source2gen - Source2 games SDK generator
+// Copyright 2024 neverlosecc
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
@@ -49,6 +49,17 @@ namespace loader {
         return platform::load_module(name);
     }
 
+    /// Releases a handle returned by @ref load_module(). The module is unloaded once all of its handles have been released and no other module
+    /// depends on it. @p handle must not be used afterwards.
+    [[nodiscard]] inline auto unload_module(module_handle_t handle) -> std::expected<void, ModuleLookupError> {
+        return platform::unload_module(handle);
+    }
+
+    /// @return Path of the file @p handle has been loaded from
+    [[nodiscard]] inline auto get_module_path(module_handle_t handle) -> std::expected<std::string, ModuleLookupError> {
+        return platform::get_module_path(handle);
+    }
+
     template <typename Ty = module_handle_t>
     [[nodiscard]] inline auto find_module_symbol(module_handle_t handle, std::string_view name) -> std::expected<Ty, ModuleLookupError> {
         return platform::find_module_symbol<Ty>(handle, name);
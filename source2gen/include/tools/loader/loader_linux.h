@@ -6,6 +6,7 @@
 #include <cstring>
 #include <dlfcn.h>
 #include <expected>
+#include <link.h>
 #include <string>
 #include <string_view>
 
@@ -33,6 +34,21 @@ namespace loader::linux {
         return std::unexpected(ModuleLookupError::from_string(dlerror()));
     }
 
+    [[nodiscard]] inline auto unload_module(module_handle_t handle) -> std::expected<void, ModuleLookupError> {
+        if (dlclose(handle) != 0) {
+            return std::unexpected(ModuleLookupError::from_string(dlerror()));
+        }
+        return {};
+    }
+
+    [[nodiscard]] inline auto get_module_path(module_handle_t handle) -> std::expected<std::string, ModuleLookupError> {
+        link_map* map = nullptr;
+        if (dlinfo(handle, RTLD_DI_LINKMAP, &map) != 0) {
+            return std::unexpected(ModuleLookupError::from_string(dlerror()));
+        }
+        return std::string{map->l_name};
+    }
+
     template <typename Ty>
     [[nodiscard]] inline auto find_module_symbol(module_handle_t handle, std::string_view name) -> std::expected<Ty, ModuleLookupError> {
         assert(handle != nullptr && "If you need RTLD_DEFAULT, write a new function to avoid magic values. Most of the time when handle=nullptr, a "
@@ -47,6 +47,25 @@ namespace loader::windows {
         return result;
     }
 
+    [[nodiscard]] inline auto unload_module(module_handle_t handle) -> std::expected<void, ModuleLookupError> {
+        if (FreeLibrary(handle) == 0) {
+            return std::unexpected(detail::win32_error());
+        }
+
+        return {};
+    }
+
+    [[nodiscard]] inline auto get_module_path(module_handle_t handle) -> std::expected<std::string, ModuleLookupError> {
+        std::string result(MAX_PATH, '\0');
+        const auto size = GetModuleFileNameA(handle, result.data(), static_cast<DWORD>(result.size()));
+        if (size == 0) {
+            return std::unexpected(detail::win32_error());
+        }
+
+        result.resize(size);
+        return result;
+    }
+
     template <typename Ty>
     [[nodiscard]] inline auto find_module_symbol(module_handle_t handle, std::string_view name) -> std::expected<Ty, ModuleLookupError> {
         assert(handle != nullptr);
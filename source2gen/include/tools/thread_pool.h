@@ -0,0 +1,91 @@
+// Copyright (C) 2024 neverlosecc
+// See end of file for extended copyright information.
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <thread>
+#include <vector>
+
+namespace util {
+    /// Work-stealing thread pool.
+    /// Every worker owns a task queue. Workers take work from their own queue and steal from other workers' queues once they run dry, so a
+    /// few long tasks don't leave the remaining workers idle.
+    /// Tasks are distributed round-robin and every queue is drained front to back, so tasks start roughly in submission order. Submit
+    /// expensive tasks first to keep the tail of a run short.
+    class ThreadPool {
+    public:
+        using Task = std::function<void()>;
+
+        /// @param thread_count Number of worker threads. 0 uses @ref std::thread::hardware_concurrency()
+        explicit ThreadPool(std::size_t thread_count);
+
+        ThreadPool(const ThreadPool&) = delete;
+        ThreadPool& operator=(const ThreadPool&) = delete;
+
+        /// Waits for all pending tasks before joining the workers
+        ~ThreadPool();
+
+        void Submit(Task task);
+
+        /// Blocks until all submitted tasks have finished.
+        /// Rethrows the first exception that was thrown by a task. Tasks that were submitted after the failing task still run.
+        void Wait();
+
+        [[nodiscard]] std::size_t GetThreadCount() const {
+            return _workers.size();
+        }
+
+        /// @return Number of workers @p requested resolves to on this machine
+        [[nodiscard]] static std::size_t ResolveThreadCount(std::size_t requested);
+
+    private:
+        struct Queue {
+            std::mutex mutex{};
+            std::deque<Task> tasks{};
+        };
+
+        void WorkerLoop(std::size_t index);
+
+        /// Pops from the worker's own queue first, steals from the others otherwise.
+        [[nodiscard]] std::optional<Task> TryPop(std::size_t index);
+
+    private:
+        std::vector<std::unique_ptr<Queue>> _queues{};
+        std::vector<std::thread> _workers{};
+        std::atomic<std::size_t> _next_queue{0};
+
+        std::mutex _state_mutex{};
+        std::condition_variable _work_available{};
+        std::condition_variable _all_done{};
+        /// Tasks that are sitting in a queue
+        std::size_t _queued = 0;
+        /// Tasks that have been submitted, but haven't finished yet
+        std::size_t _pending = 0;
+        bool _stopping = false;
+        std::exception_ptr _first_error{};
+    };
+} // namespace util
+
+// source2gen - Source2 games SDK generator
+// Copyright 2024 neverlosecc
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
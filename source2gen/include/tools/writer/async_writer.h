@@ -0,0 +1,101 @@
+// Copyright (C) 2024 neverlosecc
+// See end of file for extended copyright information.
+#pragma once
+
+#include "tools/writer/output_index.h"
+#include "tools/writer/writer.h"
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+
+namespace util {
+    struct AsyncWriterOptions {
+        std::size_t thread_count = 2;
+        /// Number of files that may be waiting to be written. @ref AsyncFileWriter::Enqueue() blocks when the queue is full, which bounds memory
+        /// usage if generation outpaces the disk.
+        std::size_t queue_capacity = 1024;
+        /// Maximum number of files handed to the backend at once
+        std::size_t batch_size = 64;
+    };
+
+    struct WriteSummary {
+        /// Files that could not be written
+        std::vector<WriteError> errors{};
+        std::size_t written = 0;
+        /// Files that already had the desired contents
+        std::size_t skipped = 0;
+    };
+
+    /// Writes files on dedicated threads so that generator threads don't block on I/O.
+    /// Errors don't stop the writer, they're collected and returned by @ref Finish().
+    class AsyncFileWriter {
+    public:
+        using BackendFactory = std::function<std::unique_ptr<IWriteBackend>()>;
+
+        /// @param make_backend Called once per writer thread, on the calling thread
+        /// @param index If set, files whose contents haven't changed since they were last written are skipped. Receives all written files.
+        ///              Must outlive the writer.
+        AsyncFileWriter(const BackendFactory& make_backend, AsyncWriterOptions options, OutputIndex* index = nullptr);
+
+        AsyncFileWriter(const AsyncFileWriter&) = delete;
+        AsyncFileWriter& operator=(const AsyncFileWriter&) = delete;
+
+        /// Calls @ref Finish() if it hasn't been called yet. Errors are discarded.
+        ~AsyncFileWriter();
+
+        /// Thread-safe. Blocks while the queue is full.
+        void Enqueue(std::filesystem::path path, std::string contents);
+
+        /// Blocks until all enqueued files have been written
+        void Flush();
+
+        /// Waits until all enqueued files have been written and stops the writer threads.
+        /// Must not be called concurrently with @ref Enqueue(). Nothing can be enqueued afterwards.
+        /// @return Everything that happened since the writer was created
+        [[nodiscard]] WriteSummary Finish();
+
+    private:
+        struct QueuedWrite {
+            PendingWrite file{};
+            /// Recorded in the index once the file has been written
+            OutputIndex::Entry entry{};
+        };
+
+        void WriterLoop(IWriteBackend& backend);
+
+    private:
+        const AsyncWriterOptions _options;
+        OutputIndex* const _index;
+        std::vector<std::unique_ptr<IWriteBackend>> _backends{};
+        std::vector<std::thread> _threads{};
+
+        std::mutex _mutex{};
+        std::condition_variable _not_empty{};
+        std::condition_variable _not_full{};
+        std::condition_variable _idle{};
+        std::deque<QueuedWrite> _queue{};
+        /// Files that have been taken off the queue, but haven't been written yet
+        std::size_t _in_flight = 0;
+        bool _finishing = false;
+        WriteSummary _summary{};
+    };
+} // namespace util
+
+// source2gen - Source2 games SDK generator
+// Copyright 2024 neverlosecc
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
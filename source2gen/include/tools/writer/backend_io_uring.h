@@ -0,0 +1,54 @@
+// Copyright (C) 2024 neverlosecc
+// See end of file for extended copyright information.
+#pragma once
+
+#include "tools/writer/writer.h"
+#include <expected>
+
+#if TARGET_OS == LINUX
+namespace util {
+    /// Uses raw io_uring system calls, we don't depend on liburing.
+    /// Every batch costs two io_uring_enter(2) calls: One submits all opens, the other submits all writes, each linked to a close.
+    /// Requires Linux 5.6 (IORING_OP_OPENAT, IORING_OP_CLOSE).
+    /// If io_uring_enter(2) fails, the ring is not used again and all remaining files are written by @ref PosixWriteBackend.
+    class IoUringWriteBackend final : public IWriteBackend {
+    public:
+        /// @return Error message if io_uring is unavailable, e.g. because the kernel is too old or io_uring has been disabled
+        [[nodiscard]] static std::expected<std::unique_ptr<IoUringWriteBackend>, std::string> Create();
+
+        IoUringWriteBackend(const IoUringWriteBackend&) = delete;
+        IoUringWriteBackend& operator=(const IoUringWriteBackend&) = delete;
+
+        ~IoUringWriteBackend() override;
+
+        void Write(std::span<const PendingWrite> batch, std::vector<WriteError>& errors) override;
+
+    private:
+        struct Ring;
+
+        explicit IoUringWriteBackend(std::unique_ptr<Ring> ring);
+
+        /// Writes at most half as many files as the ring has entries, because every file needs a write and a close.
+        void WriteChunk(std::span<const PendingWrite> chunk, std::vector<WriteError>& errors);
+
+    private:
+        std::unique_ptr<Ring> _ring{};
+    };
+} // namespace util
+#endif
+
+// source2gen - Source2 games SDK generator
+// Copyright 2024 neverlosecc
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
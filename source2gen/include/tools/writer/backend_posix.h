@@ -0,0 +1,34 @@
+// Copyright (C) 2024 neverlosecc
+// See end of file for extended copyright information.
+#pragma once
+
+#include "tools/writer/writer.h"
+
+#if TARGET_OS == LINUX
+namespace util {
+    class PosixWriteBackend final : public IWriteBackend {
+    public:
+        void Write(std::span<const PendingWrite> batch, std::vector<WriteError>& errors) override;
+
+        /// Writes a single file. Shared with @ref IoUringWriteBackend for files that it couldn't finish.
+        /// @return Error message on failure
+        [[nodiscard]] static std::optional<std::string> WriteFile(const PendingWrite& file);
+    };
+} // namespace util
+#endif
+
+// source2gen - Source2 games SDK generator
+// Copyright 2024 neverlosecc
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
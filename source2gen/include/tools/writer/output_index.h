@@ -0,0 +1,80 @@
+// Copyright (C) 2024 neverlosecc
+// See end of file for extended copyright information.
+#pragma once
+
+#include <cstdint>
+#include <filesystem>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+namespace util {
+    /// Remembers the contents of every file that was written by the previous run, so that unchanged files don't have to be rewritten and
+    /// keep their modification time. The files themselves are never read, only stat'ed.
+    /// Files that have been modified after the index was saved are considered changed.
+    class OutputIndex {
+    public:
+        struct Entry {
+            /// fnv64 of the contents
+            std::uint64_t hash{};
+            std::uint64_t size{};
+        };
+
+        OutputIndex() = default;
+
+        /// Not thread-safe, don't move an index that is in use
+        OutputIndex(OutputIndex&& other) noexcept;
+
+        /// A missing or malformed file results in an empty index, causing all files to be written
+        [[nodiscard]] static OutputIndex Load(const std::filesystem::path& path);
+
+        /// Logs errors
+        /// @return true on success
+        bool Save(const std::filesystem::path& path) const;
+
+        [[nodiscard]] static Entry MakeEntry(std::string_view contents);
+
+        /// Thread-safe
+        /// @return true if @p path exists on disk and has the contents described by @p entry
+        [[nodiscard]] bool IsUpToDate(const std::filesystem::path& path, const Entry& entry);
+
+        /// Thread-safe. Call after @p path has been written.
+        void Record(const std::filesystem::path& path, const Entry& entry);
+
+        /// Thread-safe. Call if writing @p path failed, its state on disk is unknown.
+        void Forget(const std::filesystem::path& path);
+
+        /// Removes all files from the index that have neither been recorded nor checked since the index was loaded.
+        /// They belong to types that don't exist anymore.
+        /// @return The removed files
+        [[nodiscard]] std::vector<std::filesystem::path> TakeStaleFiles();
+
+    private:
+        mutable std::mutex _mutex{};
+        /// Key is the generic path
+        std::unordered_map<std::string, Entry> _entries{};
+        /// Keys of @ref _entries that have been recorded or checked by this run
+        std::unordered_set<std::string> _used{};
+        /// When the index was saved. Files modified later have been touched by someone else.
+        std::filesystem::file_time_type _saved_at{};
+    };
+} // namespace util
+
+// source2gen - Source2 games SDK generator
+// Copyright 2024 neverlosecc
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
@@ -0,0 +1,69 @@
+// Copyright (C) 2024 neverlosecc
+// See end of file for extended copyright information.
+#pragma once
+
+#include "tools/platform.h"
+#include <filesystem>
+#include <memory>
+#include <optional>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace util {
+    /// A file that is waiting to be written
+    struct PendingWrite {
+        std::filesystem::path path{};
+        std::string contents{};
+    };
+
+    struct WriteError {
+        std::filesystem::path path{};
+        std::string message{};
+    };
+
+    /// Writes batches of files to disk.
+    /// Backends are not thread-safe, every writer thread owns its own backend.
+    class IWriteBackend {
+    public:
+        virtual ~IWriteBackend() = default;
+
+        /// Creates or truncates every file in @p batch and writes its contents.
+        /// A failure to write one file doesn't affect the other files.
+        /// @param errors Receives one entry per file that couldn't be written
+        virtual void Write(std::span<const PendingWrite> batch, std::vector<WriteError>& errors) = 0;
+    };
+
+    enum class WriteBackend {
+        /// @ref std::ofstream. Portable, but slowest.
+        stream,
+        /// open(2), write(2), close(2)
+        posix,
+        /// Submits a whole batch of opens, writes, and closes at once. Falls back to @ref posix if io_uring is unavailable.
+        io_uring,
+    };
+
+    constexpr WriteBackend kDefaultWriteBackend = platform_specific{.windows = WriteBackend::stream, .linux = WriteBackend::io_uring}.get();
+
+    /// @return std::nullopt if @p name is unknown or the backend isn't supported on this platform
+    [[nodiscard]] std::optional<WriteBackend> ParseWriteBackend(std::string_view name);
+
+    [[nodiscard]] std::unique_ptr<IWriteBackend> MakeWriteBackend(WriteBackend backend);
+} // namespace util
+
+// source2gen - Source2 games SDK generator
+// Copyright 2024 neverlosecc
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
@@ -10,6 +10,12 @@ int main(const int argc, char* argv[]) {
     int exit_code = 1;
 
     const auto options = source2_gen::Options::parse_args(argc, argv);
+
+    // Runs in a terminal or script, there's nothing to wait for
+    if (options.has_value() && options->diff.has_value()) {
+        return source2_gen::Diff(options->diff.value());
+    }
+
     if (options.has_value() && Dump(*options)) {
         std::cout << std::format("Successfully dumped Source 2 SDK, now you can safely close this console.") << std::endl;
         std::cout << kPoweredByMessage << std::endl;
@@ -1,6 +1,10 @@
 #include "options.hpp"
+#include <algorithm>
 #include <argparse/argparse.hpp>
+#include <cassert>
+#include <format>
 #include <iostream>
+#include <ranges>
 
 [[nodiscard]]
 static std::optional<source2_gen::Language> parse_language(std::string_view str) {
@@ -12,23 +16,120 @@ static std::optional<source2_gen::Language> parse_language(std::string_view str)
         return c_ida;
     } else if (str == "cpp") {
         return cpp;
+    } else if (str == "cpp-modules") {
+        return cpp_modules;
+    } else if (str == "cpp-offsets") {
+        return cpp_offsets;
+    } else if (str == "schema-bin") {
+        return schema_bin;
+    } else if (str == "json") {
+        return json;
     } else {
         return std::nullopt;
     }
 }
 
+/// @param str Comma-separated list of languages, e.g. "cpp,c-ida"
+/// @return @ref std::nullopt if a language is unknown or the list is empty. Duplicates are removed.
+[[nodiscard]]
+static std::optional<std::vector<source2_gen::Language>> parse_languages(std::string_view str) {
+    std::vector<source2_gen::Language> result{};
+
+    for (const auto name : str | std::views::split(',')) {
+        const auto language{parse_language(std::string_view{name})};
+
+        if (!language.has_value()) {
+            return std::nullopt;
+        }
+
+        if (std::ranges::find(result, language.value()) == result.end()) {
+            result.emplace_back(language.value());
+        }
+    }
+
+    if (result.empty()) {
+        return std::nullopt;
+    }
+
+    return result;
+}
+
+[[nodiscard]]
+static std::optional<source2_gen::Amalgamation> parse_amalgamation(std::string_view str) {
+    using enum source2_gen::Amalgamation;
+
+    if (str == "module") {
+        return module;
+    } else if (str == "sdk") {
+        return sdk;
+    } else {
+        return std::nullopt;
+    }
+}
+
+std::string_view source2_gen::get_language_name(Language language) {
+    switch (language) {
+    case Language::cpp:
+        return "cpp";
+    case Language::c:
+        return "c";
+    case Language::c_ida:
+        return "c-ida";
+    case Language::cpp_modules:
+        return "cpp-modules";
+    case Language::cpp_offsets:
+        return "cpp-offsets";
+    case Language::schema_bin:
+        return "schema-bin";
+    case Language::json:
+        return "json";
+    }
+
+    assert(false && "unhandled enumerator");
+    std::abort();
+}
+
 std::optional<source2_gen::Options> source2_gen::Options::parse_args(int argc, char* argv[]) {
     argparse::ArgumentParser parser{"source2gen"};
 
     parser.add_argument("--emit-language")
-        .choices("cpp", "c", "c-ida")
         .default_value("cpp")
-        .help("Programming language to be used for the generated SDK [cpp, c, c-ida]");
+        .help("Comma-separated programming languages to be used for the generated SDK [cpp, cpp-modules, cpp-offsets, c, c-ida, schema-bin, "
+              "json], e.g. cpp,c-ida. All languages are generated in a single run");
     parser.add_argument("--no-static-members").default_value(false).help("Don't generate getters for static member variables");
     parser.add_argument("--no-static-assertions")
         .default_value(false)
         .help("Don't generate static assertions for class size and field offsets (Generated SDK might not work. You can get banned for writing to wrong "
               "offsets!)");
+    parser.add_argument("-j", "--jobs")
+        .default_value(std::size_t{0})
+        .scan<'u', std::size_t>()
+        .help("Number of threads used to generate the SDK. 0 uses all hardware threads");
+    parser.add_argument("--write-backend")
+        .help(std::format("How generated files are written to disk [{}]. Defaults to {}", IF_WINDOWS("stream") IF_LINUX("stream, posix, io-uring"),
+                          IF_WINDOWS("stream") IF_LINUX("io-uring")));
+    parser.add_argument("--timing-history")
+        .help("File that stores how long each type took to generate. Used to schedule expensive types first in the next run");
+    parser.add_argument("--save-snapshot").help("Save everything the generator reads from the game to this file");
+    parser.add_argument("--from-snapshot").help("Generate from a file saved by --save-snapshot. The game is not loaded");
+    parser.add_argument("--amalgamate")
+        .help("Also merge the C++ SDK into one header per module (module) or a single header (sdk) in sdk/amalgamated. Types are ordered by their "
+              "dependencies");
+    parser.add_argument("--amalgamate-only").default_value(false).help("Don't write one header per type, requires --amalgamate");
+    parser.add_argument("--include-report")
+        .help("Write the number of headers every header includes directly and transitively to this file, before and after minimizing includes");
+    parser.add_argument("--field-table")
+        .default_value(false)
+        .help("Also write source2sdk/field_table.hpp, which looks up the offset, size, and type of a field by module, class, and field name in "
+              "constant time (cpp and cpp-offsets only)");
+
+    argparse::ArgumentParser diff_command{"diff"};
+    diff_command.add_description("Compare two schemas, e.g. before and after a game update, and print what has changed. Exits with 0 if they are "
+                                 "equal, 1 if they differ, and 2 on errors");
+    diff_command.add_argument("old").help("Snapshot saved by --save-snapshot, or schema.bin written by --emit-language schema-bin");
+    diff_command.add_argument("new").help("Snapshot or schema.bin to compare to the old one");
+    diff_command.add_argument("--report").help("Also write all changes to this file as JSON");
+    parser.add_subparser(diff_command);
 
     try {
         parser.parse_args(argc, argv);
@@ -37,14 +138,50 @@ std::optional<source2_gen::Options> source2_gen::Options::parse_args(int argc, c
         return std::nullopt;
     }
 
-    const auto language{parse_language(parser.get<std::string>("emit-language"))};
+    if (parser.is_subcommand_used(diff_command)) {
+        return source2_gen::Options{.diff = DiffOptions{
+                                        .old_schema = diff_command.get<std::string>("old"),
+                                        .new_schema = diff_command.get<std::string>("new"),
+                                        .report = diff_command.present("report").transform([](const auto& path) { return std::filesystem::path{path}; }),
+                                    }};
+    }
+
+    const auto languages{parse_languages(parser.get<std::string>("emit-language"))};
 
-    if (!language.has_value()) {
+    if (!languages.has_value()) {
         std::cerr << "invalid value for --emit-language" << std::endl;
         return std::nullopt;
     }
 
-    return source2_gen::Options{.emit_language = language.value(),
-                                .static_members = (language.value() != Language::c_ida) && !parser.is_used("no-static-members"),
-                                .static_assertions = (language.value() != Language::c_ida) && !parser.is_used("no-static-assertions")};
+    const auto write_backend{parser.present("write-backend").transform(util::ParseWriteBackend).value_or(util::kDefaultWriteBackend)};
+
+    if (!write_backend.has_value()) {
+        std::cerr << "invalid value for --write-backend" << std::endl;
+        return std::nullopt;
+    }
+
+    const auto amalgamation{parser.present("amalgamate").transform(parse_amalgamation).value_or(Amalgamation::none)};
+
+    if (!amalgamation.has_value()) {
+        std::cerr << "invalid value for --amalgamate" << std::endl;
+        return std::nullopt;
+    }
+
+    if (parser.is_used("amalgamate-only") && (amalgamation.value() == Amalgamation::none)) {
+        std::cerr << "--amalgamate-only requires --amalgamate" << std::endl;
+        return std::nullopt;
+    }
+
+    return source2_gen::Options{.emit_languages = languages.value(),
+                                .static_members = !parser.is_used("no-static-members"),
+                                .static_assertions = !parser.is_used("no-static-assertions"),
+                                .jobs = parser.get<std::size_t>("jobs"),
+                                .timing_history = parser.present("timing-history").transform([](const auto& path) { return std::filesystem::path{path}; }),
+                                .write_backend = write_backend.value(),
+                                .save_snapshot = parser.present("save-snapshot").transform([](const auto& path) { return std::filesystem::path{path}; }),
+                                .from_snapshot = parser.present("from-snapshot").transform([](const auto& path) { return std::filesystem::path{path}; }),
+                                .amalgamation = amalgamation.value(),
+                                .amalgamation_only = parser.is_used("amalgamate-only"),
+                                .include_report = parser.present("include-report").transform([](const auto& path) { return std::filesystem::path{path}; }),
+                                .field_table = parser.is_used("field-table")};
 }
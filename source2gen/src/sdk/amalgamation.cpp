@@ -0,0 +1,402 @@
+// Copyright (C) 2024 neverlosecc
+// See end of file for extended copyright information.
+#include "sdk/amalgamation.h"
+#include "sdk/include_graph.h"
+#include "tools/codegen/cpp.h"
+#include <algorithm>
+#include <cstdint>
+#include <format>
+#include <iostream>
+#include <map>
+#include <numeric>
+#include <set>
+#include <unordered_map>
+
+namespace {
+    constexpr std::string_view kIncludeDirName = "source2sdk";
+    /// Named modules are "source2sdk.<module>"
+    constexpr std::string_view kModuleNamePrefix = "source2sdk";
+    /// Module of sdk-static, see sdk-static/cpp-modules
+    constexpr std::string_view kStaticModuleName = "source2gen";
+
+    /// @param dependencies Modules whose headers have to be included
+    [[nodiscard]] std::string AssembleHeader(std::span<const sdk::GeneratedFile* const> files, const std::set<std::string_view>& dependencies) {
+        codegen::generator_cpp_t generator{};
+        generator.preamble();
+
+        for (const auto module_name : dependencies) {
+            generator.include(std::format("{}/{}", kIncludeDirName, module_name), codegen::IncludeOptions{.local = true, .system = false});
+        }
+
+        std::set<sdk::TypeIdentifier> forward_declarations{};
+        std::size_t size = 0;
+
+        for (const auto* file : files) {
+            forward_declarations.insert(file->forward_declarations.begin(), file->forward_declarations.end());
+            size += file->contents.size() - file->definition_offset;
+        }
+
+        for (const auto& forward_declaration : forward_declarations) {
+            generator.begin_namespace("source2sdk");
+            generator.begin_namespace(forward_declaration.module);
+            generator.forward_declaration(forward_declaration.name);
+            generator.end_namespace();
+            generator.end_namespace();
+        }
+
+        auto result = generator.take();
+        result.reserve(result.size() + size);
+
+        for (const auto* file : files) {
+            result.append(std::string_view{file->contents}.substr(file->definition_offset));
+        }
+
+        return result;
+    }
+
+    /// @param modules Modules whose types are in this unit. The unit is the interface of the first one.
+    /// @param files Files of @p modules, in the order their types are defined in
+    /// @param imports Modules the unit depends on
+    /// @param forward_declarations Key is the module of the declared types. Only entries of @p modules are used.
+    [[nodiscard]] std::string AssembleModuleUnit(std::span<const std::string_view> modules, std::span<const sdk::GeneratedFile* const> files,
+                                                 const std::set<std::string_view>& imports,
+                                                 const std::map<std::string_view, std::set<std::string_view>>& forward_declarations) {
+        codegen::generator_cpp_modules_t generator{};
+        generator.preamble();
+
+        auto result = generator.take();
+        result += std::format("export module {}.{};\n", kModuleNamePrefix, modules.front());
+
+        // Re-exported, so importers can use the types of fields like they could with headers that include their dependencies
+        result += std::format("export import {}.{};\n", kModuleNamePrefix, kStaticModuleName);
+        for (const auto module_name : imports) {
+            result += std::format("export import {}.{};\n", kModuleNamePrefix, module_name);
+        }
+
+        for (const auto module_name : modules) {
+            const auto found = forward_declarations.find(module_name);
+            if (found == forward_declarations.end()) {
+                continue;
+            }
+
+            for (const auto type_name : found->second) {
+                generator.begin_namespace(kIncludeDirName);
+                generator.begin_namespace(module_name);
+                generator.forward_declaration(std::string{type_name});
+                generator.end_namespace();
+                generator.end_namespace();
+            }
+        }
+
+        result += generator.take();
+
+        std::size_t size = 0;
+        for (const auto* file : files) {
+            size += file->contents.size() - file->definition_offset;
+        }
+
+        result.reserve(result.size() + size);
+
+        for (const auto* file : files) {
+            result.append(std::string_view{file->contents}.substr(file->definition_offset));
+        }
+
+        return result;
+    }
+
+    enum class Mark : std::uint8_t {
+        unvisited,
+        in_progress,
+        done,
+    };
+
+    using ModuleDependencies = std::map<std::string_view, std::set<std::string_view>>;
+
+    void VisitModule(const ModuleDependencies& dependencies, std::string_view module_name, std::map<std::string_view, Mark>& marks,
+                     std::vector<std::string_view>& path) {
+        auto& mark = marks[module_name];
+
+        if (mark == Mark::in_progress) {
+            std::string cycle{};
+            for (auto it = std::ranges::find(path, module_name); it != path.end(); ++it) {
+                cycle += std::format("{} -> ", *it);
+            }
+
+            std::cerr << std::format("{}: warning: module headers include each other ({}{}), use --amalgamate sdk", __FUNCTION__, cycle, module_name)
+                      << std::endl;
+            return;
+        }
+
+        if (mark == Mark::done) {
+            return;
+        }
+
+        mark = Mark::in_progress;
+        path.emplace_back(module_name);
+
+        if (const auto found = dependencies.find(module_name); found != dependencies.end()) {
+            for (const auto dependency : found->second) {
+                VisitModule(dependencies, dependency, marks, path);
+            }
+        }
+
+        path.pop_back();
+        marks[module_name] = Mark::done;
+    }
+
+    /// Module headers include each other. If modules depend on each other in a cycle, some of their types are incomplete.
+    /// There are only a few dozen modules, recursion is fine.
+    void WarnAboutModuleCycles(const ModuleDependencies& dependencies) {
+        std::map<std::string_view, Mark> marks{};
+        std::vector<std::string_view> path{};
+
+        for (const auto& [module_name, _] : dependencies) {
+            VisitModule(dependencies, module_name, marks, path);
+        }
+    }
+} // namespace
+
+namespace sdk {
+    std::vector<const GeneratedFile*> SortByIncludes(std::span<const GeneratedFile> files) {
+        std::vector<std::size_t> by_path(files.size());
+        std::iota(by_path.begin(), by_path.end(), std::size_t{0});
+        std::ranges::sort(by_path, {}, [&](std::size_t i) -> const std::filesystem::path& { return files[i].path; });
+
+        std::unordered_map<std::filesystem::path, std::size_t> index_of_path{};
+        index_of_path.reserve(files.size());
+        for (std::size_t i = 0; i < files.size(); ++i) {
+            index_of_path.emplace(files[i].path, i);
+        }
+
+        enum class Mark : std::uint8_t {
+            unvisited,
+            in_progress,
+            done,
+        };
+
+        struct Frame {
+            std::size_t file{};
+            /// Index into the file's includes
+            std::size_t next_include{};
+        };
+
+        std::vector<Mark> marks(files.size(), Mark::unvisited);
+        std::vector<const GeneratedFile*> result{};
+        result.reserve(files.size());
+
+        // Depth-first, with an explicit stack because include chains can be long
+        std::vector<Frame> stack{};
+
+        for (const auto root : by_path) {
+            if (marks[root] != Mark::unvisited) {
+                continue;
+            }
+
+            marks[root] = Mark::in_progress;
+            stack.emplace_back(Frame{.file = root});
+
+            while (!stack.empty()) {
+                auto& frame = stack.back();
+                const auto& file = files[frame.file];
+
+                if (frame.next_include < file.includes.size()) {
+                    const auto found = index_of_path.find(file.includes[frame.next_include++]);
+
+                    // Files that have not been generated are not part of the graph. in_progress files close a cycle.
+                    if ((found != index_of_path.end()) && (marks[found->second] == Mark::unvisited)) {
+                        marks[found->second] = Mark::in_progress;
+                        stack.emplace_back(Frame{.file = found->second});
+                    }
+                } else {
+                    marks[frame.file] = Mark::done;
+                    result.emplace_back(&file);
+                    stack.pop_back();
+                }
+            }
+        }
+
+        return result;
+    }
+
+    void AmalgamateSdk(const EmitTarget& target, std::span<const GeneratedFile> files, util::AsyncFileWriter& writer) {
+        const auto directory = target.directory / "amalgamated";
+        const auto sorted = SortByIncludes(files);
+
+        switch (target.amalgamation) {
+        case source2_gen::Amalgamation::none:
+            return;
+        case source2_gen::Amalgamation::sdk:
+            std::filesystem::create_directories(directory);
+            writer.Enqueue(directory / std::format("{}.hpp", kIncludeDirName), AssembleHeader(sorted, {}));
+            return;
+        case source2_gen::Amalgamation::module:
+            break;
+        }
+
+        std::unordered_map<std::filesystem::path, std::string_view> module_of_path{};
+        for (const auto& file : files) {
+            module_of_path.emplace(file.path, file.module);
+        }
+
+        // Files of every module, in the order of all files
+        std::map<std::string_view, std::vector<const GeneratedFile*>> modules{};
+        ModuleDependencies dependencies{};
+
+        for (const auto* file : sorted) {
+            modules[file->module].emplace_back(file);
+            auto& module_dependencies = dependencies[file->module];
+
+            for (const auto& include : file->includes) {
+                if (const auto found = module_of_path.find(include); (found != module_of_path.end()) && (found->second != file->module)) {
+                    module_dependencies.emplace(found->second);
+                }
+            }
+        }
+
+        WarnAboutModuleCycles(dependencies);
+
+        std::filesystem::create_directories(directory / kIncludeDirName);
+
+        for (const auto& [module_name, module_files] : modules) {
+            writer.Enqueue(directory / kIncludeDirName / std::format("{}.hpp", module_name), AssembleHeader(module_files, dependencies[module_name]));
+        }
+    }
+
+    void AssembleModuleUnits(const EmitTarget& target, std::span<const GeneratedFile> files, util::AsyncFileWriter& writer) {
+        if (target.language != source2_gen::Language::cpp_modules) {
+            return;
+        }
+
+        const auto directory = target.directory / "modules";
+        const auto sorted = SortByIncludes(files);
+
+        std::unordered_map<std::filesystem::path, std::string_view> module_of_path{};
+        for (const auto& file : files) {
+            module_of_path.emplace(file.path, file.module);
+        }
+
+        ModuleDependencies dependencies{};
+        // Key is the module of the declared types
+        std::map<std::string_view, std::set<std::string_view>> forward_declarations{};
+
+        for (const auto& file : files) {
+            auto& module_dependencies = dependencies[file.module];
+
+            for (const auto& include : file.includes) {
+                if (const auto found = module_of_path.find(include); (found != module_of_path.end()) && (found->second != file.module)) {
+                    module_dependencies.emplace(found->second);
+                }
+            }
+
+            for (const auto& forward_declaration : file.forward_declarations) {
+                forward_declarations[forward_declaration.module].emplace(forward_declaration.name);
+
+                if (forward_declaration.module != file.module) {
+                    module_dependencies.emplace(forward_declaration.module);
+                }
+            }
+        }
+
+        // Modules whose types are only forward-declared get a unit, too
+        for (const auto& [module_name, _] : forward_declarations) {
+            dependencies[module_name];
+        }
+
+        std::vector<std::string_view> modules{};
+        std::map<std::string_view, std::size_t> index_of_module{};
+
+        for (const auto& [module_name, _] : dependencies) {
+            index_of_module.emplace(module_name, modules.size());
+            modules.emplace_back(module_name);
+        }
+
+        std::vector<std::vector<std::size_t>> edges(modules.size());
+        for (const auto& [module_name, module_dependencies] : dependencies) {
+            for (const auto dependency : module_dependencies) {
+                edges[index_of_module.at(module_name)].emplace_back(index_of_module.at(dependency));
+            }
+        }
+
+        const IncludeGraph graph{std::move(edges)};
+
+        // Modules that depend on each other share the unit of the first one of them. There are only a few dozen modules.
+        std::vector<std::size_t> unit_of_module(modules.size());
+        for (std::size_t i = 0; i < modules.size(); ++i) {
+            unit_of_module[i] = i;
+
+            for (std::size_t j = 0; j < i; ++j) {
+                if (graph.Reaches(i, j) && graph.Reaches(j, i)) {
+                    unit_of_module[i] = j;
+                    break;
+                }
+            }
+        }
+
+        std::filesystem::create_directories(directory);
+
+        for (std::size_t unit = 0; unit < modules.size(); ++unit) {
+            const auto path = directory / std::format("{}.{}.cppm", kModuleNamePrefix, modules[unit]);
+
+            if (unit_of_module[unit] != unit) {
+                const auto owner = modules[unit_of_module[unit]];
+                writer.Enqueue(path,
+                               std::format("export module {0}.{1};\n// {1} is part of an import cycle, its types are in {0}.{2}\nexport import {0}.{2};\n",
+                                           kModuleNamePrefix, modules[unit], owner));
+                continue;
+            }
+
+            std::vector<std::string_view> unit_modules{};
+            std::set<std::string_view> imports{};
+
+            for (std::size_t i = unit; i < modules.size(); ++i) {
+                if (unit_of_module[i] != unit) {
+                    continue;
+                }
+
+                unit_modules.emplace_back(modules[i]);
+
+                for (const auto dependency : dependencies[modules[i]]) {
+                    if (const auto dependency_unit = unit_of_module[index_of_module.at(dependency)]; dependency_unit != unit) {
+                        imports.emplace(modules[dependency_unit]);
+                    }
+                }
+            }
+
+            if (unit_modules.size() > 1) {
+                std::string cycle{};
+                for (const auto module_name : unit_modules) {
+                    cycle += cycle.empty() ? module_name : std::format(", {}", module_name);
+                }
+
+                std::cerr << std::format("{}: warning: modules {} depend on each other, their types are in module {}.{}", __FUNCTION__, cycle,
+                                         kModuleNamePrefix, modules[unit])
+                          << std::endl;
+            }
+
+            std::vector<const GeneratedFile*> unit_files{};
+            for (const auto* file : sorted) {
+                if (unit_of_module[index_of_module.at(file->module)] == unit) {
+                    unit_files.emplace_back(file);
+                }
+            }
+
+            writer.Enqueue(path, AssembleModuleUnit(unit_modules, unit_files, imports, forward_declarations));
+        }
+    }
+} // namespace sdk
+
+// source2gen - Source2 games SDK generator
+// Copyright 2024 neverlosecc
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
@@ -0,0 +1,401 @@
+// Copyright (C) 2024 neverlosecc
+// See end of file for extended copyright information.
+#include "sdk/field_table.h"
+#include <absl/container/flat_hash_map.h>
+#include <absl/container/flat_hash_set.h>
+#include <algorithm>
+#include <bit>
+#include <cstring>
+#include <format>
+#include <iterator>
+#include <numeric>
+#include <optional>
+#include <ranges>
+#include <span>
+#include <tuple>
+
+namespace {
+    /// Give up on a bucket after this many displacements and try again with more slots
+    constexpr std::uint32_t kMaxDisplacement = 1u << 20;
+
+    /// Multiplier of @ref HashPart() and step of @ref sdk::GetFieldSlot(), the 64-bit golden ratio
+    constexpr std::uint64_t kGoldenRatio = 0x9e3779b97f4a7c15;
+
+    /// Separates the parts of a key in @ref sdk::FieldTable::keys
+    constexpr char kKeySeparator = '\0';
+
+    /// Hashes 8 bytes per multiplication, hashing byte by byte took longer than the rest of a lookup. The last word includes the size of
+    /// @p part, so keys hash differently if their parts are split differently.
+    /// Words are little-endian, like on every platform the games run on.
+    [[nodiscard]] std::uint64_t HashPart(std::uint64_t hash, std::string_view part) {
+        std::size_t i = 0;
+
+        for (; (i + 8) <= part.size(); i += 8) {
+            std::uint64_t word{};
+            std::memcpy(&word, part.data() + i, sizeof(word));
+
+            hash = (hash ^ word) * kGoldenRatio;
+            hash ^= hash >> 32;
+        }
+
+        std::uint64_t word = static_cast<std::uint64_t>(part.size()) << 56;
+        for (std::size_t byte = 0; (i + byte) < part.size(); ++byte) {
+            word |= static_cast<std::uint64_t>(static_cast<std::uint8_t>(part[i + byte])) << (byte * 8);
+        }
+
+        hash = (hash ^ word) * kGoldenRatio;
+        hash ^= hash >> 32;
+
+        return hash;
+    }
+
+    /// Finalizer of MurmurHash3. Spreads every bit of the displaced hash over the slot index.
+    [[nodiscard]] std::uint64_t Mix(std::uint64_t value) {
+        value ^= value >> 33;
+        value *= 0xff51afd7ed558ccd;
+        value ^= value >> 33;
+        value *= 0xc4ceb9fe1a85ec53;
+        value ^= value >> 33;
+
+        return value;
+    }
+
+    [[nodiscard]] std::size_t GetBucket(std::uint64_t key_hash, std::size_t bucket_count) {
+        return static_cast<std::size_t>(key_hash >> 32) & (bucket_count - 1);
+    }
+
+    /// @return Whether @p key is "<module>\0<class>\0<field>"
+    [[nodiscard]] bool IsKey(std::string_view key, std::string_view module, std::string_view class_name, std::string_view field_name) {
+        return (key.size() == (module.size() + class_name.size() + field_name.size() + 2)) && key.starts_with(module) &&
+               (key[module.size()] == kKeySeparator) && (key.substr(module.size() + 1, class_name.size()) == class_name) &&
+               (key[module.size() + class_name.size() + 1] == kKeySeparator) && key.ends_with(field_name);
+    }
+
+    /// Places all @p keys, largest bucket first, because small buckets are easier to fit into the remaining slots
+    /// @return @ref std::nullopt if a bucket doesn't fit with any displacement
+    [[nodiscard]] std::optional<sdk::FieldTable> PlaceKeys(std::span<const sdk::FieldTableSlot> keys, std::size_t bucket_count,
+                                                           std::size_t slot_count) {
+        std::vector<std::vector<const sdk::FieldTableSlot*>> buckets(bucket_count);
+
+        for (const auto& key : keys) {
+            buckets[GetBucket(key.key_hash, bucket_count)].emplace_back(&key);
+        }
+
+        std::vector<std::size_t> order(bucket_count);
+        std::iota(order.begin(), order.end(), std::size_t{0});
+        std::ranges::stable_sort(order, std::ranges::greater{}, [&](std::size_t i) { return buckets[i].size(); });
+
+        sdk::FieldTable result{
+            .displacements = std::vector<std::uint32_t>(bucket_count),
+            .slots = std::vector<sdk::FieldTableSlot>(slot_count),
+        };
+        std::vector<bool> used(slot_count);
+        std::vector<std::size_t> positions{};
+
+        for (const auto bucket : order) {
+            if (buckets[bucket].empty()) {
+                break;
+            }
+
+            std::uint32_t displacement = 0;
+
+            for (; displacement < kMaxDisplacement; ++displacement) {
+                positions.clear();
+
+                const bool fits = std::ranges::all_of(buckets[bucket], [&](const sdk::FieldTableSlot* key) {
+                    const auto position = sdk::GetFieldSlot(key->key_hash, displacement, slot_count - 1);
+
+                    if (used[position] || (std::ranges::find(positions, position) != positions.end())) {
+                        return false;
+                    }
+
+                    positions.emplace_back(position);
+                    return true;
+                });
+
+                if (fits) {
+                    break;
+                }
+            }
+
+            if (displacement == kMaxDisplacement) {
+                return std::nullopt;
+            }
+
+            result.displacements[bucket] = displacement;
+
+            for (std::size_t i = 0; i < positions.size(); ++i) {
+                used[positions[i]] = true;
+                result.slots[positions[i]] = *buckets[bucket][i];
+            }
+        }
+
+        return result;
+    }
+
+    /// Escapes @p value for a string literal. Schema names don't contain quotes or backslashes, but nothing guarantees it.
+    [[nodiscard]] std::string EscapeStringLiteral(std::string_view value) {
+        std::string result{};
+        result.reserve(value.size());
+
+        for (const auto c : value) {
+            if ((c == '"') || (c == '\\')) {
+                result += '\\';
+            }
+
+            result += c;
+        }
+
+        return result;
+    }
+
+    /// Hash and lookup of the generated header. Must match @ref HashPart(), @ref sdk::GetFieldSlot(), and @ref IsKey().
+    constexpr std::string_view kFieldTableRuntime = R"(    namespace detail {
+        [[nodiscard]] constexpr std::uint64_t HashPart(std::uint64_t hash, std::string_view part) {
+            std::size_t i = 0;
+
+            for (; (i + 8) <= part.size(); i += 8) {
+                std::uint64_t word = 0;
+
+                if (std::is_constant_evaluated()) {
+                    for (std::size_t byte = 0; byte < 8; ++byte) {
+                        word |= static_cast<std::uint64_t>(static_cast<std::uint8_t>(part[i + byte])) << (byte * 8);
+                    }
+                } else {
+                    // Little-endian, like every platform the games run on
+                    std::memcpy(&word, part.data() + i, sizeof(word));
+                }
+
+                hash = (hash ^ word) * 0x9e3779b97f4a7c15ull;
+                hash ^= hash >> 32;
+            }
+
+            std::uint64_t word = static_cast<std::uint64_t>(part.size()) << 56;
+            for (std::size_t byte = 0; (i + byte) < part.size(); ++byte) {
+                word |= static_cast<std::uint64_t>(static_cast<std::uint8_t>(part[i + byte])) << (byte * 8);
+            }
+
+            hash = (hash ^ word) * 0x9e3779b97f4a7c15ull;
+            hash ^= hash >> 32;
+            return hash;
+        }
+
+        [[nodiscard]] constexpr std::size_t GetSlot(std::uint64_t key_hash, std::uint32_t displacement) {
+            auto value = key_hash + (displacement * 0x9e3779b97f4a7c15ull);
+            value ^= value >> 33;
+            value *= 0xff51afd7ed558ccdull;
+            value ^= value >> 33;
+            value *= 0xc4ceb9fe1a85ec53ull;
+            value ^= value >> 33;
+            return static_cast<std::size_t>(value & kSlotMask);
+        }
+    } // namespace detail
+
+    /// Doesn't allocate, can be evaluated at compile time
+    /// @return nullptr if @p class_name of @p module has no field named @p field_name. Fields of base classes are only found in their own class.
+    [[nodiscard]] constexpr const Field* Find(std::string_view module, std::string_view class_name, std::string_view field_name) {
+        const auto key_hash = detail::HashPart(detail::HashPart(detail::HashPart(0, module), class_name), field_name);
+        const auto displacement = detail::kDisplacements[static_cast<std::size_t>(key_hash >> 32) & kBucketMask];
+        const auto& slot = detail::kSlots[detail::GetSlot(key_hash, displacement)];
+        const auto key = slot.key;
+
+        if ((slot.key_hash == key_hash) && (key.size() == (module.size() + class_name.size() + field_name.size() + 2)) &&
+            (key.substr(0, module.size()) == module) && (key[module.size()] == '\0') &&
+            (key.substr(module.size() + 1, class_name.size()) == class_name) && (key[module.size() + class_name.size() + 1] == '\0') &&
+            (key.substr(key.size() - field_name.size()) == field_name)) {
+            return &slot.field;
+        } else {
+            return nullptr;
+        }
+    }
+)";
+} // namespace
+
+namespace sdk {
+    const FieldInfo* FieldTable::Find(std::string_view module, std::string_view class_name, std::string_view field_name) const {
+        const auto key_hash = HashFieldKey(module, class_name, field_name);
+        const auto& slot = slots[GetFieldSlot(key_hash, displacements[GetBucket(key_hash, displacements.size())], slots.size() - 1)];
+
+        // Comparing the hash first skips the key, which is in another cache line, for most unknown fields
+        if ((slot.key_hash == key_hash) && IsKey(std::string_view{keys}.substr(slot.key_offset, slot.key_size), module, class_name, field_name)) {
+            return &slot.field;
+        } else {
+            return nullptr;
+        }
+    }
+
+    std::uint64_t HashFieldKey(std::string_view module, std::string_view class_name, std::string_view field_name) {
+        return HashPart(HashPart(HashPart(0, module), class_name), field_name);
+    }
+
+    std::size_t GetFieldSlot(std::uint64_t key_hash, std::uint32_t displacement, std::uint64_t slot_mask) {
+        return static_cast<std::size_t>(Mix(key_hash + (displacement * kGoldenRatio)) & slot_mask);
+    }
+
+    FieldTable BuildFieldTable(const snapshot::Snapshot& schema) {
+        std::vector<FieldTableSlot> slots{};
+        std::string keys{};
+        absl::flat_hash_set<std::tuple<std::string_view, std::string_view, std::string_view>> known_keys{};
+
+        // The order of classes and types in a snapshot is no part of the schema. Number types and walk classes in name order, so the type
+        // ids and the table only change if the schema does.
+        std::vector<std::string_view> sorted_type_names{};
+        for (const auto& [module_name, module] : schema.modules) {
+            for (const auto class_index : module.classes) {
+                for (const auto& field : schema.classes[class_index].fields) {
+                    sorted_type_names.emplace_back(schema.types[field.type].name);
+                }
+            }
+        }
+        std::ranges::sort(sorted_type_names);
+        const auto duplicates = std::ranges::unique(sorted_type_names);
+        sorted_type_names.erase(duplicates.begin(), duplicates.end());
+
+        absl::flat_hash_map<std::string_view, std::uint32_t> type_ids{};
+        std::vector<std::string> type_names{};
+        type_names.reserve(sorted_type_names.size());
+        for (const auto type_name : sorted_type_names) {
+            type_ids.emplace(type_name, static_cast<std::uint32_t>(type_names.size()));
+            type_names.emplace_back(type_name);
+        }
+
+        for (const auto& [module_name, module] : schema.modules) {
+            auto class_indices = module.classes;
+            std::ranges::stable_sort(class_indices, {}, [&schema](snapshot::Index i) -> std::string_view { return schema.classes[i].name; });
+
+            for (const auto class_index : class_indices) {
+                const auto& class_ = schema.classes[class_index];
+
+                for (const auto& field : class_.fields) {
+                    if (!known_keys.emplace(module_name, class_.name, field.name).second) {
+                        continue;
+                    }
+
+                    const auto& type = schema.types[field.type];
+
+                    const auto key_offset = keys.size();
+                    keys.append(module_name).append(1, kKeySeparator).append(class_.name).append(1, kKeySeparator).append(field.name);
+
+                    slots.emplace_back(FieldTableSlot{
+                        .key_hash = HashFieldKey(module_name, class_.name, field.name),
+                        .key_offset = static_cast<std::uint32_t>(key_offset),
+                        .key_size = static_cast<std::uint32_t>(keys.size() - key_offset),
+                        .field = FieldInfo{.offset = static_cast<std::uint32_t>(field.offset),
+                                           .size = static_cast<std::uint32_t>(type.size.value_or(0)),
+                                           .type_id = type_ids.at(type.name)},
+                    });
+                }
+            }
+        }
+
+        // About 4 keys per bucket and a load factor of at most 0.8. Most buckets fit with a handful of displacements.
+        const auto bucket_count = std::bit_ceil(std::max<std::size_t>(slots.size() / 4, 1));
+        auto slot_count = std::bit_ceil(slots.size() + (slots.size() / 4) + 1);
+
+        while (true) {
+            if (auto result = PlaceKeys(slots, bucket_count, slot_count); result.has_value()) {
+                result->keys = std::move(keys);
+                result->type_names = std::move(type_names);
+                return std::move(result.value());
+            }
+
+            slot_count *= 2;
+        }
+    }
+
+    std::string EmitFieldTable(const FieldTable& table) {
+        std::string result{};
+        auto out = std::back_inserter(result);
+
+        std::format_to(out, "#pragma once\n\n"
+                            "#include <array>\n"
+                            "#include <cstddef>\n"
+                            "#include <cstdint>\n"
+                            "#include <cstring>\n"
+                            "#include <string_view>\n"
+                            "#include <type_traits>\n\n"
+                            "// Perfect hash table of all fields, built by source2gen\n"
+                            "namespace source2sdk::field_table {{\n"
+                            "    struct Field {{\n"
+                            "        /// Relative to the class that declares the field\n"
+                            "        std::uint32_t offset;\n"
+                            "        /// 0 if the game doesn't know the size of the field's type\n"
+                            "        std::uint32_t size;\n"
+                            "        /// Index into kTypeNames\n"
+                            "        std::uint32_t type_id;\n"
+                            "    }};\n\n");
+
+        std::format_to(out, "    inline constexpr std::array<std::string_view, {}> kTypeNames{{{{\n", table.type_names.size());
+        for (const auto& type_name : table.type_names) {
+            std::format_to(out, "        \"{}\",\n", EscapeStringLiteral(type_name));
+        }
+        std::format_to(out, "    }}}};\n\n");
+
+        std::format_to(out, "    inline constexpr std::size_t kBucketMask = {:#x};\n", table.displacements.size() - 1);
+        std::format_to(out, "    inline constexpr std::uint64_t kSlotMask = {:#x};\n\n", table.slots.size() - 1);
+
+        std::format_to(out, "    namespace detail {{\n"
+                            "        struct Slot {{\n"
+                            "            std::uint64_t key_hash;\n"
+                            "            /// \"<module>\\0<class>\\0<field>\", empty for unused slots\n"
+                            "            std::string_view key;\n"
+                            "            Field field;\n"
+                            "        }};\n\n");
+
+        std::format_to(out, "        inline constexpr std::uint32_t kDisplacements[] = {{");
+        for (std::size_t i = 0; i < table.displacements.size(); ++i) {
+            std::format_to(out, "{}{},", ((i % 16) == 0) ? "\n            " : " ", table.displacements[i]);
+        }
+        std::format_to(out, "\n        }};\n\n");
+
+        std::format_to(out, "        inline constexpr Slot kSlots[] = {{\n");
+        for (const auto& slot : table.slots) {
+            if (slot.key_size == 0) {
+                std::format_to(out, "            {{}},\n");
+                continue;
+            }
+
+            // Adjacent literals, so the separator's escape sequence doesn't swallow the characters that follow it
+            std::string key{};
+            for (const auto part : std::string_view{table.keys}.substr(slot.key_offset, slot.key_size) | std::views::split(kKeySeparator)) {
+                key += key.empty() ? "\"" : R"(" "\0" ")";
+                key += EscapeStringLiteral(std::string_view{part.begin(), part.end()});
+            }
+            key += '"';
+
+            std::format_to(out, "            {{{:#x}, std::string_view{{{}, {}}}, {{{:#x}, {:#x}, {}}}}},\n", slot.key_hash, key, slot.key_size,
+                           slot.field.offset, slot.field.size, slot.field.type_id);
+        }
+        std::format_to(out, "        }};\n"
+                            "    }} // namespace detail\n\n");
+
+        result += kFieldTableRuntime;
+        result += "} // namespace source2sdk::field_table\n";
+
+        return result;
+    }
+
+    void WriteFieldTable(const EmitTarget& target, const FieldTable& table, util::AsyncFileWriter& writer) {
+        if (!target.field_table) {
+            return;
+        }
+
+        writer.Enqueue(target.directory / "include" / "source2sdk" / "field_table.hpp", EmitFieldTable(table));
+    }
+} // namespace sdk
+
+// source2gen - Source2 games SDK generator
+// Copyright 2024 neverlosecc
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
@@ -0,0 +1,198 @@
+// Copyright (C) 2024 neverlosecc
+// See end of file for extended copyright information.
+#include "sdk/include_graph.h"
+#include <algorithm>
+#include <bit>
+#include <cerrno>
+#include <cstring>
+#include <format>
+#include <fstream>
+#include <iostream>
+#include <limits>
+#include <numeric>
+#include <utility>
+
+namespace {
+    constexpr std::size_t kBitsPerWord = 64;
+    constexpr std::string_view kReportHeader = "module\ttype\tincludes before\tincludes after\tclosure before\tclosure after";
+
+    void SetBit(std::vector<std::uint64_t>& bits, std::size_t index) {
+        bits[index / kBitsPerWord] |= (std::uint64_t{1} << (index % kBitsPerWord));
+    }
+
+    [[nodiscard]] bool TestBit(const std::vector<std::uint64_t>& bits, std::size_t index) {
+        return (bits[index / kBitsPerWord] & (std::uint64_t{1} << (index % kBitsPerWord))) != 0;
+    }
+} // namespace
+
+namespace sdk {
+    IncludeGraph::IncludeGraph(std::vector<std::vector<std::size_t>> includes) : _includes(std::move(includes)) {
+        // Tarjan's algorithm, iterative because include chains can be deeper than the stack.
+        // Components are completed after all components they reach, so the closures of their includes are known by then.
+        constexpr auto kUnvisited = std::numeric_limits<std::size_t>::max();
+
+        const auto node_count = _includes.size();
+        const auto word_count = (node_count + kBitsPerWord - 1) / kBitsPerWord;
+
+        std::vector<std::size_t> indices(node_count, kUnvisited);
+        std::vector<std::size_t> low_links(node_count);
+        std::vector<bool> on_stack(node_count);
+        std::vector<std::size_t> stack{};
+        std::vector<std::size_t> members{};
+        // Node and the index of its next include to visit
+        std::vector<std::pair<std::size_t, std::size_t>> call_stack{};
+        std::size_t next_index = 0;
+
+        _components.assign(node_count, kUnvisited);
+
+        const auto enter = [&](std::size_t node) {
+            indices[node] = low_links[node] = next_index++;
+            stack.emplace_back(node);
+            on_stack[node] = true;
+            call_stack.emplace_back(node, 0);
+        };
+
+        for (std::size_t root = 0; root < node_count; ++root) {
+            if (indices[root] != kUnvisited) {
+                continue;
+            }
+
+            enter(root);
+
+            while (!call_stack.empty()) {
+                const auto node = call_stack.back().first;
+
+                if (auto& next_include = call_stack.back().second; next_include < _includes[node].size()) {
+                    const auto include = _includes[node][next_include++];
+
+                    if (indices[include] == kUnvisited) {
+                        enter(include);
+                    } else if (on_stack[include]) {
+                        low_links[node] = std::min(low_links[node], indices[include]);
+                    }
+
+                    continue;
+                }
+
+                call_stack.pop_back();
+
+                if (!call_stack.empty()) {
+                    const auto parent = call_stack.back().first;
+                    low_links[parent] = std::min(low_links[parent], low_links[node]);
+                }
+
+                if (low_links[node] != indices[node]) {
+                    continue;
+                }
+
+                // node is the root of a component
+                const auto component = _closures.size();
+                auto& closure = _closures.emplace_back(word_count);
+
+                members.clear();
+                do {
+                    members.emplace_back(stack.back());
+                    stack.pop_back();
+                    on_stack[members.back()] = false;
+                    _components[members.back()] = component;
+                } while (members.back() != node);
+
+                bool is_cycle = (members.size() > 1);
+
+                for (const auto member : members) {
+                    for (const auto include : _includes[member]) {
+                        if (_components[include] == component) {
+                            is_cycle = true;
+                            continue;
+                        }
+
+                        SetBit(closure, include);
+
+                        const auto& included_closure = _closures[_components[include]];
+                        for (std::size_t word = 0; word < word_count; ++word) {
+                            closure[word] |= included_closure[word];
+                        }
+                    }
+                }
+
+                if (is_cycle) {
+                    for (const auto member : members) {
+                        SetBit(closure, member);
+                    }
+                }
+            }
+        }
+    }
+
+    std::span<const std::size_t> IncludeGraph::GetIncludes(std::size_t node) const {
+        return _includes[node];
+    }
+
+    bool IncludeGraph::Reaches(std::size_t from, std::size_t to) const {
+        return TestBit(_closures[_components[from]], to);
+    }
+
+    std::size_t IncludeGraph::GetClosureSize(std::size_t node) const {
+        const auto& closure = _closures[_components[node]];
+        return std::accumulate(closure.begin(), closure.end(), std::size_t{0},
+                               [](std::size_t sum, std::uint64_t word) { return sum + static_cast<std::size_t>(std::popcount(word)); });
+    }
+
+    std::vector<std::size_t> IncludeGraph::GetMinimalIncludes(std::size_t node) const {
+        const auto& includes = _includes[node];
+        std::vector<std::size_t> result{};
+
+        for (const auto include : includes) {
+            if ((include == node) || (std::ranges::find(result, include) != result.end())) {
+                continue;
+            }
+
+            const auto is_included_by = [&](std::size_t other) {
+                return (other != include) && (other != node) && Reaches(other, include) && !Reaches(include, other);
+            };
+
+            if (std::ranges::none_of(includes, is_included_by)) {
+                result.emplace_back(include);
+            }
+        }
+
+        return result;
+    }
+
+    bool SaveIncludeReport(const std::filesystem::path& path, std::span<const IncludeReportEntry> entries) {
+        if (path.has_parent_path()) {
+            std::filesystem::create_directories(path.parent_path());
+        }
+
+        std::ofstream f(path, std::ios::out | std::ios::trunc);
+        f << kReportHeader << '\n';
+
+        for (const auto& entry : entries) {
+            f << entry.type.module << '\t' << entry.type.name << '\t' << entry.includes_before << '\t' << entry.includes_after << '\t'
+              << entry.closure_before << '\t' << entry.closure_after << '\n';
+        }
+
+        if (!f.good()) {
+            std::cerr << std::format("{}: Could not write to {}: {}", __FUNCTION__, path.string(), std::strerror(errno)) << std::endl;
+            return false;
+        }
+
+        return true;
+    }
+} // namespace sdk
+
+// source2gen - Source2 games SDK generator
+// Copyright 2024 neverlosecc
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
@@ -0,0 +1,240 @@
+// Copyright (C) 2024 neverlosecc
+// See end of file for extended copyright information.
+#include "sdk/json_export.h"
+#include "tools/field_parser.h"
+#include "tools/json_writer.h"
+#include <algorithm>
+#include <fstream>
+#include <iostream>
+#include <span>
+#include <string_view>
+#include <vector>
+
+namespace {
+    using namespace sdk;
+
+    /// `{"name": ..., "value": ...}`, the value is `null` if the entry has none
+    void WriteMetadata(util::JsonWriter& json, std::span<const snapshot::Metadata> metadata) {
+        json.BeginArray();
+
+        for (const auto& entry : metadata) {
+            json.BeginObject();
+            json.Key("name");
+            json.String(entry.name);
+            json.Key("value");
+            if (entry.value.empty()) {
+                json.Null();
+            } else {
+                json.String(entry.value);
+            }
+            json.EndObject();
+        }
+
+        json.EndArray();
+    }
+
+    template <typename T>
+    void WriteOptional(util::JsonWriter& json, const std::optional<T>& value) {
+        if (value.has_value()) {
+            json.Number(value.value());
+        } else {
+            json.Null();
+        }
+    }
+
+    void WriteEnum(util::JsonWriter& json, const snapshot::Enum& enum_) {
+        json.BeginObject();
+        json.Key("name");
+        json.String(enum_.name);
+        json.Key("size");
+        json.Number(enum_.size);
+        json.Key("alignment");
+        json.Number(enum_.alignment);
+        json.Key("metadata");
+        WriteMetadata(json, enum_.static_metadata);
+
+        json.Key("enumerators");
+        json.BeginArray();
+        for (const auto& enumerator : enum_.enumerators) {
+            json.BeginObject();
+            json.Key("name");
+            json.String(enumerator.name);
+            json.Key("value");
+            json.Number(enumerator.value);
+            json.Key("metadata");
+            WriteMetadata(json, enumerator.metadata);
+            json.EndObject();
+        }
+        json.EndArray();
+
+        json.EndObject();
+    }
+
+    void WriteClass(util::JsonWriter& json, const snapshot::Snapshot& schema, const snapshot::Class& class_) {
+        json.BeginObject();
+        json.Key("name");
+        json.String(class_.name);
+        json.Key("size");
+        json.Number(class_.size);
+        json.Key("alignment");
+        WriteOptional(json, class_.registered_alignment);
+        json.Key("flags");
+        json.Number(class_.flags);
+
+        json.Key("base_class");
+        if (class_.base_class != snapshot::kNone) {
+            const auto& base = schema.classes[class_.base_class];
+            json.BeginObject();
+            json.Key("module");
+            json.String(base.module);
+            json.Key("name");
+            json.String(base.name);
+            json.EndObject();
+        } else {
+            json.Null();
+        }
+
+        json.Key("metadata");
+        WriteMetadata(json, class_.static_metadata);
+
+        json.Key("fields");
+        json.BeginArray();
+        for (const auto& field : class_.fields) {
+            const auto& type = schema.types[field.type];
+
+            json.BeginObject();
+            json.Key("name");
+            json.String(field.name);
+            json.Key("type");
+            json.String(type.name);
+            json.Key("offset");
+            json.Number(field.offset);
+            json.Key("size");
+            WriteOptional(json, type.size);
+            json.Key("alignment");
+            WriteOptional(json, type.alignment);
+            json.Key("metadata");
+            WriteMetadata(json, field.metadata);
+            json.EndObject();
+        }
+        json.EndArray();
+
+        json.Key("static_fields");
+        json.BeginArray();
+        for (const auto& field : class_.static_fields) {
+            json.BeginObject();
+            json.Key("name");
+            json.String(field.name);
+            json.Key("type");
+            json.String(schema.types[field.type].name);
+            json.Key("metadata");
+            WriteMetadata(json, field.metadata);
+            json.EndObject();
+        }
+        json.EndArray();
+
+        json.Key("datamap");
+        json.BeginArray();
+        for (const auto& field : class_.datamap) {
+            const auto info = field_parser::parse(field.type, field.name, field.size);
+
+            json.BeginObject();
+            json.Key("name");
+            json.String(field.name);
+            json.Key("type");
+            json.String((field.type == fieldtype_t::FIELD_EMBEDDED) ? std::string_view{field.embedded_class} : std::string_view{info.m_type});
+            json.Key("field_type");
+            json.Number(static_cast<std::underlying_type_t<fieldtype_t>>(field.type));
+            json.Key("offset");
+            json.Number(field.offset);
+            json.Key("count");
+            json.Number(field.size);
+            json.EndObject();
+        }
+        json.EndArray();
+
+        json.EndObject();
+    }
+
+    /// The order of types in a snapshot can change between two captures of the same game build, the export doesn't depend on it
+    /// @return @p indices sorted by the names of the types in @p types
+    template <typename T>
+    [[nodiscard]] std::vector<sdk::snapshot::Index> SortByName(std::vector<sdk::snapshot::Index> indices, const std::vector<T>& types) {
+        std::ranges::stable_sort(indices, {}, [&types](sdk::snapshot::Index i) -> std::string_view { return types[i].name; });
+        return indices;
+    }
+} // namespace
+
+namespace sdk {
+    void ExportJson(const snapshot::Snapshot& schema, std::ostream& out) {
+        util::JsonWriter json{out};
+
+        json.BeginObject();
+        json.Key("game");
+        json.String(schema.game);
+
+        json.Key("modules");
+        json.BeginArray();
+        for (const auto& [module_name, module] : schema.modules) {
+            json.BeginObject();
+            json.Key("name");
+            json.String(module_name);
+
+            json.Key("enums");
+            json.BeginArray();
+            for (const auto index : SortByName(module.enums, schema.enums)) {
+                WriteEnum(json, schema.enums[index]);
+            }
+            json.EndArray();
+
+            json.Key("classes");
+            json.BeginArray();
+            for (const auto index : SortByName(module.classes, schema.classes)) {
+                WriteClass(json, schema, schema.classes[index]);
+            }
+            json.EndArray();
+
+            json.EndObject();
+        }
+        json.EndArray();
+
+        json.EndObject();
+    }
+
+    bool WriteJsonSchema(const EmitTarget& target, const snapshot::Snapshot& schema) {
+        if (target.language != source2_gen::Language::json) {
+            return true;
+        }
+
+        const auto path = target.directory / "schema.json";
+        std::ofstream file{path, std::ios::binary};
+
+        if (file.good()) {
+            ExportJson(schema, file);
+            file.close();
+        }
+
+        if (!file.good()) {
+            std::cerr << std::format("{}: Could not write to {}", __FUNCTION__, path.string()) << std::endl;
+            return false;
+        }
+
+        return true;
+    }
+} // namespace sdk
+
+// source2gen - Source2 games SDK generator
+// Copyright 2024 neverlosecc
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
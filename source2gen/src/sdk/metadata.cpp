@@ -0,0 +1,242 @@
+// Copyright (C) 2024 neverlosecc
+// See end of file for extended copyright information.
+#include "sdk/metadata.h"
+#include "tools/fnv.h"
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <format>
+#include <span>
+
+namespace {
+    constexpr std::array string_metadata_entries = {
+        FNV32("MCellForDomain"),
+        FNV32("MCustomFGDMetadata"),
+        FNV32("MFieldVerificationName"),
+        FNV32("MKV3TransferName"),
+        FNV32("MNetworkAlias"),
+        FNV32("MNetworkChangeCallback"),
+        FNV32("MNetworkEncoder"),
+        FNV32("MNetworkExcludeByName"),
+        FNV32("MNetworkExcludeByUserGroup"),
+        FNV32("MNetworkIncludeByName"),
+        FNV32("MNetworkIncludeByUserGroup"),
+        FNV32("MNetworkReplayCompatField"),
+        FNV32("MNetworkSerializer"),
+        FNV32("MNetworkTypeAlias"),
+        FNV32("MNetworkUserGroup"),
+        FNV32("MNetworkUserGroupProxy"),
+        FNV32("MParticleReplacementOp"),
+        FNV32("MPropertyArrayElementNameKey"),
+        FNV32("MPropertyAttributeChoiceName"),
+        FNV32("MPropertyAttributeEditor"),
+        FNV32("MPropertyAttributeRange"),
+        FNV32("MPropertyAttributeSuggestionName"),
+        FNV32("MPropertyCustomEditor"),
+        FNV32("MPropertyCustomFGDType"),
+        FNV32("MPropertyDescription"),
+        FNV32("MPropertyDescription"),
+        FNV32("MPropertyExtendedEditor"),
+        FNV32("MPropertyFriendlyName"),
+        FNV32("MPropertyFriendlyName"),
+        FNV32("MPropertyGroupName"),
+        FNV32("MPropertyIconName"),
+        FNV32("MPropertyStartGroup"),
+        FNV32("MPropertySuppressExpr"),
+        FNV32("MPulseCellOutflowHookInfo"),
+        FNV32("MPulseEditorHeaderIcon"),
+#if !defined(DEADLOCK) && !defined(DOTA2)
+        FNV32("MPulseProvideFeatureTag"),
+#endif
+        FNV32("MResourceBlockType"),
+        FNV32("MScriptDescription"),
+        FNV32("MSrc1ImportAttributeName"),
+        FNV32("MSrc1ImportDmElementType"),
+        FNV32("MVDataOutlinerIcon"),
+        FNV32("MVDataOutlinerIconExpr"),
+        FNV32("MVDataUniqueMonotonicInt"),
+        FNV32("MVectorIsSometimesCoordinate"),
+    };
+
+    constexpr std::array string_class_metadata_entries = {
+        FNV32("MResourceTypeForInfoType"),
+        FNV32("MDiskDataForResourceType"),
+    };
+
+    constexpr std::array var_name_string_class_metadata_entries = {
+        FNV32("MNetworkVarNames"), FNV32("MNetworkOverride"), FNV32("MNetworkVarTypeOverride"), FNV32("MScriptDescription"), FNV32("MParticleDomainTag"),
+    };
+
+    constexpr std::array integer_metadata_entries = {
+        FNV32("MNetworkVarEmbeddedFieldOffsetDelta"),
+        FNV32("MNetworkBitCount"),
+        FNV32("MNetworkPriority"),
+        FNV32("MParticleOperatorType"),
+        FNV32("MPropertySortPriority"),
+        FNV32("MParticleMinVersion"),
+        FNV32("MParticleMaxVersion"),
+#if defined(DEADLOCK) || defined(DOTA2)
+        FNV32("MPulseProvideFeatureTag"),
+#endif
+        FNV32("MNetworkEncodeFlags"),
+        FNV32("MResourceVersion"),
+        FNV32("MVDataNodeType"),
+        FNV32("MVDataOverlayType"),
+        FNV32("MAlignment"),
+        FNV32("MGenerateArrayKeynamesFirstIndex"),
+    };
+
+    constexpr std::array float_metadata_entries = {
+        FNV32("MNetworkMinValue"),
+        FNV32("MNetworkMaxValue"),
+    };
+
+    using sdk::MetadataValueKind;
+
+    struct MetadataSlot {
+        fnv32::hash name_hash{};
+        MetadataValueKind kind{MetadataValueKind::unknown};
+    };
+
+    /// All entries of the tables above. Names that are listed in more than one table keep the kind of the table that comes first.
+    constexpr auto metadata_entries = []() {
+        std::array<MetadataSlot, var_name_string_class_metadata_entries.size() + string_class_metadata_entries.size() +
+                                     string_metadata_entries.size() + integer_metadata_entries.size() + float_metadata_entries.size()>
+            result{};
+        auto it = result.begin();
+
+        const auto append = [&it](std::span<const fnv32::hash> hashes, MetadataValueKind kind) {
+            for (const auto hash : hashes) {
+                *it++ = MetadataSlot{.name_hash = hash, .kind = kind};
+            }
+        };
+
+        append(var_name_string_class_metadata_entries, MetadataValueKind::var_name);
+        append(string_class_metadata_entries, MetadataValueKind::inline_string);
+        append(string_metadata_entries, MetadataValueKind::string);
+        append(integer_metadata_entries, MetadataValueKind::integer);
+        append(float_metadata_entries, MetadataValueKind::floating_point);
+
+        return result;
+    }();
+
+    /// Perfect hash table, every name hash maps to its own slot. The slot is selected by the upper bits of `name_hash * seed`.
+    template <std::size_t Size>
+    struct MetadataTable {
+        static_assert(std::has_single_bit(Size));
+        static constexpr int kShift = 32 - std::countr_zero(Size);
+
+        /// 0 if no seed has been found
+        fnv32::hash seed{};
+        std::array<MetadataSlot, Size> slots{};
+
+        [[nodiscard]] static constexpr std::size_t GetSlotIndex(fnv32::hash name_hash, fnv32::hash seed) {
+            return static_cast<std::size_t>(static_cast<fnv32::hash>(name_hash * seed) >> kShift);
+        }
+
+        [[nodiscard]] constexpr MetadataValueKind Find(fnv32::hash name_hash) const {
+            const auto& slot = slots[GetSlotIndex(name_hash, seed)];
+            return (slot.name_hash == name_hash) ? slot.kind : MetadataValueKind::unknown;
+        }
+    };
+
+    /// Tries odd seeds until one maps every entry to its own slot
+    template <std::size_t Size>
+    consteval MetadataTable<Size> BuildMetadataTable(std::span<const MetadataSlot> entries) {
+        constexpr fnv32::hash max_seed = 8192;
+
+        for (fnv32::hash seed = 1; seed < max_seed; seed += 2) {
+            MetadataTable<Size> table{.seed = seed};
+            bool has_collision = false;
+
+            for (const auto& entry : entries) {
+                auto& slot = table.slots[MetadataTable<Size>::GetSlotIndex(entry.name_hash, seed)];
+
+                if (slot.kind == MetadataValueKind::unknown) {
+                    slot = entry;
+                } else if (slot.name_hash != entry.name_hash) {
+                    has_collision = true;
+                    break;
+                }
+            }
+
+            if (!has_collision) {
+                return table;
+            }
+        }
+
+        return MetadataTable<Size>{};
+    }
+
+    /// 4 slots per entry keep the number of seeds that have to be tried low
+    constexpr auto metadata_table = BuildMetadataTable<std::bit_ceil(metadata_entries.size()) * 4>(metadata_entries);
+    static_assert(metadata_table.seed != 0, "no perfect hash has been found for the metadata entries, increase the table size");
+} // namespace
+
+namespace sdk {
+    MetadataValueKind GetMetadataValueKind(std::string_view name) {
+        return metadata_table.Find(fnv32::hash_bytes(name));
+    }
+
+    std::string GetMetadataValue(const SchemaMetadataEntryData_t& metadata_entry) {
+        std::string value;
+
+        switch (GetMetadataValueKind(metadata_entry.m_szName)) {
+        case MetadataValueKind::var_name: {
+            const auto& var_value = metadata_entry.m_pNetworkValue->m_VarValue;
+            const auto check_ptr = [](const char* ptr) -> bool {
+                /// @note: hotfix for the deadlock 14/09/24 update,
+                ///     where they filled some ptrs with -1 instead of nullptr
+                return ptr != nullptr && ptr != reinterpret_cast<const char*>(-1);
+            };
+
+            if (check_ptr(var_value.m_pszType) && check_ptr(var_value.m_pszName))
+                value = std::format("{} {}", var_value.m_pszType, var_value.m_pszName);
+            else if (check_ptr(var_value.m_pszName) && !check_ptr(var_value.m_pszType))
+                value = var_value.m_pszName;
+            else if (!check_ptr(var_value.m_pszName) && check_ptr(var_value.m_pszType))
+                value = var_value.m_pszType;
+            break;
+        }
+        case MetadataValueKind::inline_string: {
+            /// Explicitly convert to std::string with the size as the string may not end with a nullterm
+            /// But if this string does contain a null terminator, we should properly handle this too
+            const auto& szValue = metadata_entry.m_pNetworkValue->m_szValue;
+            const auto null_pos = std::find(szValue.begin(), szValue.end(), 0x00);
+            const auto size = null_pos != szValue.end() ? std::distance(szValue.begin(), null_pos) : szValue.size();
+
+            value = std::string(metadata_entry.m_pNetworkValue->m_szValue.data(), size);
+            break;
+        }
+        case MetadataValueKind::string:
+            value = metadata_entry.m_pNetworkValue->m_pszValue;
+            break;
+        case MetadataValueKind::integer:
+            value = std::to_string(metadata_entry.m_pNetworkValue->m_nValue);
+            break;
+        case MetadataValueKind::floating_point:
+            value = std::to_string(metadata_entry.m_pNetworkValue->m_fValue);
+            break;
+        case MetadataValueKind::unknown:
+            break;
+        }
+
+        return value;
+    }
+} // namespace sdk
+
+// source2gen - Source2 games SDK generator
+// Copyright 2024 neverlosecc
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
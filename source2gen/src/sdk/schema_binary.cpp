@@ -0,0 +1,254 @@
+// Copyright (C) 2024 neverlosecc
+// See end of file for extended copyright information.
+#include "sdk/schema_binary.h"
+#include <absl/container/flat_hash_map.h>
+#include <algorithm>
+#include <cstring>
+#include <limits>
+#include <source2sdk/schema_view.hpp>
+#include <span>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+
+namespace {
+    namespace format = source2sdk::schema::format;
+
+    /// Collects the records of all tables before they are laid out
+    class SchemaBinaryBuilder {
+    public:
+        explicit SchemaBinaryBuilder(const sdk::snapshot::Snapshot& schema) : _schema(schema) { }
+
+        [[nodiscard]] std::string Build() {
+            for (const auto& [module_name, module] : _schema.modules) {
+                AddModule(module_name, module);
+            }
+
+            ResolveBaseClasses();
+
+            const auto class_index = BuildNameIndex<format::Class>(_classes);
+            const auto enum_index = BuildNameIndex<format::Enum>(_enums);
+
+            format::Header header{};
+            std::memcpy(header.magic, format::kMagic, sizeof(header.magic));
+            header.version = format::kVersion;
+
+            std::string result(sizeof(header), '\0');
+            header.strings = Append(result, std::span<const char>{_strings});
+            header.modules = Append(result, std::span<const format::Module>{_modules});
+            header.classes = Append(result, std::span<const format::Class>{_classes});
+            header.fields = Append(result, std::span<const format::Field>{_fields});
+            header.enums = Append(result, std::span<const format::Enum>{_enums});
+            header.enumerators = Append(result, std::span<const format::Enumerator>{_enumerators});
+            header.metadata = Append(result, std::span<const format::Metadata>{_metadata});
+            header.class_index = Append(result, std::span<const format::NameIndex>{class_index});
+            header.enum_index = Append(result, std::span<const format::NameIndex>{enum_index});
+            header.file_size = result.size();
+
+            std::memcpy(result.data(), &header, sizeof(header));
+
+            return result;
+        }
+
+    private:
+        void AddModule(std::string_view module_name, const sdk::snapshot::ModuleTypes& module) {
+            auto class_indices = module.classes;
+            std::ranges::sort(class_indices, {}, [this](auto i) -> std::string_view { return _schema.classes[i].name; });
+
+            auto enum_indices = module.enums;
+            std::ranges::sort(enum_indices, {}, [this](auto i) -> std::string_view { return _schema.enums[i].name; });
+
+            format::Module result{.name = AddString(module_name), .classes = {.first = Size(_classes), .count = 0}, .enums = {.first = Size(_enums), .count = 0}};
+
+            for (const auto index : class_indices) {
+                AddClass(index);
+            }
+
+            for (const auto index : enum_indices) {
+                AddEnum(_schema.enums[index]);
+            }
+
+            result.classes.count = Size(_classes) - result.classes.first;
+            result.enums.count = Size(_enums) - result.enums.first;
+            _modules.emplace_back(result);
+        }
+
+        void AddClass(sdk::snapshot::Index index) {
+            const auto& class_ = _schema.classes[index];
+
+            _class_records.emplace(index, Size(_classes));
+            _base_classes.emplace_back(class_.base_class);
+
+            format::Class result{
+                .name = AddString(class_.name),
+                .module = AddString(class_.module),
+                .size = static_cast<std::uint32_t>(class_.size),
+                .alignment = static_cast<std::uint32_t>(class_.registered_alignment.value_or(0)),
+                .flags = class_.flags,
+                .base_class = format::kNone,
+                .fields = {.first = Size(_fields), .count = static_cast<std::uint32_t>(class_.fields.size())},
+                .metadata = AddMetadata(class_.static_metadata),
+            };
+
+            // Fields are contiguous, their metadata is appended after them
+            _fields.resize(_fields.size() + class_.fields.size());
+
+            for (std::size_t i = 0; i < class_.fields.size(); ++i) {
+                const auto& field = class_.fields[i];
+                const auto& type = _schema.types[field.type];
+
+                _fields[result.fields.first + i] = format::Field{
+                    .name = AddString(field.name),
+                    .type_name = AddString(type.name),
+                    .offset = static_cast<std::uint32_t>(field.offset),
+                    .size = static_cast<std::uint32_t>(type.size.value_or(0)),
+                    .metadata = AddMetadata(field.metadata),
+                };
+            }
+
+            _classes.emplace_back(result);
+        }
+
+        void AddEnum(const sdk::snapshot::Enum& enum_) {
+            format::Enum result{
+                .name = AddString(enum_.name),
+                .module = AddString(enum_.module),
+                .size = enum_.size,
+                .alignment = enum_.alignment,
+                .enumerators = {.first = Size(_enumerators), .count = static_cast<std::uint32_t>(enum_.enumerators.size())},
+                .metadata = AddMetadata(enum_.static_metadata),
+            };
+
+            _enumerators.resize(_enumerators.size() + enum_.enumerators.size());
+
+            for (std::size_t i = 0; i < enum_.enumerators.size(); ++i) {
+                const auto& enumerator = enum_.enumerators[i];
+
+                _enumerators[result.enumerators.first + i] = format::Enumerator{
+                    .name = AddString(enumerator.name),
+                    .metadata = AddMetadata(enumerator.metadata),
+                    .value = enumerator.value,
+                };
+            }
+
+            _enums.emplace_back(result);
+        }
+
+        /// Base classes can be declared in a module that comes later, so they are resolved once all classes have been added
+        void ResolveBaseClasses() {
+            for (std::size_t i = 0; i < _classes.size(); ++i) {
+                if (const auto found = _class_records.find(_base_classes[i]); found != _class_records.end()) {
+                    _classes[i].base_class = found->second;
+                }
+            }
+        }
+
+        [[nodiscard]] format::Range AddMetadata(std::span<const sdk::snapshot::Metadata> metadata) {
+            const format::Range result{.first = Size(_metadata), .count = static_cast<std::uint32_t>(metadata.size())};
+
+            for (const auto& entry : metadata) {
+                _metadata.emplace_back(format::Metadata{.name = AddString(entry.name), .value = AddString(entry.value)});
+            }
+
+            return result;
+        }
+
+        /// Every string is stored once, type and metadata names repeat a lot
+        [[nodiscard]] format::String AddString(std::string_view string) {
+            if (const auto found = _string_offsets.find(string); found != _string_offsets.end()) {
+                return found->second;
+            }
+
+            const format::String result{.offset = Size(_strings), .size = static_cast<std::uint32_t>(string.size())};
+            _strings.insert(_strings.end(), string.begin(), string.end());
+            _strings.emplace_back('\0');
+
+            // Keys point into the snapshot, which outlives the builder
+            _string_offsets.emplace(string, result);
+
+            return result;
+        }
+
+        template <typename Record>
+        [[nodiscard]] std::vector<format::NameIndex> BuildNameIndex(std::span<const Record> records) const {
+            std::vector<format::NameIndex> result{};
+            result.reserve(records.size());
+
+            for (std::size_t i = 0; i < records.size(); ++i) {
+                const std::string_view name{_strings.data() + records[i].name.offset, records[i].name.size};
+                result.emplace_back(format::NameIndex{.hash = format::HashName(name), .record = static_cast<std::uint32_t>(i), .reserved = 0});
+            }
+
+            std::ranges::sort(result, {}, [](const format::NameIndex& entry) { return std::pair{entry.hash, entry.record}; });
+
+            return result;
+        }
+
+        /// Pads @p out to the alignment of @p Record and appends @p records
+        template <typename Record>
+        [[nodiscard]] static format::Table Append(std::string& out, std::span<const Record> records) {
+            static_assert(std::is_trivially_copyable_v<Record>);
+
+            out.resize((out.size() + alignof(std::uint64_t) - 1) / alignof(std::uint64_t) * alignof(std::uint64_t), '\0');
+
+            const format::Table result{.offset = out.size(), .count = records.size()};
+            out.append(reinterpret_cast<const char*>(records.data()), records.size_bytes());
+
+            return result;
+        }
+
+        /// Record indices and string offsets are 32-bit
+        template <typename Container>
+        [[nodiscard]] static std::uint32_t Size(const Container& container) {
+            if (container.size() > std::numeric_limits<std::uint32_t>::max()) {
+                throw std::runtime_error("schema is too large for schema.bin");
+            }
+
+            return static_cast<std::uint32_t>(container.size());
+        }
+
+        const sdk::snapshot::Snapshot& _schema;
+        std::vector<char> _strings{};
+        absl::flat_hash_map<std::string_view, format::String> _string_offsets{};
+        std::vector<format::Module> _modules{};
+        std::vector<format::Class> _classes{};
+        /// Snapshot index of the base class of every element of @ref _classes
+        std::vector<sdk::snapshot::Index> _base_classes{};
+        /// Key is the snapshot index, value is the index in @ref _classes
+        absl::flat_hash_map<sdk::snapshot::Index, std::uint32_t> _class_records{};
+        std::vector<format::Field> _fields{};
+        std::vector<format::Enum> _enums{};
+        std::vector<format::Enumerator> _enumerators{};
+        std::vector<format::Metadata> _metadata{};
+    };
+} // namespace
+
+namespace sdk {
+    std::string SerializeSchemaBinary(const snapshot::Snapshot& schema) {
+        return SchemaBinaryBuilder{schema}.Build();
+    }
+
+    void WriteSchemaBinary(const EmitTarget& target, const snapshot::Snapshot& schema, util::AsyncFileWriter& writer) {
+        if (target.language != source2_gen::Language::schema_bin) {
+            return;
+        }
+
+        writer.Enqueue(target.directory / "schema.bin", SerializeSchemaBinary(schema));
+    }
+} // namespace sdk
+
+// source2gen - Source2 games SDK generator
+// Copyright 2024 neverlosecc
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
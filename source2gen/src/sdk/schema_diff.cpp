@@ -0,0 +1,776 @@
+// Copyright (C) 2024 neverlosecc
+// See end of file for extended copyright information.
+#include "sdk/schema_diff.h"
+#include "tools/json_writer.h"
+#include <absl/container/flat_hash_map.h>
+#include <absl/hash/hash.h>
+#include <absl/strings/str_join.h>
+#include <algorithm>
+#include <cstring>
+#include <format>
+#include <fstream>
+#include <map>
+#include <span>
+#include <string_view>
+#include <utility>
+
+namespace {
+    using namespace sdk;
+    using namespace sdk::diff;
+
+    /// Module and name
+    using TypeKey = std::pair<std::string_view, std::string_view>;
+
+    template <typename H>
+    H CombineMetadata(H state, std::span<const snapshot::Metadata> metadata) {
+        for (const auto& entry : metadata) {
+            state = H::combine(std::move(state), entry.name, entry.value);
+        }
+
+        return H::combine(std::move(state), metadata.size());
+    }
+
+    /// Hashes everything @ref Compare() compares, names instead of indices
+    struct ClassShape {
+        const snapshot::Snapshot& schema;
+        const snapshot::Class& class_;
+
+        template <typename H>
+        friend H AbslHashValue(H state, const ClassShape& shape) {
+            const auto& class_ = shape.class_;
+
+            state = H::combine(std::move(state), class_.size, class_.registered_alignment, class_.flags, class_.base_class != snapshot::kNone);
+
+            if (class_.base_class != snapshot::kNone) {
+                const auto& base = shape.schema.classes[class_.base_class];
+                state = H::combine(std::move(state), base.module, base.name);
+            }
+
+            for (const auto& field : class_.fields) {
+                const auto& type = shape.schema.types[field.type];
+                state = H::combine(std::move(state), field.name, type.name, field.offset, type.size);
+                state = CombineMetadata(std::move(state), field.metadata);
+            }
+
+            state = H::combine(std::move(state), class_.fields.size());
+            return CombineMetadata(std::move(state), class_.static_metadata);
+        }
+    };
+
+    struct EnumShape {
+        const snapshot::Enum& enum_;
+
+        template <typename H>
+        friend H AbslHashValue(H state, const EnumShape& shape) {
+            const auto& enum_ = shape.enum_;
+
+            state = H::combine(std::move(state), enum_.size, enum_.alignment);
+
+            for (const auto& enumerator : enum_.enumerators) {
+                state = H::combine(std::move(state), enumerator.name, enumerator.value);
+                state = CombineMetadata(std::move(state), enumerator.metadata);
+            }
+
+            state = H::combine(std::move(state), enum_.enumerators.size());
+            return CombineMetadata(std::move(state), enum_.static_metadata);
+        }
+    };
+
+    /// Classes or enums of all modules of a schema
+    template <typename T>
+    struct TypeIndex {
+        std::vector<std::pair<std::string_view, const T*>> types{};
+        /// Value is an index into @ref types
+        absl::flat_hash_map<TypeKey, std::size_t> by_name{};
+    };
+
+    template <typename T>
+    [[nodiscard]] TypeIndex<T> IndexTypes(const snapshot::Snapshot& schema, const std::vector<T>& types,
+                                          std::vector<snapshot::Index> snapshot::ModuleTypes::* indices) {
+        TypeIndex<T> result{};
+
+        for (const auto& [module_name, module] : schema.modules) {
+            for (const auto index : module.*indices) {
+                const auto* const type = &types[index];
+
+                // If a module declares a name twice, the first one is used
+                if (result.by_name.try_emplace(TypeKey{module_name, type->name}, result.types.size()).second) {
+                    result.types.emplace_back(module_name, type);
+                }
+            }
+        }
+
+        return result;
+    }
+
+    [[nodiscard]] ClassState MakeClassState(const snapshot::Snapshot& schema, const snapshot::Class& class_) {
+        ClassState result{.size = class_.size, .alignment = class_.registered_alignment, .flags = class_.flags};
+
+        if (class_.base_class != snapshot::kNone) {
+            const auto& base = schema.classes[class_.base_class];
+            result.base_class = std::format("{}::{}", base.module, base.name);
+        }
+
+        return result;
+    }
+
+    [[nodiscard]] FieldState MakeFieldState(const snapshot::Snapshot& schema, const snapshot::Field& field) {
+        const auto& type = schema.types[field.type];
+        return FieldState{.type = type.name, .offset = field.offset, .size = type.size};
+    }
+
+    /// Matches elements of @p old_elements and @p new_elements by name
+    /// @param on_pair Called with the old and new element of every name that exists in both
+    /// @param on_removed Called with every old element that doesn't exist in @p new_elements
+    /// @param on_added Called with every new element that doesn't exist in @p old_elements, after all other calls
+    template <typename T>
+    void MatchByName(std::span<const T> old_elements, std::span<const T> new_elements, auto&& on_pair, auto&& on_removed, auto&& on_added) {
+        absl::flat_hash_map<std::string_view, std::size_t> new_by_name{};
+        new_by_name.reserve(new_elements.size());
+        for (std::size_t i = 0; i < new_elements.size(); ++i) {
+            new_by_name.try_emplace(new_elements[i].name, i);
+        }
+
+        std::vector<bool> matched(new_elements.size());
+
+        for (const auto& old_element : old_elements) {
+            if (const auto found = new_by_name.find(old_element.name); found != new_by_name.end() && !matched[found->second]) {
+                matched[found->second] = true;
+                on_pair(old_element, new_elements[found->second]);
+            } else {
+                on_removed(old_element);
+            }
+        }
+
+        for (std::size_t i = 0; i < new_elements.size(); ++i) {
+            if (!matched[i]) {
+                on_added(new_elements[i]);
+            }
+        }
+    }
+
+    /// @return Changes of a class that exists in both schemas. Empty if nothing has changed.
+    [[nodiscard]] std::optional<ClassChange> CompareClass(const snapshot::Snapshot& old_schema, const snapshot::Class& old_class,
+                                                          const snapshot::Snapshot& new_schema, const snapshot::Class& new_class) {
+        ClassChange result{
+            .old_class = MakeClassState(old_schema, old_class),
+            .new_class = MakeClassState(new_schema, new_class),
+            .metadata_changed = (old_class.static_metadata != new_class.static_metadata),
+        };
+
+        MatchByName<snapshot::Field>(
+            old_class.fields, new_class.fields,
+            [&](const snapshot::Field& old_field, const snapshot::Field& new_field) {
+                auto old_state = MakeFieldState(old_schema, old_field);
+                auto new_state = MakeFieldState(new_schema, new_field);
+                const bool metadata_changed = (old_field.metadata != new_field.metadata);
+
+                if ((old_state != new_state) || metadata_changed) {
+                    result.fields.emplace_back(FieldChange{
+                        .name = old_field.name, .old_field = std::move(old_state), .new_field = std::move(new_state), .metadata_changed = metadata_changed});
+                }
+            },
+            [&](const snapshot::Field& old_field) {
+                result.fields.emplace_back(FieldChange{.name = old_field.name, .old_field = MakeFieldState(old_schema, old_field)});
+            },
+            [&](const snapshot::Field& new_field) {
+                result.fields.emplace_back(FieldChange{.name = new_field.name, .new_field = MakeFieldState(new_schema, new_field)});
+            });
+
+        if (result.fields.empty() && !result.metadata_changed && (result.old_class == result.new_class)) {
+            return std::nullopt;
+        }
+
+        return result;
+    }
+
+    [[nodiscard]] std::optional<EnumChange> CompareEnum(const snapshot::Enum& old_enum, const snapshot::Enum& new_enum) {
+        EnumChange result{
+            .old_enum = EnumState{.size = old_enum.size, .alignment = old_enum.alignment},
+            .new_enum = EnumState{.size = new_enum.size, .alignment = new_enum.alignment},
+            .metadata_changed = (old_enum.static_metadata != new_enum.static_metadata),
+        };
+
+        MatchByName<snapshot::Enumerator>(
+            old_enum.enumerators, new_enum.enumerators,
+            [&](const snapshot::Enumerator& old_enumerator, const snapshot::Enumerator& new_enumerator) {
+                const bool metadata_changed = (old_enumerator.metadata != new_enumerator.metadata);
+
+                if ((old_enumerator.value != new_enumerator.value) || metadata_changed) {
+                    result.enumerators.emplace_back(EnumeratorChange{.name = old_enumerator.name,
+                                                                     .old_value = old_enumerator.value,
+                                                                     .new_value = new_enumerator.value,
+                                                                     .metadata_changed = metadata_changed});
+                }
+            },
+            [&](const snapshot::Enumerator& old_enumerator) {
+                result.enumerators.emplace_back(EnumeratorChange{.name = old_enumerator.name, .old_value = old_enumerator.value});
+            },
+            [&](const snapshot::Enumerator& new_enumerator) {
+                result.enumerators.emplace_back(EnumeratorChange{.name = new_enumerator.name, .new_value = new_enumerator.value});
+            });
+
+        if (result.enumerators.empty() && !result.metadata_changed && (result.old_enum == result.new_enum)) {
+            return std::nullopt;
+        }
+
+        return result;
+    }
+
+    /// Pairs the types of both schemas by module and name. Types whose hashes are equal are counted as unchanged without comparing them.
+    /// @param compare Called for types that exist in both schemas, but have different hashes
+    /// @param make_change Called for types that only exist in one schema, with the type and whether it's the old one
+    template <typename T, typename Change>
+    void CompareTypes(const TypeIndex<T>& old_index, const TypeIndex<T>& new_index, auto&& hash, auto&& compare, auto&& make_change,
+                      std::vector<Change>& changes, std::size_t& unchanged) {
+        std::vector<bool> matched(new_index.types.size());
+
+        for (const auto& [module_name, old_type] : old_index.types) {
+            const auto found = new_index.by_name.find(TypeKey{module_name, old_type->name});
+
+            if (found == new_index.by_name.end()) {
+                changes.emplace_back(make_change(module_name, *old_type, true));
+                continue;
+            }
+
+            matched[found->second] = true;
+            const auto* const new_type = new_index.types[found->second].second;
+
+            if (hash(*old_type, true) == hash(*new_type, false)) {
+                ++unchanged;
+            } else if (auto change = compare(*old_type, *new_type); change.has_value()) {
+                change->module = module_name;
+                change->name = old_type->name;
+                changes.emplace_back(std::move(change.value()));
+            } else {
+                ++unchanged;
+            }
+        }
+
+        for (std::size_t i = 0; i < new_index.types.size(); ++i) {
+            if (!matched[i]) {
+                const auto& [module_name, new_type] = new_index.types[i];
+                changes.emplace_back(make_change(module_name, *new_type, false));
+            }
+        }
+
+        std::ranges::sort(changes, {}, [](const Change& change) { return TypeKey{change.module, change.name}; });
+    }
+
+    /// "added", "removed", or "changed"
+    [[nodiscard]] std::string_view GetChangeKind(bool has_old, bool has_new) {
+        return !has_old ? "added" : (!has_new ? "removed" : "changed");
+    }
+
+    /// '+', '-', or '~'
+    [[nodiscard]] char GetChangeSymbol(bool has_old, bool has_new) {
+        return !has_old ? '+' : (!has_new ? '-' : '~');
+    }
+
+    template <typename T>
+    void WriteOptional(util::JsonWriter& json, const std::optional<T>& value) {
+        if (value.has_value()) {
+            json.Number(value.value());
+        } else {
+            json.Null();
+        }
+    }
+
+    void WriteClassState(util::JsonWriter& json, const std::optional<ClassState>& state) {
+        if (!state.has_value()) {
+            json.Null();
+            return;
+        }
+
+        json.BeginObject();
+        json.Key("size");
+        json.Number(state->size);
+        json.Key("alignment");
+        WriteOptional(json, state->alignment);
+        json.Key("flags");
+        json.Number(state->flags);
+        json.Key("base_class");
+        json.String(state->base_class);
+        json.EndObject();
+    }
+
+    void WriteFieldState(util::JsonWriter& json, const std::optional<FieldState>& state) {
+        if (!state.has_value()) {
+            json.Null();
+            return;
+        }
+
+        json.BeginObject();
+        json.Key("type");
+        json.String(state->type);
+        json.Key("offset");
+        json.Number(state->offset);
+        json.Key("size");
+        WriteOptional(json, state->size);
+        json.EndObject();
+    }
+
+    void WriteEnumState(util::JsonWriter& json, const std::optional<EnumState>& state) {
+        if (!state.has_value()) {
+            json.Null();
+            return;
+        }
+
+        json.BeginObject();
+        json.Key("size");
+        json.Number(state->size);
+        json.Key("alignment");
+        json.Number(state->alignment);
+        json.EndObject();
+    }
+
+    struct ChangeCounts {
+        std::size_t changed{};
+        std::size_t added{};
+        std::size_t removed{};
+    };
+
+    template <typename Change, typename State>
+    [[nodiscard]] ChangeCounts CountChanges(const std::vector<Change>& changes, std::optional<State> Change::* old_state,
+                                            std::optional<State> Change::* new_state) {
+        ChangeCounts result{};
+
+        for (const auto& change : changes) {
+            if (!(change.*old_state).has_value()) {
+                ++result.added;
+            } else if (!(change.*new_state).has_value()) {
+                ++result.removed;
+            } else {
+                ++result.changed;
+            }
+        }
+
+        return result;
+    }
+
+    void WriteCounts(util::JsonWriter& json, const ChangeCounts& counts, std::size_t unchanged) {
+        json.BeginObject();
+        json.Key("changed");
+        json.Number(counts.changed);
+        json.Key("added");
+        json.Number(counts.added);
+        json.Key("removed");
+        json.Number(counts.removed);
+        json.Key("unchanged");
+        json.Number(unchanged);
+        json.EndObject();
+    }
+
+    [[nodiscard]] std::string FormatSize(const std::optional<int>& size) {
+        return size.has_value() ? std::format("{:#x}", size.value()) : "?";
+    }
+
+    /// @return See @ref sdk::diff::SchemaDiff::changed_modules
+    [[nodiscard]] std::optional<std::vector<std::string>> CompareModuleHashes(std::span<const sdk::snapshot::ModuleHash> old_hashes,
+                                                                              std::span<const sdk::snapshot::ModuleHash> new_hashes) {
+        if (old_hashes.empty() || new_hashes.empty()) {
+            return std::nullopt;
+        }
+
+        std::map<std::string_view, std::pair<std::optional<std::uint64_t>, std::optional<std::uint64_t>>> hashes{};
+        for (const auto& [name, hash] : old_hashes) {
+            hashes[name].first = hash;
+        }
+        for (const auto& [name, hash] : new_hashes) {
+            hashes[name].second = hash;
+        }
+
+        std::vector<std::string> result{};
+        for (const auto& [name, hash] : hashes) {
+            if (hash.first != hash.second) {
+                result.emplace_back(name);
+            }
+        }
+
+        return result;
+    }
+} // namespace
+
+namespace sdk::diff {
+    std::uint64_t HashClass(const snapshot::Snapshot& schema, const snapshot::Class& class_) {
+        return absl::HashOf(ClassShape{.schema = schema, .class_ = class_});
+    }
+
+    std::uint64_t HashEnum(const snapshot::Enum& enum_) {
+        return absl::HashOf(EnumShape{.enum_ = enum_});
+    }
+
+    SchemaDiff Compare(const snapshot::Snapshot& old_schema, const snapshot::Snapshot& new_schema) {
+        SchemaDiff result{};
+
+        CompareTypes(
+            IndexTypes(old_schema, old_schema.classes, &snapshot::ModuleTypes::classes),
+            IndexTypes(new_schema, new_schema.classes, &snapshot::ModuleTypes::classes),
+            [&](const snapshot::Class& class_, bool is_old) { return HashClass(is_old ? old_schema : new_schema, class_); },
+            [&](const snapshot::Class& old_class, const snapshot::Class& new_class) { return CompareClass(old_schema, old_class, new_schema, new_class); },
+            [&](std::string_view module_name, const snapshot::Class& class_, bool is_old) {
+                auto state = MakeClassState(is_old ? old_schema : new_schema, class_);
+                return ClassChange{.module = std::string{module_name},
+                                   .name = class_.name,
+                                   .old_class = is_old ? std::optional{state} : std::nullopt,
+                                   .new_class = is_old ? std::nullopt : std::optional{state}};
+            },
+            result.classes, result.unchanged_classes);
+
+        CompareTypes(
+            IndexTypes(old_schema, old_schema.enums, &snapshot::ModuleTypes::enums),
+            IndexTypes(new_schema, new_schema.enums, &snapshot::ModuleTypes::enums),
+            [](const snapshot::Enum& enum_, bool) { return HashEnum(enum_); }, CompareEnum,
+            [](std::string_view module_name, const snapshot::Enum& enum_, bool is_old) {
+                const EnumState state{.size = enum_.size, .alignment = enum_.alignment};
+                return EnumChange{.module = std::string{module_name},
+                                  .name = enum_.name,
+                                  .old_enum = is_old ? std::optional{state} : std::nullopt,
+                                  .new_enum = is_old ? std::nullopt : std::optional{state}};
+            },
+            result.enums, result.unchanged_enums);
+
+        result.changed_modules = CompareModuleHashes(old_schema.module_hashes, new_schema.module_hashes);
+
+        return result;
+    }
+
+    snapshot::Snapshot FromSchemaBinary(const source2sdk::schema::View& view) {
+        snapshot::Snapshot result{};
+        result.classes.reserve(view.classes().size());
+        result.enums.reserve(view.enums().size());
+
+        // Key is the type name, the file stores names of types, not types
+        absl::flat_hash_map<std::string_view, snapshot::Index> types{};
+
+        const auto get_type = [&](const source2sdk::schema::FieldView& field) {
+            const auto [found, inserted] = types.try_emplace(field.type_name(), static_cast<snapshot::Index>(result.types.size()));
+
+            if (inserted) {
+                result.types.emplace_back(snapshot::Type{
+                    .name = std::string{field.type_name()},
+                    .size = (field.size() != 0) ? std::optional<int>{static_cast<int>(field.size())} : std::nullopt,
+                });
+            }
+
+            return found->second;
+        };
+
+        const auto convert_metadata = [](const auto& metadata) {
+            std::vector<snapshot::Metadata> result{};
+            result.reserve(metadata.size());
+
+            for (const auto entry : metadata) {
+                result.emplace_back(snapshot::Metadata{.name = std::string{entry.name()}, .value = std::string{entry.value()}});
+            }
+
+            return result;
+        };
+
+        // Classes are in the same order as in the file, so their indices are the same
+        for (const auto class_ : view.classes()) {
+            auto& converted = result.classes.emplace_back(snapshot::Class{
+                .name = std::string{class_.name()},
+                .module = std::string{class_.module()},
+                .size = static_cast<std::int32_t>(class_.size()),
+                .registered_alignment = (class_.alignment() != 0) ? std::optional<int>{static_cast<int>(class_.alignment())} : std::nullopt,
+                .flags = class_.flags(),
+                .base_class = (class_.record().base_class < view.classes().size()) ? class_.record().base_class : snapshot::kNone,
+                .static_metadata = convert_metadata(class_.metadata()),
+            });
+
+            converted.fields.reserve(class_.fields().size());
+            for (const auto field : class_.fields()) {
+                converted.fields.emplace_back(snapshot::Field{
+                    .name = std::string{field.name()},
+                    .type = get_type(field),
+                    .offset = static_cast<std::int32_t>(field.offset()),
+                    .metadata = convert_metadata(field.metadata()),
+                });
+            }
+        }
+
+        for (const auto enum_ : view.enums()) {
+            auto& converted = result.enums.emplace_back(snapshot::Enum{
+                .name = std::string{enum_.name()},
+                .module = std::string{enum_.module()},
+                .size = static_cast<std::uint8_t>(enum_.size()),
+                .alignment = static_cast<std::uint8_t>(enum_.alignment()),
+                .static_metadata = convert_metadata(enum_.metadata()),
+            });
+
+            converted.enumerators.reserve(enum_.enumerators().size());
+            for (const auto enumerator : enum_.enumerators()) {
+                converted.enumerators.emplace_back(snapshot::Enumerator{
+                    .name = std::string{enumerator.name()},
+                    .value = enumerator.value(),
+                    .metadata = convert_metadata(enumerator.metadata()),
+                });
+            }
+        }
+
+        for (const auto module : view.modules()) {
+            auto& converted = result.modules[std::string{module.name()}];
+            const auto& record = module.record();
+
+            for (std::uint32_t i = 0; i < record.classes.count; ++i) {
+                converted.classes.emplace_back(record.classes.first + i);
+            }
+
+            for (std::uint32_t i = 0; i < record.enums.count; ++i) {
+                converted.enums.emplace_back(record.enums.first + i);
+            }
+        }
+
+        return result;
+    }
+
+    std::expected<snapshot::Snapshot, std::string> LoadSchema(const std::filesystem::path& path) {
+        char magic[sizeof(source2sdk::schema::format::kMagic)]{};
+
+        if (std::ifstream file{path, std::ios::binary}; !file.read(magic, sizeof(magic)) ||
+                                                        (std::memcmp(magic, source2sdk::schema::format::kMagic, sizeof(magic)) != 0)) {
+            return snapshot::Load(path);
+        }
+
+        const auto file = source2sdk::schema::MappedFile::Open(path.string().c_str());
+        if (!file.has_value()) {
+            return std::unexpected(std::format("Could not map {}", path.string()));
+        }
+
+        const auto view = source2sdk::schema::View::FromBytes(file->bytes());
+        if (!view.has_value()) {
+            return std::unexpected(std::format("{} is corrupt, or it has been written by an incompatible version of source2gen", path.string()));
+        }
+
+        return FromSchemaBinary(view.value());
+    }
+
+    void WriteReport(const SchemaDiff& diff, std::ostream& out) {
+        util::JsonWriter json{out};
+
+        json.BeginObject();
+
+        json.Key("summary");
+        json.BeginObject();
+        json.Key("classes");
+        WriteCounts(json, CountChanges(diff.classes, &ClassChange::old_class, &ClassChange::new_class), diff.unchanged_classes);
+        json.Key("enums");
+        WriteCounts(json, CountChanges(diff.enums, &EnumChange::old_enum, &EnumChange::new_enum), diff.unchanged_enums);
+        json.EndObject();
+
+        json.Key("changed_modules");
+        if (diff.changed_modules.has_value()) {
+            json.BeginArray();
+            for (const auto& module : diff.changed_modules.value()) {
+                json.String(module);
+            }
+            json.EndArray();
+        } else {
+            json.Null();
+        }
+
+        json.Key("classes");
+        json.BeginArray();
+        for (const auto& change : diff.classes) {
+            json.BeginObject();
+            json.Key("module");
+            json.String(change.module);
+            json.Key("name");
+            json.String(change.name);
+            json.Key("change");
+            json.String(GetChangeKind(change.old_class.has_value(), change.new_class.has_value()));
+            json.Key("old");
+            WriteClassState(json, change.old_class);
+            json.Key("new");
+            WriteClassState(json, change.new_class);
+            json.Key("metadata_changed");
+            json.Bool(change.metadata_changed);
+
+            json.Key("fields");
+            json.BeginArray();
+            for (const auto& field : change.fields) {
+                json.BeginObject();
+                json.Key("name");
+                json.String(field.name);
+                json.Key("change");
+                json.String(GetChangeKind(field.old_field.has_value(), field.new_field.has_value()));
+                json.Key("old");
+                WriteFieldState(json, field.old_field);
+                json.Key("new");
+                WriteFieldState(json, field.new_field);
+                json.Key("metadata_changed");
+                json.Bool(field.metadata_changed);
+                json.EndObject();
+            }
+            json.EndArray();
+
+            json.EndObject();
+        }
+        json.EndArray();
+
+        json.Key("enums");
+        json.BeginArray();
+        for (const auto& change : diff.enums) {
+            json.BeginObject();
+            json.Key("module");
+            json.String(change.module);
+            json.Key("name");
+            json.String(change.name);
+            json.Key("change");
+            json.String(GetChangeKind(change.old_enum.has_value(), change.new_enum.has_value()));
+            json.Key("old");
+            WriteEnumState(json, change.old_enum);
+            json.Key("new");
+            WriteEnumState(json, change.new_enum);
+            json.Key("metadata_changed");
+            json.Bool(change.metadata_changed);
+
+            json.Key("enumerators");
+            json.BeginArray();
+            for (const auto& enumerator : change.enumerators) {
+                json.BeginObject();
+                json.Key("name");
+                json.String(enumerator.name);
+                json.Key("change");
+                json.String(GetChangeKind(enumerator.old_value.has_value(), enumerator.new_value.has_value()));
+                json.Key("old_value");
+                WriteOptional(json, enumerator.old_value);
+                json.Key("new_value");
+                WriteOptional(json, enumerator.new_value);
+                json.Key("metadata_changed");
+                json.Bool(enumerator.metadata_changed);
+                json.EndObject();
+            }
+            json.EndArray();
+
+            json.EndObject();
+        }
+        json.EndArray();
+
+        json.EndObject();
+    }
+
+    void PrintSummary(const SchemaDiff& diff, std::ostream& out) {
+        const auto classes = CountChanges(diff.classes, &ClassChange::old_class, &ClassChange::new_class);
+        const auto enums = CountChanges(diff.enums, &EnumChange::old_enum, &EnumChange::new_enum);
+
+        out << std::format("Classes: {} changed, {} added, {} removed, {} unchanged\n", classes.changed, classes.added, classes.removed,
+                           diff.unchanged_classes);
+        out << std::format("Enums: {} changed, {} added, {} removed, {} unchanged\n", enums.changed, enums.added, enums.removed,
+                           diff.unchanged_enums);
+
+        if (!diff.changed_modules.has_value()) {
+            out << "Game build: unknown, a schema doesn't record the hashes of the game modules\n";
+        } else if (diff.changed_modules->empty()) {
+            out << "Game build: same, all game modules are identical\n";
+        } else {
+            out << std::format("Game build: different, {} game module(s) changed: {}\n", diff.changed_modules->size(),
+                               absl::StrJoin(diff.changed_modules.value(), ", "));
+        }
+
+        for (const auto& change : diff.classes) {
+            out << std::format("\n{} {}::{}", GetChangeSymbol(change.old_class.has_value(), change.new_class.has_value()), change.module,
+                               change.name);
+
+            if (change.old_class.has_value() && change.new_class.has_value()) {
+                const auto& old_class = change.old_class.value();
+                const auto& new_class = change.new_class.value();
+
+                if (old_class.size != new_class.size) {
+                    out << std::format(", size {:#x} -> {:#x}", old_class.size, new_class.size);
+                }
+                if (old_class.alignment != new_class.alignment) {
+                    out << std::format(", alignment {} -> {}", FormatSize(old_class.alignment), FormatSize(new_class.alignment));
+                }
+                if (old_class.flags != new_class.flags) {
+                    out << std::format(", flags {:#x} -> {:#x}", old_class.flags, new_class.flags);
+                }
+                if (old_class.base_class != new_class.base_class) {
+                    out << std::format(", base \"{}\" -> \"{}\"", old_class.base_class, new_class.base_class);
+                }
+            } else {
+                out << std::format(", size {:#x}", change.old_class.value_or(change.new_class.value_or(ClassState{})).size);
+            }
+
+            if (change.metadata_changed) {
+                out << ", metadata changed";
+            }
+
+            out << '\n';
+
+            for (const auto& field : change.fields) {
+                out << std::format("    {} {}", GetChangeSymbol(field.old_field.has_value(), field.new_field.has_value()), field.name);
+
+                if (field.old_field.has_value() && field.new_field.has_value()) {
+                    const auto& old_field = field.old_field.value();
+                    const auto& new_field = field.new_field.value();
+
+                    if (old_field.offset != new_field.offset) {
+                        out << std::format(", offset {:#x} -> {:#x}", old_field.offset, new_field.offset);
+                    }
+                    if (old_field.type != new_field.type) {
+                        out << std::format(", type \"{}\" -> \"{}\"", old_field.type, new_field.type);
+                    } else if (old_field.size != new_field.size) {
+                        out << std::format(", size {} -> {}", FormatSize(old_field.size), FormatSize(new_field.size));
+                    }
+                    if (field.metadata_changed) {
+                        out << ", metadata changed";
+                    }
+                } else {
+                    const auto& state = field.old_field.has_value() ? field.old_field.value() : field.new_field.value();
+                    out << std::format(", {} at {:#x}", state.type, state.offset);
+                }
+
+                out << '\n';
+            }
+        }
+
+        for (const auto& change : diff.enums) {
+            out << std::format("\n{} {}::{}", GetChangeSymbol(change.old_enum.has_value(), change.new_enum.has_value()), change.module, change.name);
+
+            if (change.old_enum.has_value() && change.new_enum.has_value() && (change.old_enum->size != change.new_enum->size)) {
+                out << std::format(", size {} -> {}", change.old_enum->size, change.new_enum->size);
+            }
+
+            if (change.metadata_changed) {
+                out << ", metadata changed";
+            }
+
+            out << '\n';
+
+            for (const auto& enumerator : change.enumerators) {
+                out << std::format("    {} {}", GetChangeSymbol(enumerator.old_value.has_value(), enumerator.new_value.has_value()), enumerator.name);
+
+                if (enumerator.old_value.has_value() && enumerator.new_value.has_value()) {
+                    if (enumerator.old_value != enumerator.new_value) {
+                        out << std::format(" = {} -> {}", enumerator.old_value.value(), enumerator.new_value.value());
+                    }
+                    if (enumerator.metadata_changed) {
+                        out << ", metadata changed";
+                    }
+                } else {
+                    out << std::format(" = {}", enumerator.old_value.value_or(enumerator.new_value.value_or(0)));
+                }
+
+                out << '\n';
+            }
+        }
+    }
+} // namespace sdk::diff
+
+// source2gen - Source2 games SDK generator
+// Copyright 2024 neverlosecc
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
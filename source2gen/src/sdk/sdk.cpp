@@ -4,20 +4,28 @@
 // ReSharper disable CppClangTidyClangDiagnosticLanguageExtensionToken
 #include "sdk/sdk.h"
 #include "Include.h"
+#include "sdk/include_graph.h"
+#include "sdk/timing_history.h"
 #include "tools/codegen/c.h"
 #include "tools/codegen/codegen.h"
 #include "tools/codegen/cpp.h"
 #include "tools/field_parser.h"
+#include "tools/thread_pool.h"
 #include "tools/util.h"
 #include <absl/strings/str_replace.h>
 #include <cstdlib>
 
 #include <algorithm>
+#include <chrono>
+#include <concepts>
 #include <filesystem>
 #include <fstream>
 #include <functional>
 #include <iostream>
 #include <list>
+#include <map>
+#include <mutex>
+#include <numeric>
 #include <ranges>
 #include <set>
 #include <span>
@@ -28,27 +36,16 @@
 #include <vector>
 
 namespace {
-    enum class NameSource {
-        include,
-        forward_declaration,
-    };
-
-    struct NameLookup {
-        std::string module{};
-
-        /// Decayed
-        std::string type_name{};
+    namespace snapshot = sdk::snapshot;
 
-        NameSource source{};
-
-        auto operator<=>(const NameLookup&) const = default;
-    };
+    using sdk::NameLookup;
+    using sdk::NameSource;
 
     struct BitfieldEntry {
         std::string name{};
         std::size_t size{};
-        /// Lifetime of fields' pointers bound to the source2's @ref CSchemaClassInfo
-        std::vector<SchemaMetadataEntryData_t> metadata{};
+        /// Lifetime bound to the @ref sdk::snapshot::Snapshot
+        std::span<const snapshot::Metadata> metadata{};
     };
 
     struct ClassAssemblyState {
@@ -70,179 +67,67 @@ namespace {
      *   - <kSdkDirName>
      *     - some_module
      *       - some_header.hpp
+     *       - <kUmbrellaHeaderName>.hpp (C++ only, includes all headers of the module)
+     *       - <kStaticFieldsHeaderName>.hpp (C++ only, if the module has classes with static fields)
+     * C++ modules have a module interface unit per module instead, "modules/<kIncludeDirName>.<module>.cppm"
+     * If more than one language is emitted, every language has this structure in <kOutDirName>/<language>
      */
     constexpr std::string_view kOutDirName = "sdk";
     constexpr std::string_view kIncludeDirName = "source2sdk";
-
-    constinit std::array string_metadata_entries = {
-        FNV32("MCellForDomain"),
-        FNV32("MCustomFGDMetadata"),
-        FNV32("MFieldVerificationName"),
-        FNV32("MKV3TransferName"),
-        FNV32("MNetworkAlias"),
-        FNV32("MNetworkChangeCallback"),
-        FNV32("MNetworkEncoder"),
-        FNV32("MNetworkExcludeByName"),
-        FNV32("MNetworkExcludeByUserGroup"),
-        FNV32("MNetworkIncludeByName"),
-        FNV32("MNetworkIncludeByUserGroup"),
-        FNV32("MNetworkReplayCompatField"),
-        FNV32("MNetworkSerializer"),
-        FNV32("MNetworkTypeAlias"),
-        FNV32("MNetworkUserGroup"),
-        FNV32("MNetworkUserGroupProxy"),
-        FNV32("MParticleReplacementOp"),
-        FNV32("MPropertyArrayElementNameKey"),
-        FNV32("MPropertyAttributeChoiceName"),
-        FNV32("MPropertyAttributeEditor"),
-        FNV32("MPropertyAttributeRange"),
-        FNV32("MPropertyAttributeSuggestionName"),
-        FNV32("MPropertyCustomEditor"),
-        FNV32("MPropertyCustomFGDType"),
-        FNV32("MPropertyDescription"),
-        FNV32("MPropertyDescription"),
-        FNV32("MPropertyExtendedEditor"),
-        FNV32("MPropertyFriendlyName"),
-        FNV32("MPropertyFriendlyName"),
-        FNV32("MPropertyGroupName"),
-        FNV32("MPropertyIconName"),
-        FNV32("MPropertyStartGroup"),
-        FNV32("MPropertySuppressExpr"),
-        FNV32("MPulseCellOutflowHookInfo"),
-        FNV32("MPulseEditorHeaderIcon"),
-#if !defined(DEADLOCK) && !defined(DOTA2)
-        FNV32("MPulseProvideFeatureTag"),
-#endif
-        FNV32("MResourceBlockType"),
-        FNV32("MScriptDescription"),
-        FNV32("MSrc1ImportAttributeName"),
-        FNV32("MSrc1ImportDmElementType"),
-        FNV32("MVDataOutlinerIcon"),
-        FNV32("MVDataOutlinerIconExpr"),
-        FNV32("MVDataUniqueMonotonicInt"),
-        FNV32("MVectorIsSometimesCoordinate"),
-    };
-
-    constinit std::array string_class_metadata_entries = {
-        FNV32("MResourceTypeForInfoType"),
-        FNV32("MDiskDataForResourceType"),
-    };
-
-    constinit std::array var_name_string_class_metadata_entries = {
-        FNV32("MNetworkVarNames"), FNV32("MNetworkOverride"), FNV32("MNetworkVarTypeOverride"), FNV32("MScriptDescription"), FNV32("MParticleDomainTag"),
-    };
-
-    constinit std::array integer_metadata_entries = {
-        FNV32("MNetworkVarEmbeddedFieldOffsetDelta"),
-        FNV32("MNetworkBitCount"),
-        FNV32("MNetworkPriority"),
-        FNV32("MParticleOperatorType"),
-        FNV32("MPropertySortPriority"),
-        FNV32("MParticleMinVersion"),
-        FNV32("MParticleMaxVersion"),
-#if defined(DEADLOCK) || defined(DOTA2)
-        FNV32("MPulseProvideFeatureTag"),
-#endif
-        FNV32("MNetworkEncodeFlags"),
-        FNV32("MResourceVersion"),
-        FNV32("MVDataNodeType"),
-        FNV32("MVDataOverlayType"),
-        FNV32("MAlignment"),
-        FNV32("MGenerateArrayKeynamesFirstIndex"),
-    };
-
-    constinit std::array float_metadata_entries = {
-        FNV32("MNetworkMinValue"),
-        FNV32("MNetworkMaxValue"),
-    };
+    constexpr std::string_view kUmbrellaHeaderName = "all";
+    constexpr std::string_view kStaticFieldsHeaderName = "static_fields";
 
     void warn(std::string_view message) {
-        std::cerr << "warning: " << message << '\n';
-    }
+        // Generator threads warn concurrently. Write the whole line at once so lines don't get interleaved.
+        static std::mutex mutex{};
+        const auto line = std::format("warning: {}\n", message);
 
-    // @note: @es3n1n: some more utils
-    //
-    std::string GetMetadataValue(const SchemaMetadataEntryData_t& metadata_entry) {
-        std::string value;
-
-        const auto value_hash_name = fnv32::hash_runtime(metadata_entry.m_szName);
-
-        if (std::ranges::find(var_name_string_class_metadata_entries, value_hash_name) != var_name_string_class_metadata_entries.end()) {
-            const auto& var_value = metadata_entry.m_pNetworkValue->m_VarValue;
-            const auto check_ptr = [](const char* ptr) -> bool {
-                /// @note: hotfix for the deadlock 14/09/24 update,
-                ///     where they filled some ptrs with -1 instead of nullptr
-                return ptr != nullptr && ptr != reinterpret_cast<const char*>(-1);
-            };
+        std::scoped_lock lock{mutex};
+        std::cerr << line;
+    }
 
-            if (check_ptr(var_value.m_pszType) && check_ptr(var_value.m_pszName))
-                value = std::format("{} {}", var_value.m_pszType, var_value.m_pszName);
-            else if (check_ptr(var_value.m_pszName) && !check_ptr(var_value.m_pszType))
-                value = var_value.m_pszName;
-            else if (!check_ptr(var_value.m_pszName) && check_ptr(var_value.m_pszType))
-                value = var_value.m_pszType;
-        } else if (std::ranges::find(string_class_metadata_entries, value_hash_name) != string_class_metadata_entries.end()) {
-            /// Explicitly convert to std::string with the size as the string may not end with a nullterm
-            /// But if this string does contain a null terminator, we should properly handle this too
-            const auto& szValue = metadata_entry.m_pNetworkValue->m_szValue;
-            const auto null_pos = std::find(szValue.begin(), szValue.end(), 0x00);
-            const auto size = null_pos != szValue.end() ? std::distance(szValue.begin(), null_pos) : szValue.size();
-
-            value = std::string(metadata_entry.m_pNetworkValue->m_szValue.data(), size);
-        } else if (std::ranges::find(string_metadata_entries, value_hash_name) != string_metadata_entries.end()) {
-            value = metadata_entry.m_pNetworkValue->m_pszValue;
-        } else if (std::ranges::find(integer_metadata_entries, value_hash_name) != integer_metadata_entries.end()) {
-            value = std::to_string(metadata_entry.m_pNetworkValue->m_nValue);
-        } else if (std::ranges::find(float_metadata_entries, value_hash_name) != float_metadata_entries.end()) {
-            value = std::to_string(metadata_entry.m_pNetworkValue->m_fValue);
-        }
-
-        return value;
+    /// Built-in types don't have a scope. Nothing is declared in them.
+    [[nodiscard]] const snapshot::Scope& GetScope(const snapshot::Snapshot& schema, snapshot::Index scope) {
+        static const snapshot::Scope empty_scope{};
+        return (scope == snapshot::kNone) ? empty_scope : schema.scopes[scope];
     }
 
     /// https://en.cppreference.com/w/cpp/language/classes#Standard-layout_class
     /// Doesn't check for all requirements, but is strict enough for what we are doing.
-    [[nodiscard]] bool IsStandardLayoutClass(std::map<sdk::TypeIdentifier, bool>& cache, const CSchemaClassInfo& class_) {
-        const auto id = sdk::TypeIdentifier{.module = std::string{class_.GetModule()}, .name = std::string{class_.GetName()}};
-
-        if (const auto found = cache.find(id); found != cache.end()) {
-            return found->second;
-        }
-
-        // only one class in the hierarchy has non-static data members.
-        // assumes that source2 only has single inheritance.
-        {
-            const auto* pClass = &class_;
-            int classes_with_fields = 0;
-            do {
-                // also check size because not all members are registered with
-                // the schema system.
-                classes_with_fields += ((pClass->m_nSizeOf > 1) || (pClass->m_nFieldSize != 0)) ? 1 : 0;
-
-                if (classes_with_fields > 1) {
-                    return cache.emplace(id, false).first->second;
-                }
-
-                pClass = (pClass->m_pBaseClasses == nullptr) ? nullptr : pClass->m_pBaseClasses->m_pClass;
-            } while (pClass != nullptr);
-        }
+    [[nodiscard]] bool IsStandardLayoutClass(sdk::ConcurrentTypeMemo<snapshot::Class, bool>& cache, const snapshot::Snapshot& schema,
+                                             const snapshot::Class& class_) {
+        return cache.GetOrCompute(class_, [&]() {
+            // only one class in the hierarchy has non-static data members.
+            // assumes that source2 only has single inheritance.
+            {
+                const auto* pClass = &class_;
+                int classes_with_fields = 0;
+                do {
+                    // also check size because not all members are registered with
+                    // the schema system.
+                    classes_with_fields += ((pClass->size > 1) || !pClass->fields.empty()) ? 1 : 0;
+
+                    if (classes_with_fields > 1) {
+                        return false;
+                    }
 
-        const auto has_non_standard_layout_field = std::ranges::any_of(
-            class_.GetFields() | std::ranges::views::transform([&](const SchemaClassFieldData_t& e) {
-                if (const auto* e_class = e.m_pSchemaType->GetAsDeclaredClass(); e_class != nullptr && e_class->m_pClassInfo != nullptr) {
-                    return !IsStandardLayoutClass(cache, *e_class->m_pClassInfo);
-                } else {
-                    // Everything that is not a class has no effect
-                    return false;
-                }
-            }),
-            std::identity{});
+                    pClass = (pClass->base_class == snapshot::kNone) ? nullptr : &schema.classes[pClass->base_class];
+                } while (pClass != nullptr);
+            }
 
-        if (has_non_standard_layout_field) {
-            return cache.emplace(id, false).first->second;
-        }
+            const auto has_non_standard_layout_field = std::ranges::any_of(
+                class_.fields | std::ranges::views::transform([&](const snapshot::Field& e) {
+                    if (const auto e_class = schema.types[e.type].declared_class; e_class != snapshot::kNone) {
+                        return !IsStandardLayoutClass(cache, schema, schema.classes[e_class]);
+                    } else {
+                        // Everything that is not a class has no effect
+                        return false;
+                    }
+                }),
+                std::identity{});
 
-        return cache.emplace(id, true).first->second;
+            return !has_non_standard_layout_field;
+        });
     }
 
     /// Gets the alignment of a class by recursing through all of its fields.
@@ -250,73 +135,76 @@ namespace {
     /// @param cache Used to look up and store alignment of fields
     /// @return @ref GetRegisteredAlignment() if set. Otherwise tries to determine the alignment by recursing through all fields.
     /// Returns @ref std::nullopt if one or more fields have unknown alignment.
-    [[nodiscard]] std::optional<int> GetClassAlignmentRecursive(std::map<sdk::TypeIdentifier, std::optional<int>>& cache, const CSchemaClassInfo& class_) {
-        const auto id = sdk::TypeIdentifier{.module = std::string{class_.GetModule()}, .name = std::string{class_.GetName()}};
-
-        if (const auto found = cache.find(id); found != cache.end()) {
-            return found->second;
-        }
-
-        return class_.GetRegisteredAlignment().or_else([&]() {
-            int base_alignment = 0;
-
-            if (class_.m_pBaseClasses != nullptr) {
-                if (const auto maybe_base_alignment = GetClassAlignmentRecursive(cache, *class_.m_pBaseClasses->m_pClass)) {
-                    base_alignment = maybe_base_alignment.value();
-                } else {
-                    // we have a base class, but it has unknown alignment
-                    return cache.emplace(id, std::nullopt).first->second;
+    [[nodiscard]] std::optional<int> GetClassAlignmentRecursive(sdk::ConcurrentTypeMemo<snapshot::Class, std::optional<int>>& cache,
+                                                                const snapshot::Snapshot& schema, const snapshot::Class& class_) {
+        return cache.GetOrCompute(class_, [&]() {
+            return class_.registered_alignment.or_else([&]() -> std::optional<int> {
+                int base_alignment = 0;
+
+                if (class_.base_class != snapshot::kNone) {
+                    if (const auto maybe_base_alignment = GetClassAlignmentRecursive(cache, schema, schema.classes[class_.base_class])) {
+                        base_alignment = maybe_base_alignment.value();
+                    } else {
+                        // we have a base class, but it has unknown alignment
+                        return std::nullopt;
+                    }
                 }
-            }
 
-            auto field_alignments = class_.GetFields() | std::ranges::views::transform([&](const SchemaClassFieldData_t& e) {
-                                        if (const auto* e_class = e.m_pSchemaType->GetAsDeclaredClass(); e_class != nullptr) {
-                                            return GetClassAlignmentRecursive(cache, *e_class->m_pClassInfo);
-                                        } else {
-                                            return e.m_pSchemaType->GetSizeAndAlignment().and_then([](const auto& e) { return std::get<1>(e); });
-                                        }
-                                    });
-
-            if (field_alignments.empty()) {
-                // This is an empty class. The generator will add a single pad with alignment 1.
-                return cache.emplace(id, std::make_optional((base_alignment == 0) ? 1 : base_alignment)).first->second;
-            } else if (std::ranges::all_of(field_alignments, &std::optional<int>::has_value)) {
-                int max_alignment = base_alignment;
-                for (const auto& e : field_alignments) {
-                    max_alignment = std::max(max_alignment, e.value());
+                auto field_alignments = class_.fields | std::ranges::views::transform([&](const snapshot::Field& e) -> std::optional<int> {
+                                            const auto& type = schema.types[e.type];
+                                            if (type.category == ETypeCategory::Schema_DeclaredClass) {
+                                                // Classes without class info have unknown alignment
+                                                return (type.declared_class == snapshot::kNone) ?
+                                                           std::nullopt :
+                                                           GetClassAlignmentRecursive(cache, schema, schema.classes[type.declared_class]);
+                                            } else {
+                                                return type.alignment;
+                                            }
+                                        });
+
+                if (field_alignments.empty()) {
+                    // This is an empty class. The generator will add a single pad with alignment 1.
+                    return std::make_optional((base_alignment == 0) ? 1 : base_alignment);
+                } else if (std::ranges::all_of(field_alignments, &std::optional<int>::has_value)) {
+                    int max_alignment = base_alignment;
+                    for (const auto& e : field_alignments) {
+                        max_alignment = std::max(max_alignment, e.value());
+                    }
+                    return std::make_optional(max_alignment);
+                } else {
+                    // there are fields with unknown alignment
+                    return std::nullopt;
                 }
-                return cache.emplace(id, std::make_optional(max_alignment)).first->second;
-            } else {
-                // there are fields with unknown alignment
-                return cache.emplace(id, std::nullopt).first->second;
-            }
+            });
         });
     }
 
     /// @return For class types, returns @ref GetClassAlignmentRecursive(). Otherwise returns the immediately available size.
     [[nodiscard]]
-    std::optional<int> GetAlignmentOfTypeRecursive(std::map<sdk::TypeIdentifier, std::optional<int>>& cache, const CSchemaType& type) {
-        if (const auto* class_ = type.GetAsDeclaredClass(); class_ != nullptr && class_->m_pClassInfo != nullptr) {
-            return GetClassAlignmentRecursive(cache, *class_->m_pClassInfo);
+    std::optional<int> GetAlignmentOfTypeRecursive(sdk::ConcurrentTypeMemo<snapshot::Class, std::optional<int>>& cache,
+                                                   const snapshot::Snapshot& schema, const snapshot::Type& type) {
+        if (type.declared_class != snapshot::kNone) {
+            return GetClassAlignmentRecursive(cache, schema, schema.classes[type.declared_class]);
         } else {
-            return type.GetSizeAndAlignment().and_then([](const auto& e) { return std::get<1>(e); });
+            return type.alignment;
         }
     }
 
     [[nodiscard]]
-    codegen::TypeCategory GetTypeCategory(const SchemaClassFieldData_t& field) {
+    codegen::TypeCategory GetTypeCategory(const snapshot::Snapshot& schema, const snapshot::Field& field) {
         using enum codegen::TypeCategory;
 
+        const auto& type = schema.types[field.type];
+
         // these cases and sub-cases aren't exactly correct, but they do the job.
         // we can improve the classification when we need more details.
-        switch (field.m_pSchemaType->GetTypeCategory()) {
+        switch (type.category) {
         case ETypeCategory::Schema_DeclaredEnum:
             return enum_;
         case ETypeCategory::Schema_DeclaredClass:
             return class_or_struct;
         case ETypeCategory::Schema_FixedArray: {
-            auto* schema = reinterpret_cast<const CSchemaType_FixedArray*>(field.m_pSchemaType);
-            switch (schema->m_pElementType->m_unTypeCategory) {
+            switch (schema.types[type.element_type].category) {
             case ETypeCategory::Schema_DeclaredEnum:
                 return enum_;
             case ETypeCategory::Schema_DeclaredClass:
@@ -327,9 +215,9 @@ namespace {
             }
         }
         case ETypeCategory::Schema_Ptr: {
-            if (const auto ref_class = field.m_pSchemaType->GetRefClass(); ref_class != nullptr) {
+            if (type.pointee != snapshot::kNone) {
                 // there are only pointers to structs/classes in source2, not to enums
-                if (ref_class->GetTypeCategory() == ETypeCategory::Schema_DeclaredClass) {
+                if (schema.types[type.pointee].category == ETypeCategory::Schema_DeclaredClass) {
                     return class_or_struct;
                 }
             }
@@ -340,116 +228,100 @@ namespace {
         }
     }
 
-    void PrintClassInfo(sdk::GeneratorCache& cache, codegen::IGenerator::self_ref generator, const CSchemaClassBinding& class_) {
-        generator.comment(std::format("Registered alignment: {}", class_.GetRegisteredAlignment().transform(&util::to_hex_string).value_or("unknown")));
-        generator.comment(
-            std::format("Alignment: {}", GetClassAlignmentRecursive(cache.class_alignment, class_).transform(&util::to_hex_string).value_or("unknown")));
-        generator.comment(std::format("Standard-layout class: {}", IsStandardLayoutClass(cache.class_has_standard_layout, class_)));
-        generator.comment(std::format("Size: {:#x}", class_.m_nSizeOf));
-
-        if ((class_.m_nClassFlags & SCHEMA_CF1_HAS_VIRTUAL_MEMBERS) != 0) // @note: @og: its means that class probably does have vtable
+    template <std::derived_from<codegen::IGenerator> Generator>
+    void PrintClassInfo(sdk::GeneratorCache& cache, Generator& generator, const snapshot::Snapshot& schema,
+                        const snapshot::Class& class_) {
+        generator.comment(std::format("Registered alignment: {}", class_.registered_alignment.transform(&util::to_hex_string).value_or("unknown")));
+        generator.comment(std::format("Alignment: {}", GetClassAlignmentRecursive(cache.class_alignment, schema, class_)
+                                                           .transform(&util::to_hex_string)
+                                                           .value_or("unknown")));
+        generator.comment(std::format("Standard-layout class: {}", IsStandardLayoutClass(cache.class_has_standard_layout, schema, class_)));
+        generator.comment(std::format("Size: {:#x}", class_.size));
+
+        if ((class_.flags & SCHEMA_CF1_HAS_VIRTUAL_MEMBERS) != 0) // @note: @og: its means that class probably does have vtable
             generator.comment("Has VTable");
-        if ((class_.m_nClassFlags & SCHEMA_CF1_IS_ABSTRACT) != 0)
+        if ((class_.flags & SCHEMA_CF1_IS_ABSTRACT) != 0)
             generator.comment("Is Abstract");
-        if ((class_.m_nClassFlags & SCHEMA_CF1_HAS_TRIVIAL_CONSTRUCTOR) != 0)
+        if ((class_.flags & SCHEMA_CF1_HAS_TRIVIAL_CONSTRUCTOR) != 0)
             generator.comment("Has Trivial Constructor");
-        if ((class_.m_nClassFlags & SCHEMA_CF1_HAS_TRIVIAL_DESTRUCTOR) != 0)
+        if ((class_.flags & SCHEMA_CF1_HAS_TRIVIAL_DESTRUCTOR) != 0)
             generator.comment("Has Trivial Destructor");
 
 #if defined(CS2) || defined(DOTA2)
-        if ((class_.m_nClassFlags & SCHEMA_CF1_CONSTRUCT_ALLOWED) != 0)
+        if ((class_.flags & SCHEMA_CF1_CONSTRUCT_ALLOWED) != 0)
             generator.comment("Construct allowed");
-        if ((class_.m_nClassFlags & SCHEMA_CF1_CONSTRUCT_DISALLOWED) != 0)
+        if ((class_.flags & SCHEMA_CF1_CONSTRUCT_DISALLOWED) != 0)
             generator.comment("Construct disallowed");
-        if ((class_.m_nClassFlags & SCHEMA_CF1_INFO_TAG_MConstructibleClassBase) != 0)
+        if ((class_.flags & SCHEMA_CF1_INFO_TAG_MConstructibleClassBase) != 0)
             generator.comment("MConstructibleClassBase");
-        if ((class_.m_nClassFlags & SCHEMA_CF1_INFO_TAG_MClassHasCustomAlignedNewDelete) != 0)
+        if ((class_.flags & SCHEMA_CF1_INFO_TAG_MClassHasCustomAlignedNewDelete) != 0)
             generator.comment("MClassHasCustomAlignedNewDelete");
-        if ((class_.m_nClassFlags & SCHEMA_CF1_INFO_TAG_MClassHasEntityLimitedDataDesc) != 0)
+        if ((class_.flags & SCHEMA_CF1_INFO_TAG_MClassHasEntityLimitedDataDesc) != 0)
             generator.comment("MClassHasEntityLimitedDataDesc");
-        if ((class_.m_nClassFlags & SCHEMA_CF1_INFO_TAG_MDisableDataDescValidation) != 0)
+        if ((class_.flags & SCHEMA_CF1_INFO_TAG_MDisableDataDescValidation) != 0)
             generator.comment("MDisableDataDescValidation");
-        if ((class_.m_nClassFlags & SCHEMA_CF1_INFO_TAG_MIgnoreTypeScopeMetaChecks) != 0)
+        if ((class_.flags & SCHEMA_CF1_INFO_TAG_MIgnoreTypeScopeMetaChecks) != 0)
             generator.comment("MIgnoreTypeScopeMetaChecks");
-        if ((class_.m_nClassFlags & SCHEMA_CF1_INFO_TAG_MNetworkNoBase) != 0)
+        if ((class_.flags & SCHEMA_CF1_INFO_TAG_MNetworkNoBase) != 0)
             generator.comment("MNetworkNoBase");
-        if ((class_.m_nClassFlags & SCHEMA_CF1_INFO_TAG_MNetworkAssumeNotNetworkable) != 0)
+        if ((class_.flags & SCHEMA_CF1_INFO_TAG_MNetworkAssumeNotNetworkable) != 0)
             generator.comment("MNetworkAssumeNotNetworkable");
 #endif
 
-        if (class_.m_nStaticMetadataSize > 0)
+        if (!class_.static_metadata.empty())
             generator.comment("");
 
-        for (const auto& metadata : class_.GetStaticMetadata()) {
-            if (const auto value = GetMetadataValue(metadata); !value.empty())
-                generator.comment(std::format("static metadata: {} \"{}\"", metadata.m_szName, value));
+        for (const auto& metadata : class_.static_metadata) {
+            if (!metadata.value.empty())
+                generator.comment(std::format("static metadata: {} \"{}\"", metadata.name, metadata.value));
             else
-                generator.comment(std::format("static metadata: {}", metadata.m_szName));
+                generator.comment(std::format("static metadata: {}", metadata.name));
         }
     }
 
-    void PrintEnumInfo(codegen::IGenerator::self_ref generator, const CSchemaEnumBinding& enum_binding) {
-        generator.comment(std::format("Enumerator count: {}", enum_binding.m_nEnumeratorCount))
-            .comment(std::format("Alignment: {}", enum_binding.m_unAlignOf))
-            .comment(std::format("Size: {:#x}", enum_binding.m_unSizeOf));
+    template <std::derived_from<codegen::IGenerator> Generator>
+    void PrintEnumInfo(Generator& generator, const snapshot::Enum& enum_) {
+        generator.comment(std::format("Enumerator count: {}", enum_.enumerators.size()))
+            .comment(std::format("Alignment: {}", enum_.alignment))
+            .comment(std::format("Size: {:#x}", enum_.size));
 
-        if (enum_binding.m_nStaticMetadataSize > 0)
+        if (!enum_.static_metadata.empty())
             generator.comment("");
 
-        for (const auto& metadata : enum_binding.GetStaticMetadata()) {
-            generator.comment(std::format("metadata: {}", metadata.m_szName));
+        for (const auto& metadata : enum_.static_metadata) {
+            generator.comment(std::format("metadata: {}", metadata.name));
         }
     }
 
-    void AssembleEnum(codegen::IGenerator::self_ref generator, const CSchemaEnumBinding& schema_enum_binding) {
+    template <std::derived_from<codegen::IGenerator> Generator>
+    void AssembleEnum(Generator& generator, const snapshot::Enum& enum_) {
         // @note: @es3n1n: get type name by align size
         //
-        const auto underlying_type_name = generator.get_uint(schema_enum_binding.m_unAlignOf * 8);
+        const auto underlying_type_name = generator.get_uint(enum_.alignment * 8);
 
         // @note: @es3n1n: print meta info
         //
-        PrintEnumInfo(generator, schema_enum_binding);
+        PrintEnumInfo(generator, enum_);
 
         // @note: @es3n1n: begin enum class
         //
-        generator.begin_enum(schema_enum_binding.m_pszName, underlying_type_name);
-
-        // @note: @og: build max based on numeric_limits of unAlignOf
-        //
-        const auto print_enum_item = [schema_enum_binding, &generator](const SchemaEnumeratorInfoData_t& field) {
-            switch (schema_enum_binding.m_unAlignOf) {
-            case 1:
-                generator.enum_item(field.m_szName, field.m_uint8);
-                break;
-            case 2:
-                generator.enum_item(field.m_szName, field.m_uint16);
-                break;
-            case 4:
-                generator.enum_item(field.m_szName, field.m_uint32);
-                break;
-            case 8:
-                generator.enum_item(field.m_szName, field.m_uint64);
-                break;
-            default:
-                generator.enum_item(field.m_szName, field.m_uint64);
-            }
-        };
+        generator.begin_enum(enum_.name, underlying_type_name);
 
         // @note: @es3n1n: assemble enum items
         //
-        for (const auto& field : schema_enum_binding.GetEnumeratorValues()) {
+        for (const auto& enumerator : enum_.enumerators) {
             // @note: @og: dump enum metadata
             //
-            for (auto j = 0; j < field.m_nMetadataSize; j++) {
-                auto field_metadata = field.m_pMetadata[j];
-
-                if (auto data = GetMetadataValue(field_metadata); data.empty())
-                    generator.comment(field_metadata.m_szName);
+            for (const auto& metadata : enumerator.metadata) {
+                if (metadata.value.empty())
+                    generator.comment(metadata.name);
                 else
-                    generator.comment(std::format("{} \"{}\"", field_metadata.m_szName, data));
+                    generator.comment(std::format("{} \"{}\"", metadata.name, metadata.value));
             }
 
-            print_enum_item(field);
+            // @note: @og: the value has already been truncated to the enum's alignment
+            //
+            generator.enum_item(enumerator.name, enumerator.value);
         }
 
         // @note: @es3n1n: we are done with this enum
@@ -458,22 +330,21 @@ namespace {
     }
 
     /// @return {type_name, array_sizes}
-    std::pair<std::string, std::vector<std::size_t>> ParseArray(const CSchemaType& type) {
-        const auto* ptr = type.GetRefClass();
-        const auto& actual_type = ptr ? *ptr : type;
+    std::pair<std::string, std::vector<std::size_t>> ParseArray(const snapshot::Snapshot& schema, const snapshot::Type& type) {
+        const auto& actual_type = (type.pointee != snapshot::kNone) ? schema.types[type.pointee] : type;
 
         std::string base_type;
         std::vector<std::size_t> sizes;
 
-        if (actual_type.GetTypeCategory() == ETypeCategory::Schema_FixedArray) {
+        if (actual_type.category == ETypeCategory::Schema_FixedArray) {
             // dump all sizes.
-            auto* schema = reinterpret_cast<const CSchemaType_FixedArray*>(&actual_type);
+            const auto* array = &actual_type;
             while (true) {
-                sizes.emplace_back(schema->m_nElementCount);
-                schema = reinterpret_cast<const CSchemaType_FixedArray*>(schema->m_pElementType);
+                sizes.emplace_back(array->element_count);
+                array = &schema.types[array->element_type];
 
-                if (schema->GetTypeCategory() != ETypeCategory::Schema_FixedArray) {
-                    base_type = schema->m_pszName;
+                if (array->category != ETypeCategory::Schema_FixedArray) {
+                    base_type = array->name;
                     break;
                 }
             }
@@ -497,25 +368,23 @@ namespace {
         return type_name;
     }
 
-    /// @return @ref std::nullopt if the type is not contained in a module visible in @p scope
-    std::optional<std::string> GetModuleOfTypeInScope(const CSchemaSystemTypeScope& scope, std::string_view type_name) {
+    /// @return @ref std::nullopt if the type is not contained in a module visible in @p scope. Lifetime bound to @p scope.
+    std::optional<std::string_view> GetModuleOfTypeInScope(const snapshot::Scope& scope, std::string_view type_name) {
         assert((DecayTypeName(type_name) == type_name) &&
                "you need to decay your type names before using them for lookups. you probably need to decay them anyway if you intend to you them for "
                "anything really, so do it before calling this function.");
 
-        if (const auto* class_ = scope.FindDeclaredClass(std::string{type_name})) {
-            return class_->m_pszModule;
-        } else if (const auto* enum_ = scope.FindDeclaredEnum(std::string{type_name})) {
-            return enum_->m_pszModule;
+        if (const auto found = scope.declared_types.find(type_name); found != scope.declared_types.end()) {
+            return found->second;
         } else {
             return std::nullopt;
         }
     }
 
     /// @return @ref std::nullopt if the type is not contained in a module visible in its scope, e.g. because it is a built-in type
-    std::optional<std::string> GetModuleOfType(const CSchemaType& type) {
-        if (type.m_pTypeScope != nullptr) {
-            return GetModuleOfTypeInScope(*type.m_pTypeScope, DecayTypeName(type.m_pszName));
+    std::optional<std::string_view> GetModuleOfType(const snapshot::Snapshot& schema, const snapshot::Type& type) {
+        if (type.scope != snapshot::kNone) {
+            return GetModuleOfTypeInScope(schema.scopes[type.scope], DecayTypeName(type.name));
         } else {
             return std::nullopt;
         }
@@ -533,7 +402,7 @@ namespace {
     }
 
     /// Adds the module specifier to @p type_name, if @p type_name is declared in @p scope. Otherwise returns @p type_name unmodified.
-    std::string MaybeWithModuleName(const codegen::IGenerator& generator, const CSchemaSystemTypeScope& scope, const std::string_view type_name) {
+    std::string MaybeWithModuleName(const codegen::IGenerator& generator, const snapshot::Scope& scope, const std::string_view type_name) {
         const auto escaped_type_name = EscapeTypeName(generator, type_name);
         return GetModuleOfTypeInScope(scope, type_name)
             .transform([&](const auto module_name) { return std::format("source2sdk::{}::{}", module_name, escaped_type_name); })
@@ -587,33 +456,40 @@ namespace {
         return split_trim(type_name, "<,>");
     }
 
-    /// e.g. "HashMap<int, CUtlVector<float>>" -> ["HashMap", "int", "CUtlVector", "float"]
-    /// @return An empty list if @p type_name is not a template or has no template parameters
-    [[nodiscard]]
-    std::vector<std::string> ParseTemplateRecursive(std::string_view type_name) {
-        std::vector<std::string> result{};
-
-        // remove the topmost type and all syntax entries
-        for (const auto& el : DecomposeTemplate(type_name)) {
-            if (std::holds_alternative<std::string>(el)) {
-                result.emplace_back(std::get<std::string>(el));
-            }
-        }
-
-        return result;
+    /// Generators are reused for every file a thread generates, so their buffers and containers keep their capacity
+    /// @return A generator in its initial state. Valid until the next call on the same thread.
+    template <std::derived_from<codegen::IGenerator> Generator>
+    Generator& AcquireGenerator() {
+        thread_local Generator generator{};
+        generator.reset();
+        return generator;
     }
 
-    std::unique_ptr<codegen::IGenerator> GetGeneratorForLanguage(source2_gen::Language language) {
+    /// Calls @p fn with the generator of @p language. @p fn is instantiated for every generator type, so the code it assembles is emitted
+    /// without virtual calls.
+    template <typename Fn>
+    decltype(auto) VisitGenerator(source2_gen::Language language, Fn&& fn) {
         switch (language) {
         case source2_gen::Language::cpp:
-            return std::make_unique<codegen::generator_cpp_t>();
+            return std::forward<Fn>(fn)(AcquireGenerator<codegen::generator_cpp_t>());
         case source2_gen::Language::c:
-            return std::make_unique<codegen::generator_c_t>();
+            return std::forward<Fn>(fn)(AcquireGenerator<codegen::generator_c_t>());
         case source2_gen::Language::c_ida:
             // c-ida uses the c generator.
-            // generator options are adjusted by Dump()
+            // generator options are adjusted by GetEmitTargets()
             // postprocessing happens in PostProcessCIDA()
-            return std::make_unique<codegen::generator_c_t>();
+            return std::forward<Fn>(fn)(AcquireGenerator<codegen::generator_c_t>());
+        case source2_gen::Language::cpp_modules:
+            // types are assembled into module interface units by AssembleModuleUnits()
+            return std::forward<Fn>(fn)(AcquireGenerator<codegen::generator_cpp_modules_t>());
+        case source2_gen::Language::cpp_offsets:
+            return std::forward<Fn>(fn)(AcquireGenerator<codegen::generator_cpp_offsets_t>());
+        case source2_gen::Language::schema_bin:
+            // doesn't generate types, see WriteSchemaBinary()
+            break;
+        case source2_gen::Language::json:
+            // doesn't generate types, see WriteJsonSchema()
+            break;
         }
 
         assert(false && "unhandled enumerator");
@@ -621,7 +497,7 @@ namespace {
     }
 
     /// Adds module qualifiers and resolves built-in types.
-    std::string ReassembleRetypedTemplate(const codegen::IGenerator& generator, const CSchemaSystemTypeScope& scope,
+    std::string ReassembleRetypedTemplate(const codegen::IGenerator& generator, const snapshot::Scope& scope,
                                           const std::vector<std::variant<std::string, char>>& decomposed) {
         std::string result{};
 
@@ -648,19 +524,20 @@ namespace {
         return result;
     }
 
-    /// @return {type_name, array_sizes} where type_name is a fully qualified name
-    std::pair<std::string, std::vector<std::size_t>> GetType(const codegen::IGenerator& generator, const CSchemaType& type) {
-        const auto [type_name, array_sizes] = ParseArray(type);
-
-        assert(type_name.empty() == array_sizes.empty());
+    /// @param cache Resolved types of the language of @p generator
+    /// @return Lifetime bound to @p cache
+    const sdk::ResolvedType& GetType(sdk::ConcurrentTypeMemo<snapshot::Type, sdk::ResolvedType>& cache, const codegen::IGenerator& generator,
+                                     const snapshot::Snapshot& schema, const snapshot::Type& type) {
+        return cache.GetOrCompute(type, [&]() {
+            auto [type_name, array_sizes] = ParseArray(schema, type);
 
-        const auto type_name_with_modules =
-            ReassembleRetypedTemplate(generator, *type.m_pTypeScope, DecomposeTemplate(type_name.empty() ? type.m_pszName : type_name));
+            assert(type_name.empty() == array_sizes.empty());
 
-        if (!type_name.empty() && !array_sizes.empty())
-            return {type_name_with_modules, array_sizes};
-
-        return {type_name_with_modules, {}};
+            return sdk::ResolvedType{
+                .name = ReassembleRetypedTemplate(generator, GetScope(schema, type.scope), DecomposeTemplate(type_name.empty() ? type.name : type_name)),
+                .array_sizes = std::move(array_sizes),
+            };
+        });
     }
 
     // We assume that everything that is not a pointer is odr-used.
@@ -672,58 +549,85 @@ namespace {
     }
 
     /// @return All names used by @p type. Returns multiple names for template
-    /// types.
+    /// types. Lifetime bound to @p cache.
+    /// @param non_odr_templates See @ref source2_gen::Options::non_odr_templates. Must be the same for every call with the same @p cache.
     [[nodiscard]]
-    std::set<NameLookup> GetRequiredNamesForType(const CSchemaType& type) {
-        // m_pTypeScope can be nullptr for built-in types
-        if (type.m_pTypeScope != nullptr) {
+    const std::set<NameLookup>& GetRequiredNamesForType(sdk::ConcurrentTypeMemo<snapshot::Type, std::set<NameLookup>>& cache,
+                                                        const std::set<std::string, std::less<>>& non_odr_templates, const snapshot::Snapshot& schema,
+                                                        const snapshot::Type& type) {
+        return cache.GetOrCompute(type, [&]() -> std::set<NameLookup> {
+            // built-in types don't have a scope
+            if (type.scope == snapshot::kNone) {
+                return {};
+            }
+
             std::set<NameLookup> result{};
 
-            const auto destructured = ParseTemplateRecursive(type.m_pszName);
+            const auto decomposed = DecomposeTemplate(type.name);
+
+            // Some template types don't odr-use their template arguments during their declaration, think std::unique_ptr.
+            // Their arguments only need to be forward-declared, which also breaks dependency cycles.
+            // There's no foolproof way to detect those template types, they are configured in sdk-static.toml.
+            // Templates whose arguments are being parsed, innermost last
+            std::vector<std::string_view> enclosing_templates{};
+            std::string_view previous_type_name{};
+
+            for (const auto& el : decomposed) {
+                if (const auto* syntax = std::get_if<char>(&el)) {
+                    if (*syntax == '<') {
+                        enclosing_templates.emplace_back(previous_type_name);
+                    } else if ((*syntax == '>') && !enclosing_templates.empty()) {
+                        enclosing_templates.pop_back();
+                    }
 
-            // This is a slight hack to break dependency cycles. Some template types don't odr-use
-            // their template arguments during their declaration, think std::unique_ptr.
-            // There's no foolproof way to detect those template types, so we're hardcoding the ones that are
-            // known to cause circular dependencies.
-            static std::unordered_set<std::string_view> non_odr_containers{"CHandle"};
-            bool is_used_in_non_odr_container = false;
+                    continue;
+                }
 
-            for (const auto& dirty_type_name : destructured) {
+                const auto& dirty_type_name = std::get<std::string>(el);
                 const auto type_name = DecayTypeName(dirty_type_name);
+                const bool is_used_in_non_odr_template = !enclosing_templates.empty() && non_odr_templates.contains(enclosing_templates.back());
 
-                if (auto module{GetModuleOfTypeInScope(*type.m_pTypeScope, type_name)}) {
+                if (auto module{GetModuleOfTypeInScope(schema.scopes[type.scope], type_name)}) {
                     const auto source =
-                        (!is_used_in_non_odr_container && IsOdrUse(dirty_type_name)) ? NameSource::include : NameSource::forward_declaration;
+                        (!is_used_in_non_odr_template && IsOdrUse(dirty_type_name)) ? NameSource::include : NameSource::forward_declaration;
 
-                    result.emplace(NameLookup{.module = std::move(module.value()), .type_name = std::string{type_name}, .source = source});
+                    result.emplace(NameLookup{.module = std::string{module.value()}, .type_name = std::string{type_name}, .source = source});
                 }
 
-                is_used_in_non_odr_container = non_odr_containers.contains(type_name);
+                previous_type_name = type_name;
             }
 
             return result;
-        } else {
-            return {};
-        }
+        });
     }
 
     /// @return All names that are required to define @p classes
-    std::set<NameLookup> GetRequiredNamesForClass(const CSchemaClassBinding& class_) {
+    /// @param non_odr_templates See @ref GetRequiredNamesForType()
+    std::set<NameLookup> GetRequiredNamesForClass(sdk::ConcurrentTypeMemo<snapshot::Type, std::set<NameLookup>>& cache,
+                                                  const std::set<std::string, std::less<>>& non_odr_templates, const snapshot::Snapshot& schema,
+                                                  const snapshot::Class& class_) {
         std::set<NameLookup> result{};
 
-        for (const auto& field : std::span{class_.m_pFields, static_cast<std::size_t>(class_.m_nFieldSize)}) {
-            const auto names = GetRequiredNamesForType(*field.m_pSchemaType);
+        for (const auto& field : class_.fields) {
+            const auto& names = GetRequiredNamesForType(cache, non_odr_templates, schema, schema.types[field.type]);
+            result.insert(names.begin(), names.end());
+        }
+
+        for (const auto& field : class_.static_fields) {
+            const auto& names = GetRequiredNamesForType(cache, non_odr_templates, schema, schema.types[field.type]);
             result.insert(names.begin(), names.end());
         }
 
-        if (const auto* base_classes = class_.m_pBaseClasses; base_classes != nullptr) {
-            assert(base_classes->m_pClass->m_pSchemaType != nullptr && "didn't think this could happen, feel free to touch");
-            // source2gen doesn't support multiple inheritance, only check class[0]
-            const auto includes = GetRequiredNamesForType(*base_classes[0].m_pClass->m_pSchemaType);
+        if (class_.base_class != snapshot::kNone) {
+            const auto& base_class = schema.classes[class_.base_class];
+            assert(base_class.self_type != snapshot::kNone && "didn't think this could happen, feel free to touch");
+            // source2gen doesn't support multiple inheritance, the snapshot only contains class[0]
+            const auto& includes = GetRequiredNamesForType(cache, non_odr_templates, schema, schema.types[base_class.self_type]);
             result.insert(includes.begin(), includes.end());
         }
 
-        const auto is_self = [self_module{GetModuleOfType(*class_.m_pSchemaType).value()}, self_type_name{class_.GetName()}](const auto& that) {
+        const auto is_self = [self_module{GetModuleOfType(schema, schema.types[class_.self_type]).value()},
+                              self_type_name{std::string_view{class_.name}}](const auto& that) {
             return (that.module == self_module) && (that.type_name == self_type_name);
         };
 
@@ -735,8 +639,9 @@ namespace {
         return result;
     }
 
+    template <std::derived_from<codegen::IGenerator> Generator>
     [[nodiscard]]
-    ClassAssemblyState AssembleBitfield(codegen::IGenerator& generator, ClassAssemblyState&& state) {
+    ClassAssemblyState AssembleBitfield(Generator& generator, ClassAssemblyState&& state) {
         state.assembling_bitfield = false;
 
         std::size_t exact_bitfield_size_bits = 0;
@@ -749,10 +654,10 @@ namespace {
 
         for (const auto& entry : state.bitfield) {
             for (const auto& field_metadata : entry.metadata) {
-                if (auto data = GetMetadataValue(field_metadata); data.empty())
-                    generator.comment(std::format("metadata: {}", field_metadata.m_szName));
+                if (field_metadata.value.empty())
+                    generator.comment(std::format("metadata: {}", field_metadata.name));
                 else
-                    generator.comment(std::format("metadata: {} \"{}\"", field_metadata.m_szName, data));
+                    generator.comment(std::format("metadata: {} \"{}\"", field_metadata.name, field_metadata.value));
             }
 
             generator.prop(codegen::Prop{.type_name = type_name, .name = entry.name, .bitfield_size = entry.size}, true);
@@ -769,7 +674,8 @@ namespace {
     }
 
     /// Does not insert a pad if it would have size 0
-    void InsertPadUntil(codegen::IGenerator::self_ref generator, const ClassAssemblyState& state, std::int32_t offset, bool verbose) {
+    template <std::derived_from<codegen::IGenerator> Generator>
+    void InsertPadUntil(Generator& generator, const ClassAssemblyState& state, std::int32_t offset, bool verbose) {
         if (verbose) {
             generator.comment(std::format("last_field_offset={} last_field_size={}",
                                           state.last_field_offset.transform(&util::to_hex_string).value_or("none"),
@@ -793,8 +699,66 @@ namespace {
         }
     }
 
-    void AssembleClass(const source2_gen::Options& options, sdk::GeneratorCache& cache, codegen::IGenerator::self_ref generator,
-                       const CSchemaClassBinding& class_) {
+    /// Emits a getter for every static field of @p class_ and ResolveStaticFields(), which calls all of them. Getters look their field up on the
+    /// first call only, ResolveStaticFields() can be used to do that ahead of time.
+    template <std::derived_from<codegen::IGenerator> Generator>
+    void AssembleStaticFields(const sdk::EmitTarget& target, sdk::GeneratorCache& cache, Generator& generator, const snapshot::Snapshot& schema,
+                              const snapshot::Class& class_) {
+        std::vector<std::string_view> getters{};
+
+        for (std::size_t i = 0; i < class_.static_fields.size(); ++i) {
+            const auto& field = class_.static_fields[i];
+            const auto& type = GetType(cache.resolved_types[std::to_underlying(target.language)], generator, schema, schema.types[field.type]);
+
+            for (const auto& field_metadata : field.metadata) {
+                if (field_metadata.value.empty())
+                    generator.comment(std::format("metadata: {}", field_metadata.name));
+                else
+                    generator.comment(std::format("metadata: {} \"{}\"", field_metadata.name, field_metadata.value));
+            }
+
+            if (!type.array_sizes.empty()) {
+                generator.comment(std::format("Skipped static field \"{}\", functions can't return arrays", field.name));
+                continue;
+            }
+
+            generator.static_field_getter(type.name, field.name, GetScope(schema, class_.scope).name, class_.name, i);
+            getters.emplace_back(field.name);
+        }
+
+        generator.next_line();
+        generator.comment("Looks up all static fields, so their getters don't have to");
+        generator.begin_function("static ", "void", "ResolveStaticFields");
+
+        for (const auto getter : getters) {
+            generator.statement(std::format("(void)Get_{}()", getter));
+        }
+
+        generator.end_function();
+    }
+
+    /// Source2 sometimes describes fields of the base class in the derived class, we don't know how to lay those out. If the first field of
+    /// @p class_ lies inside its base class, the fields up to the end of the base class are skipped, see @ref IsSkippedField().
+    /// @return End of the base class if fields are skipped, 0 otherwise
+    [[nodiscard]] std::ptrdiff_t GetCollisionEndOffset(const snapshot::Snapshot& schema, const snapshot::Class& class_) {
+        if ((class_.base_class == snapshot::kNone) || class_.fields.empty()) {
+            return 0;
+        }
+
+        const auto parent_class_size = schema.classes[class_.base_class].size;
+        return (class_.fields.front().offset < parent_class_size) ? parent_class_size : 0;
+    }
+
+    /// Skipped fields are neither emitted as members nor asserted
+    /// @param collision_end_offset See @ref GetCollisionEndOffset()
+    [[nodiscard]] bool IsSkippedField(std::ptrdiff_t collision_end_offset, const snapshot::Field& field) {
+        // @fixme: @es3n1n: todo proper collision fix and remove this block
+        return (collision_end_offset != 0) && (field.offset < collision_end_offset);
+    }
+
+    template <std::derived_from<codegen::IGenerator> Generator>
+    void AssembleClass(const sdk::EmitTarget& target, sdk::GeneratorCache& cache, Generator& generator,
+                       const snapshot::Snapshot& schema, const snapshot::Class& class_) {
         static constexpr std::size_t source2_max_align = 8;
 
         // TODO: when we have a CLI parser: pass this property in from the outside
@@ -808,12 +772,12 @@ namespace {
 
         // @note: @es3n1n: get class info, assemble it
         //
-        const auto* class_parent = class_.m_pBaseClasses ? class_.m_pBaseClasses->m_pClass : nullptr;
-        const auto class_size = class_.GetSize();
-        const auto class_alignment = GetClassAlignmentRecursive(cache.class_alignment, class_);
+        const auto* class_parent = (class_.base_class != snapshot::kNone) ? &schema.classes[class_.base_class] : nullptr;
+        const auto class_size = class_.size;
+        const auto class_alignment = GetClassAlignmentRecursive(cache.class_alignment, schema, class_);
         // Source2 has alignof(max_align_t)=8, i.e. every class whose size is a multiple of 8 is aligned.
         const auto class_is_aligned = (class_size % class_alignment.value_or(source2_max_align)) == 0;
-        const auto is_struct = util::IsStruct(class_.m_pszName);
+        const auto is_struct = util::IsStruct(class_.name);
 
         if (!class_is_aligned) {
             const auto warning = [&]() {
@@ -821,28 +785,28 @@ namespace {
                     // ceil size to next possible aligned size
                     const auto aligned_size = class_size + (class_alignment.value() - (class_size % class_alignment.value())) % class_alignment.value();
 
-                    return std::format("Type {} is misaligned. Its size should be {:#x}, but with proper alignment it has size {:#x}.", class_.GetName(),
+                    return std::format("Type {} is misaligned. Its size should be {:#x}, but with proper alignment it has size {:#x}.", class_.name,
                                        class_size, aligned_size);
                 } else {
                     return std::format("Type {} appears to be misaligned. Its alignment is unknown and it is not aligned to max_align_t ({}).",
-                                       class_.GetName(), source2_max_align);
+                                       class_.name, source2_max_align);
                 }
             }();
             warn(warning);
             generator.comment(warning);
             generator.comment("It has been replaced by a dummy. You can try uncommenting the struct below.");
-            generator.begin_struct(class_.GetName());
+            generator.begin_struct(class_.name);
             generator.struct_padding(codegen::Padding{.pad_offset = 0, .size = codegen::Padding::Bytes{static_cast<std::size_t>(class_size)}}, false);
             generator.end_struct();
         }
 
-        PrintClassInfo(cache, generator, class_);
+        PrintClassInfo(cache, generator, schema, class_);
 
         // @note: @es3n1n: get parent name
         //
         const std::string parent_class_name =
-            (class_parent != nullptr) ? MaybeWithModuleName(generator, *class_parent->m_pTypeScope, class_parent->m_pszName) : "";
-        const std::optional<std::ptrdiff_t> parent_class_size = class_parent ? std::make_optional(class_parent->m_nSizeOf) : std::nullopt;
+            (class_parent != nullptr) ? MaybeWithModuleName(generator, GetScope(schema, class_parent->scope), class_parent->name) : "";
+        const std::optional<std::ptrdiff_t> parent_class_size = class_parent ? std::make_optional(class_parent->size) : std::nullopt;
 
         if (!class_is_aligned) {
             generator.begin_multi_line_comment();
@@ -855,18 +819,14 @@ namespace {
         // @note: @es3n1n: if we need to pad first field or if there's no fields in this class
         // and we need to properly pad it to make sure its size is the same as we expect it
         //
-        const auto* first_field = (class_.m_pFields == nullptr) ? nullptr : &class_.m_pFields[0];
-        const std::optional<std::ptrdiff_t> first_field_offset =
-            (first_field != nullptr) ? std::make_optional(first_field->m_nSingleInheritanceOffset) : std::nullopt;
-
         // @todo: @es3n1n: if for some mysterious reason this class describes fields
         // of the base class we should handle it too.
-        if ((class_parent != nullptr) && first_field_offset.has_value() && first_field_offset.value() < parent_class_size.value()) {
-            const auto warning = std::format("Collision detected: {} and its base {} have {:#x} overlapping byte(s)", class_.GetName(), parent_class_name,
-                                             parent_class_size.value() - first_field_offset.value());
+        state.collision_end_offset = GetCollisionEndOffset(schema, class_);
+        if (state.collision_end_offset != 0) {
+            const auto warning = std::format("Collision detected: {} and its base {} have {:#x} overlapping byte(s)", class_.name, parent_class_name,
+                                             state.collision_end_offset - class_.fields.front().offset);
             warn(warning);
             generator.comment(warning);
-            state.collision_end_offset = parent_class_size.value();
         }
 
         // @note: @es3n1n: start class
@@ -874,45 +834,41 @@ namespace {
         generator.pack_push(1); // we are aligning stuff ourselves
         if (is_struct) {
             if (class_parent != nullptr) {
-                generator.begin_struct_with_base_type(class_.m_pszName, parent_class_name);
+                generator.begin_struct_with_base_type(class_.name, parent_class_name);
             } else {
-                generator.begin_struct(class_.m_pszName);
+                generator.begin_struct(class_.name);
             }
         } else {
             if (class_parent != nullptr) {
-                generator.begin_class_with_base_type(class_.m_pszName, parent_class_name);
+                generator.begin_class_with_base_type(class_.name, parent_class_name);
             } else {
-                generator.begin_class(class_.m_pszName);
+                generator.begin_class(class_.name);
             }
         }
 
-        /// If fields cannot be emitted, e.g. because of collisions, they're added to
-        /// this set so we can ignore them when asserting offsets.
-        std::unordered_set<std::string> skipped_fields{};
         std::list<std::pair<std::string, std::ptrdiff_t>> cached_fields{};
         std::list<cached_datamap_t> cached_datamap_fields{};
 
-        for (const auto& field : class_.GetFields()) {
+        for (const auto& field : class_.fields) {
+            const auto& field_type = schema.types[field.type];
             // Fall back to size=1 because there are no 0-sized types.
             // `RenderPrimitiveType_t` is the only type (in CS2 9035763) without size information.
-            const auto field_size = field.m_pSchemaType->GetSize().value_or(1);
-            const auto field_alignment = GetAlignmentOfTypeRecursive(cache.class_alignment, *field.m_pSchemaType);
+            const auto field_size = field_type.size.value_or(1);
+            const auto field_alignment = GetAlignmentOfTypeRecursive(cache.class_alignment, schema, field_type);
 
             // @note: @es3n1n: parsing type
             //
-            // type_name is fully qualified
-            const auto [type_name, array_sizes] = GetType(generator, *field.m_pSchemaType);
-            const auto var_info = field_parser::parse(generator, type_name, field.m_pszName, array_sizes);
+            // type.name is fully qualified
+            const auto& type = GetType(cache.resolved_types[std::to_underlying(target.language)], generator, schema, field_type);
+            const auto var_info = field_parser::parse(generator, type.name, field.name, type.array_sizes);
 
-            // @fixme: @es3n1n: todo proper collision fix and remove this block
-            if (state.collision_end_offset && field.m_nSingleInheritanceOffset < state.collision_end_offset) {
-                skipped_fields.emplace(field.m_pszName);
+            if (IsSkippedField(state.collision_end_offset, field)) {
                 // A warning has already been logged at the start of the class
                 generator.comment(
-                    std::format("Skipped field \"{}\" @ {:#x} because of the struct collision", field.m_pszName, field.m_nSingleInheritanceOffset));
+                    std::format("Skipped field \"{}\" @ {:#x} because of the struct collision", field.name, field.offset));
                 generator.comment("", false)
                     .reset_tabs_count()
-                    .prop(codegen::Prop{.type_category = GetTypeCategory(field), .type_name = var_info.m_type, .name = var_info.formatted_name()})
+                    .prop(codegen::Prop{.type_category = GetTypeCategory(schema, field), .type_name = var_info.m_type, .name = var_info.formatted_name()})
                     .restore_tabs_count();
                 continue;
             }
@@ -923,13 +879,13 @@ namespace {
             if (var_info.is_bitfield()) {
                 if (!state.assembling_bitfield) {
                     state.assembling_bitfield = true;
-                    state.bitfield_start = field.m_nSingleInheritanceOffset;
+                    state.bitfield_start = field.offset;
                 }
 
                 state.bitfield.emplace_back(BitfieldEntry{
                     .name = var_info.m_name,
                     .size = var_info.m_bitfield_size,
-                    .metadata = std::vector(field.m_pMetadata, field.m_pMetadata + field.m_nMetadataSize),
+                    .metadata = field.metadata,
                 });
                 continue;
             }
@@ -937,51 +893,49 @@ namespace {
             // At this point, we're never still inside a bitfield. If `assembling_bitfield` is set, that means we're at the first field following a
             // bitfield, but the bitfield has not been emitted yet.
             // note: in CS2, there are no types with padding before a bitfield
-            InsertPadUntil(generator, state, state.assembling_bitfield ? state.bitfield_start : field.m_nSingleInheritanceOffset, verbose);
+            InsertPadUntil(generator, state, state.assembling_bitfield ? state.bitfield_start : field.offset, verbose);
 
             // This is the first field after a bitfield, i.e. the active bitfield has ended. Emit the bitfield we have collected.
             if (state.assembling_bitfield) {
                 state = AssembleBitfield(generator, std::move(state));
 
                 // We need another pad here because the current loop iteration is already on a non-bitfield field which will get emitted right away.
-                InsertPadUntil(generator, state, field.m_nSingleInheritanceOffset, verbose);
+                InsertPadUntil(generator, state, field.offset, verbose);
             }
 
             // @note: @es3n1n: dump metadata
             //
-            for (auto j = 0; j < field.m_nMetadataSize; j++) {
-                const auto field_metadata = field.m_pMetadata[j];
-
-                if (auto data = GetMetadataValue(field_metadata); data.empty())
-                    generator.comment(std::format("metadata: {}", field_metadata.m_szName));
+            for (const auto& field_metadata : field.metadata) {
+                if (field_metadata.value.empty())
+                    generator.comment(std::format("metadata: {}", field_metadata.name));
                 else
-                    generator.comment(std::format("metadata: {} \"{}\"", field_metadata.m_szName, data));
+                    generator.comment(std::format("metadata: {} \"{}\"", field_metadata.name, field_metadata.value));
             }
 
             // @note: @es3n1n: update state
             //
-            state.last_field_offset = field.m_nSingleInheritanceOffset;
+            state.last_field_offset = field.offset;
             state.last_field_size = static_cast<std::size_t>(field_size);
 
-            if (const auto e_class = field.m_pSchemaType->GetAsDeclaredClass(); e_class != nullptr && e_class->m_pClassInfo == nullptr) {
+            if (field_type.category == ETypeCategory::Schema_DeclaredClass && field_type.declared_class == snapshot::kNone) {
                 // missing class info
 
                 /// @note: @es3n1n: game bug:
                 ///     There are some classes that have literally no info about them in schema,
                 ///     for these fields we'll just insert a pad.
-                generator.comment(std::format("game bug: prop with no declared class info ({})", e_class->m_pszName));
+                generator.comment(std::format("game bug: prop with no declared class info ({})", field_type.name));
                 generator.prop(codegen::Prop{.type_category = codegen::TypeCategory::built_in,
                                              .type_name = "char",
                                              .name = std::format("{}[{:#x}]", var_info.m_name, field_size)},
                                false);
-            } else if ((field.m_nSingleInheritanceOffset % field_alignment.value_or(source2_max_align)) != 0) {
+            } else if ((field.offset % field_alignment.value_or(source2_max_align)) != 0) {
                 // misaligned field
 
                 const auto warning =
                     field_alignment.has_value() ?
-                        std::format("Property {}::{} is misaligned.", class_.GetName(), field.m_pszName) :
+                        std::format("Property {}::{} is misaligned.", class_.name, field.name) :
                         std::format("Property {}::{} appears to be misaligned. Its alignment is unknown and it is not aligned to max_align_t ({}).",
-                                    class_.GetName(), field.m_pszName, source2_max_align);
+                                    class_.name, field.name, source2_max_align);
                 warn(warning);
                 generator.comment(warning);
                 generator.prop(codegen::Prop{.type_category = codegen::TypeCategory::built_in,
@@ -990,9 +944,9 @@ namespace {
                                true);
                 generator.comment("", false)
                     .reset_tabs_count()
-                    .prop(codegen::Prop{.type_category = GetTypeCategory(field), .type_name = var_info.m_type, .name = var_info.formatted_name()}, false)
+                    .prop(codegen::Prop{.type_category = GetTypeCategory(schema, field), .type_name = var_info.m_type, .name = var_info.formatted_name()}, false)
                     .restore_tabs_count();
-            } else if (std::string{field.m_pSchemaType->m_pszName}.contains('<')) {
+            } else if (field_type.name.contains('<')) {
                 // template type
 
                 // This is a workaround to get the size of template types right.
@@ -1007,7 +961,7 @@ namespace {
                     "{} has a template type with potentially unknown template parameters. You can try uncommenting the field below.", var_info.m_name));
                 generator.comment("", false);
                 generator.reset_tabs_count()
-                    .prop(codegen::Prop{.type_category = GetTypeCategory(field), .type_name = var_info.m_type, .name = var_info.formatted_name()}, true)
+                    .prop(codegen::Prop{.type_category = GetTypeCategory(schema, field), .type_name = var_info.m_type, .name = var_info.formatted_name()}, true)
                     .restore_tabs_count();
                 generator.prop(codegen::Prop{.type_category = codegen::TypeCategory::built_in,
                                              .type_name = "char",
@@ -1015,21 +969,21 @@ namespace {
                                false);
             } else {
                 // This is the "all normal, all good" `prop()` call
-                generator.prop(codegen::Prop{.type_category = GetTypeCategory(field), .type_name = var_info.m_type, .name = var_info.formatted_name()},
+                generator.prop(codegen::Prop{.type_category = GetTypeCategory(schema, field), .type_name = var_info.m_type, .name = var_info.formatted_name()},
                                false);
             }
 
             if (verbose) {
                 generator.reset_tabs_count()
-                    .comment(std::format("type.name=\"{}\" offset={:#x} size={:#x} alignment={}", std::string_view{field.m_pSchemaType->m_pszName},
-                                         field.m_nSingleInheritanceOffset, field_size,
+                    .comment(std::format("type.name=\"{}\" offset={:#x} size={:#x} alignment={}", field_type.name,
+                                         field.offset, field_size,
                                          field_alignment.transform(&util::to_hex_string).value_or("unknown")),
                              false)
                     .restore_tabs_count();
             } else {
-                generator.reset_tabs_count().comment(std::format("{:#x}", field.m_nSingleInheritanceOffset), false).restore_tabs_count();
+                generator.reset_tabs_count().comment(std::format("{:#x}", field.offset), false).restore_tabs_count();
             }
-            cached_fields.emplace_back(var_info.formatted_name(), field.m_nSingleInheritanceOffset);
+            cached_fields.emplace_back(var_info.formatted_name(), field.offset);
 
             generator.next_line();
         }
@@ -1055,30 +1009,18 @@ namespace {
                 },
                 true);
         } else if (static_cast<std::size_t>(class_size) < static_cast<std::size_t>(last_field_end)) [[unlikely]] {
-            throw std::runtime_error{std::format("{} overflows by {:#x} byte(s). Its last field ends at {:#x}, but {} ends at {:#x}", class_.GetName(),
-                                                 -end_pad, last_field_end, class_.GetName(), class_size)};
+            throw std::runtime_error{std::format("{} overflows by {:#x} byte(s). Its last field ends at {:#x}, but {} ends at {:#x}", class_.name,
+                                                 -end_pad, last_field_end, class_.name, class_size)};
         }
 
-        // The current class may be defined in multiple scopes. It doesn't matter which one we use, as all definitions are the same..
-        // TODO: verify the above statement. Are static fields really shared between scopes?
-        const std::string scope_name{class_.m_pTypeScope->BGetScopeName()};
-
-        if (class_.m_pFieldMetadataOverrides && class_.m_pFieldMetadataOverrides->m_iTypeDescriptionCount > 1) {
-            const auto& dm = class_.m_pFieldMetadataOverrides;
-
-            for (std::uint64_t s = 0; s < dm->m_iTypeDescriptionCount; s++) {
-                auto* t = &dm->m_pTypeDescription[s];
-                if (!t)
-                    continue;
-
-                if (t->GetFieldName().empty())
-                    continue;
-
-                const auto var_info = field_parser::parse(t->m_iFieldType, t->GetFieldName(), t->m_nFieldSize);
+        // The snapshot only contains datamaps with more than one entry, and only entries that have a name
+        if (!class_.datamap.empty()) {
+            for (const auto& t : class_.datamap) {
+                const auto var_info = field_parser::parse(t.type, t.name, t.size);
 
                 std::string field_type = var_info.m_type;
-                if (t->m_iFieldType == fieldtype_t::FIELD_EMBEDDED) {
-                    field_type = t->m_pDataMap->m_pszClassName;
+                if (t.type == fieldtype_t::FIELD_EMBEDDED) {
+                    field_type = t.embedded_class;
                 }
 
                 std::string field_name = var_info.formatted_name();
@@ -1086,15 +1028,15 @@ namespace {
                 // @note: @og: if schema dump already has this field, then just skip it
 
                 if (const auto it =
-                        std::ranges::find_if(cached_fields, [t, field_name](const auto& f) { return f.first == field_name && f.second == t->m_iOffset; });
+                        std::ranges::find_if(cached_fields, [&t, field_name](const auto& f) { return f.first == field_name && f.second == t.offset; });
                     it != cached_fields.end())
                     continue;
 
-                cached_datamap_fields.emplace_back(field_type, field_name, t->m_iOffset);
+                cached_datamap_fields.emplace_back(field_type, field_name, t.offset);
             }
 
             if (!cached_datamap_fields.empty()) {
-                if (class_.m_nFieldSize)
+                if (!class_.fields.empty())
                     generator.next_line();
 
                 generator.comment("Datamap fields:");
@@ -1104,7 +1046,14 @@ namespace {
             }
         }
 
-        if (!class_.m_nFieldSize && !class_.m_nStaticMetadataSize)
+        if (target.static_members && !class_.static_fields.empty()) {
+            if (!class_.fields.empty())
+                generator.next_line();
+
+            AssembleStaticFields(target, cache, generator, schema, class_);
+        }
+
+        if (class_.fields.empty() && class_.static_metadata.empty())
             generator.comment("No schema binary for binding");
 
         if (is_struct) {
@@ -1116,24 +1065,24 @@ namespace {
         generator.pack_pop();
         generator.next_line();
 
-        const bool is_standard_layout_class = IsStandardLayoutClass(cache.class_has_standard_layout, class_);
+        const bool is_standard_layout_class = IsStandardLayoutClass(cache.class_has_standard_layout, schema, class_);
 
-        if (options.static_assertions) {
+        if (target.static_assertions) {
             // TODO: when we have a CLI parser: allow users to generate assertions in non-standard-layout classes. Those assertions are
             // conditionally-supported by compilers.
             if (is_standard_layout_class) {
                 for (const auto& field :
-                     class_.GetFields() | std::ranges::views::filter([&](const auto& e) { return !skipped_fields.contains(e.m_pszName); })) {
-                    if (field.m_pSchemaType->m_unTypeCategory == ETypeCategory::Schema_Bitfield) {
-                        generator.comment(std::format("Cannot assert offset of bitfield {}::{}", class_.m_pszName, field.m_pszName));
+                     class_.fields | std::ranges::views::filter([&](const auto& e) { return !IsSkippedField(state.collision_end_offset, e); })) {
+                    if (schema.types[field.type].category == ETypeCategory::Schema_Bitfield) {
+                        generator.comment(std::format("Cannot assert offset of bitfield {}::{}", class_.name, field.name));
                     } else {
-                        generator.static_assert_offset(MaybeWithModuleName(generator, *class_.m_pTypeScope, class_.m_pszName), field.m_pszName,
-                                                       field.m_nSingleInheritanceOffset);
+                        generator.static_assert_offset(MaybeWithModuleName(generator, GetScope(schema, class_.scope), class_.name), field.name,
+                                                       field.offset);
                     }
                 }
             } else {
-                if (class_.m_nFieldSize != 0) {
-                    generator.comment(std::format("Cannot assert offsets of fields in {} because it is not a standard-layout class", class_.m_pszName));
+                if (!class_.fields.empty()) {
+                    generator.comment(std::format("Cannot assert offsets of fields in {} because it is not a standard-layout class", class_.name));
                 }
             }
         }
@@ -1144,26 +1093,57 @@ namespace {
 
         generator.next_line();
 
-        if (options.static_assertions) {
-            generator.static_assert_size(MaybeWithModuleName(generator, *class_.m_pTypeScope, class_.m_pszName), class_size);
+        if (target.static_assertions) {
+            generator.static_assert_size(MaybeWithModuleName(generator, GetScope(schema, class_.scope), class_.name), class_size);
         }
     }
 
-    [[nodiscard]]
-    std::filesystem::path GetFilePathForType(const codegen::IGenerator& generator, std::string_view module_name, std::string_view type_name) {
-        return std::format("{}/include/{}/{}/{}.{}", kOutDirName, kIncludeDirName, module_name, EscapeTypeName(generator, DecayTypeName(type_name)),
-                           generator.get_file_extension());
+    /// Emits a namespace named after @p class_ instead of a class definition. It contains the size and alignment of the class and the offset of
+    /// every field that @ref AssembleClass() emits as a member, in the same order. Offsets of base class fields are in the base class' namespace.
+    /// Bitfields and fields skipped by @ref IsSkippedField() are only mentioned in comments. Unlike @ref AssembleClass()'s assertions, this
+    /// includes fields of classes that don't have a standard layout, the offsets are plain constants.
+    template <std::derived_from<codegen::IGenerator> Generator>
+    void AssembleClassOffsets(sdk::GeneratorCache& cache, Generator& generator, const snapshot::Snapshot& schema, const snapshot::Class& class_) {
+        if (class_.base_class != snapshot::kNone) {
+            const auto& class_parent = schema.classes[class_.base_class];
+            generator.comment(std::format("Base: {}", MaybeWithModuleName(generator, GetScope(schema, class_parent.scope), class_parent.name)));
+        }
+
+        generator.begin_namespace(EscapeTypeName(generator, class_.name));
+        generator.constant("std::size_t", "kSize", class_.size);
+
+        if (const auto alignment = GetClassAlignmentRecursive(cache.class_alignment, schema, class_); alignment.has_value()) {
+            generator.constant("std::size_t", "kAlignment", alignment.value());
+        }
+
+        const auto collision_end_offset = GetCollisionEndOffset(schema, class_);
+
+        for (const auto& field : class_.fields) {
+            if (IsSkippedField(collision_end_offset, field)) {
+                generator.comment(std::format("{} @ {:#x} has been skipped because of the struct collision", field.name, field.offset));
+            } else if (schema.types[field.type].category == ETypeCategory::Schema_Bitfield) {
+                generator.comment(std::format("{} is a bitfield", field.name));
+            } else {
+                generator.constant("std::ptrdiff_t", field.name, field.offset);
+            }
+        }
+
+        generator.end_namespace();
     }
 
-    /// @return Path to the generated file
-    std::filesystem::path GenerateEnumSdk(const source2_gen::Options& options, std::string_view module_name, const CSchemaEnumBinding& enum_) {
-        // @note: @es3n1n: init codegen
-        //
-        auto p_generator = GetGeneratorForLanguage(options.emit_language);
-        auto& generator = *p_generator;
+    [[nodiscard]]
+    std::filesystem::path GetFilePathForType(const codegen::IGenerator& generator, const sdk::EmitTarget& target, std::string_view module_name,
+                                             std::string_view type_name) {
+        return target.directory / std::format("include/{}/{}/{}.{}", kIncludeDirName, module_name, EscapeTypeName(generator, DecayTypeName(type_name)),
+                                              generator.get_file_extension());
+    }
 
+    template <std::derived_from<codegen::IGenerator> Generator>
+    sdk::GeneratedFile GenerateEnumSdk(Generator& generator, const sdk::EmitTarget& target, std::string_view module_name, const snapshot::Enum& enum_) {
         generator.preamble();
 
+        const auto definition_offset = generator.size();
+
         // @note: @es3n1n: print banner
         //
         generator.next_line()
@@ -1183,55 +1163,51 @@ namespace {
         generator.end_namespace();
         generator.end_namespace();
 
-        // @note: @es3n1n: write generated data to output file
-        //
-        if (!std::filesystem::exists(kOutDirName))
-            std::filesystem::create_directories(kOutDirName);
-
-        const auto out_file_path = GetFilePathForType(generator, module_name, enum_.m_pszName).string();
-
-        std::ofstream f(out_file_path, std::ios::out);
-        f << generator.str();
-        if (!f.good()) {
-            std::cerr << std::format("Could not write to {}: {}", out_file_path, std::strerror(errno)) << std::endl;
-            // This std::exit() is bad. Instead, we could return the dumped
-            // header name and content to the caller in a std::expected. Let the
-            // caller write the file. That would also allow the caller to choose
-            // the output directory and handle errors.
-            std::exit(1);
-        }
-
-        return out_file_path;
+        return sdk::GeneratedFile{.path = GetFilePathForType(generator, target, module_name, enum_.name),
+                                  .module = std::string{module_name},
+                                  .contents = generator.take(),
+                                  .definition_offset = definition_offset};
     }
 
-    /// @return Path to the generated file
-    std::filesystem::path GenerateClassSdk(const source2_gen::Options& options, sdk::GeneratorCache& cache, std::string_view module_name,
-                                           const CSchemaClassBinding& class_) {
-        // @note: @es3n1n: init codegen
-        //
-        auto p_generator = GetGeneratorForLanguage(options.emit_language);
-        auto& generator = *p_generator;
+    /// @param names Result of @ref GetRequiredNamesForClass(). Doesn't depend on the language, so it's shared between all targets.
+    template <std::derived_from<codegen::IGenerator> Generator>
+    sdk::GeneratedFile GenerateClassSdk(Generator& generator, const sdk::EmitTarget& target, sdk::GeneratorCache& cache, const snapshot::Snapshot& schema,
+                                        const std::set<NameLookup>& names, std::string_view module_name, const snapshot::Class& class_) {
+        sdk::GeneratedFile result{};
 
         generator.preamble();
 
-        const auto names = GetRequiredNamesForClass(class_);
+        // Offsets don't need the types of fields
+        static const std::set<NameLookup> no_names{};
+        const auto& required_names = target.offsets_only ? no_names : names;
 
-        for (const auto& include : names | std::views::filter([](const auto& el) { return el.source == NameSource::include; })) {
+        for (const auto& include : required_names | std::views::filter([](const auto& el) { return el.source == NameSource::include; })) {
             generator.include(std::format("{}/{}/{}", kIncludeDirName, include.module, EscapeTypeName(generator, include.type_name)),
                               codegen::IncludeOptions{
                                   .local = true,
                                   .system = false,
                               });
+
+            if (target.keep_files) {
+                result.includes.emplace_back(GetFilePathForType(generator, target, include.module, include.type_name));
+            }
         }
 
-        for (const auto& forward_declaration : names | std::views::filter([](const auto& el) { return el.source == NameSource::forward_declaration; })) {
+        for (const auto& forward_declaration :
+             required_names | std::views::filter([](const auto& el) { return el.source == NameSource::forward_declaration; })) {
             generator.begin_namespace("source2sdk");
             generator.begin_namespace(forward_declaration.module);
             generator.forward_declaration(forward_declaration.type_name);
             generator.end_namespace();
             generator.end_namespace();
+
+            if (target.keep_files) {
+                result.forward_declarations.emplace_back(sdk::TypeIdentifier{.module = forward_declaration.module, .name = forward_declaration.type_name});
+            }
         }
 
+        result.definition_offset = generator.size();
+
         // @note: @es3n1n: print banner
         //
         generator.next_line()
@@ -1246,47 +1222,452 @@ namespace {
 
         // @note: @es3n1n: assemble props
         //
-        AssembleClass(options, cache, generator, class_);
+        if (target.offsets_only) {
+            AssembleClassOffsets(cache, generator, schema, class_);
+        } else {
+            AssembleClass(target, cache, generator, schema, class_);
+        }
 
         generator.end_namespace();
         generator.end_namespace();
 
-        // @note: @es3n1n: write generated data to output file
-        //
-        const auto out_file_path = GetFilePathForType(generator, module_name, class_.m_pszName).string();
-        std::ofstream f(out_file_path, std::ios::out);
-        f << generator.str();
-        if (!f.good()) {
-            std::cerr << std::format("Could not write to {}: {}", out_file_path, std::strerror(errno)) << std::endl;
-            // This std::exit() is bad. Instead, we could return the dumped
-            // header name and content to the caller in a std::expected. Let the
-            // caller write the file. That would also allow the caller to choose
-            // the output directory and handle errors.
-            std::exit(1);
-        }
-
-        return out_file_path;
+        result.path = GetFilePathForType(generator, target, module_name, class_.name);
+        result.module = module_name;
+        result.contents = generator.take();
+
+        return result;
+    }
+
+    /// @param headers Files of one module
+    /// @return Path and contents of the header that includes all @p headers
+    template <std::derived_from<codegen::IGenerator> Generator>
+    std::pair<std::filesystem::path, std::string> GenerateUmbrellaHeader(Generator& generator, const sdk::EmitTarget& target,
+                                                                         std::string_view module_name, std::vector<std::filesystem::path> headers) {
+        const auto path = GetFilePathForType(generator, target, module_name, kUmbrellaHeaderName);
+        const auto include_directory = target.directory / "include";
+
+        std::ranges::sort(headers);
+
+        generator.preamble();
+
+        for (const auto& header : headers) {
+            if (header == path) {
+                warn(std::format("module {} has a type named {}, {} doesn't include it", module_name, kUmbrellaHeaderName, path.generic_string()));
+                continue;
+            }
+
+            generator.include(header.lexically_relative(include_directory).replace_extension().generic_string(),
+                              codegen::IncludeOptions{.local = true, .system = false});
+        }
+
+        return {path, generator.take()};
+    }
+
+    /// @param classes Classes of one module that have static fields, and their headers
+    /// @return Path and contents of the header that declares ResolveStaticFields() for the module, which resolves the static fields of all
+    /// @p classes
+    template <std::derived_from<codegen::IGenerator> Generator>
+    std::pair<std::filesystem::path, std::string>
+    GenerateStaticFieldsHeader(Generator& generator, const sdk::EmitTarget& target, std::string_view module_name,
+                               std::vector<std::pair<std::filesystem::path, const snapshot::Class*>> classes) {
+        const auto path = GetFilePathForType(generator, target, module_name, kStaticFieldsHeaderName);
+        const auto include_directory = target.directory / "include";
+
+        std::ranges::sort(classes, std::ranges::less{}, [](const auto& el) { return el.first; });
+
+        generator.preamble();
+
+        for (const auto& [header, class_] : classes) {
+            generator.include(header.lexically_relative(include_directory).replace_extension().generic_string(),
+                              codegen::IncludeOptions{.local = true, .system = false});
+        }
+
+        generator.next_line();
+        generator.begin_namespace("source2sdk");
+        generator.begin_namespace(module_name);
+        generator.comment("Looks up the static fields of all classes of this module, e.g. after the module has been loaded");
+        generator.begin_function("inline ", "void", "ResolveStaticFields");
+
+        for (const auto& [header, class_] : classes) {
+            generator.statement(std::format("{}::ResolveStaticFields()", EscapeTypeName(generator, class_->name)));
+        }
+
+        generator.end_function();
+        generator.end_namespace();
+        generator.end_namespace();
+
+        return {path, generator.take()};
+    }
+
+    /// One type to be generated
+    struct GeneratorTask {
+        /// Lifetime bound to the snapshot passed to @ref sdk::GenerateSdk()
+        std::string_view module_name{};
+        /// Lifetime bound to the snapshot passed to @ref sdk::GenerateSdk()
+        std::variant<const snapshot::Enum*, const snapshot::Class*> type{};
+        /// In arbitrary units, see @ref EstimateClassCost()
+        std::size_t estimated_cost{};
+
+        [[nodiscard]] sdk::TypeIdentifier GetIdentifier() const {
+            return sdk::TypeIdentifier{.module = std::string{module_name},
+                                       .name = std::visit([](const auto* el) { return el->name; }, type)};
+        }
+    };
+
+    /// Opening and writing the output file costs about as much as emitting a handful of fields
+    constexpr std::size_t kFileCost = 8;
+
+    /// @return Nesting depth of template arguments, e.g. 2 for "CUtlVector< CHandle< C_BaseEntity > >"
+    [[nodiscard]] std::size_t GetTemplateDepth(std::string_view type_name) {
+        std::size_t depth = 0;
+        std::size_t max_depth = 0;
+
+        for (const auto c : type_name) {
+            if (c == '<') {
+                max_depth = std::max(max_depth, ++depth);
+            } else if (c == '>' && depth != 0) {
+                --depth;
+            }
+        }
+
+        return max_depth;
+    }
+
+    [[nodiscard]] std::size_t EstimateEnumCost(const snapshot::Enum& enum_) {
+        std::size_t cost = kFileCost + enum_.enumerators.size() + enum_.static_metadata.size();
+
+        for (const auto& enumerator : enum_.enumerators) {
+            cost += enumerator.metadata.size();
+        }
+
+        return cost;
+    }
+
+    /// The estimate follows the work done by @ref GenerateClassSdk(). Every field is parsed, resolved, and emitted with its metadata. Template
+    /// arguments are resolved one by one and each may pull in an include.
+    [[nodiscard]] std::size_t EstimateClassCost(const snapshot::Snapshot& schema, const snapshot::Class& class_) {
+        std::size_t cost = kFileCost + class_.static_metadata.size() + class_.datamap.size();
+
+        for (const auto& field : class_.fields) {
+            cost += 4 + field.metadata.size() + 2 * GetTemplateDepth(schema.types[field.type].name);
+        }
+
+        return cost;
+    }
+
+    /// Orders @p tasks largest first. Uses the timings in @p history for tasks that have one, and the estimated cost otherwise. Estimates are
+    /// converted to time using the average time per cost unit of all tasks that have a history.
+    /// @return Indices into @p tasks
+    [[nodiscard]] std::vector<std::size_t> ScheduleLargestFirst(std::span<const GeneratorTask> tasks, const sdk::TimingHistory& history) {
+        std::vector<std::optional<std::chrono::nanoseconds>> known_durations(tasks.size());
+        std::chrono::nanoseconds known_total{0};
+        std::size_t known_cost = 0;
+
+        for (std::size_t i = 0; i < tasks.size(); ++i) {
+            if (const auto duration = history.Find(tasks[i].GetIdentifier())) {
+                known_durations[i] = duration;
+                known_total += duration.value();
+                known_cost += tasks[i].estimated_cost;
+            }
+        }
+
+        // Without a history, a cost unit is as good as any time unit
+        const double nanoseconds_per_cost =
+            (known_cost == 0) ? 1.0 : static_cast<double>(known_total.count()) / static_cast<double>(known_cost);
+
+        std::vector<double> expected_durations(tasks.size());
+        for (std::size_t i = 0; i < tasks.size(); ++i) {
+            expected_durations[i] = known_durations[i].has_value() ? static_cast<double>(known_durations[i]->count()) :
+                                                                     static_cast<double>(tasks[i].estimated_cost) * nanoseconds_per_cost;
+        }
+
+        std::vector<std::size_t> order(tasks.size());
+        std::iota(order.begin(), order.end(), std::size_t{0});
+        // stable to keep the schedule deterministic for tasks of equal cost
+        std::ranges::stable_sort(order, std::ranges::greater{}, [&](std::size_t i) { return expected_durations[i]; });
+
+        return order;
+    }
+
+    /// @param non_odr_templates See @ref GetRequiredNamesForType()
+    /// @return Names every task needs, empty for enums. Element i belongs to tasks[i].
+    [[nodiscard]] std::vector<std::set<NameLookup>> GetRequiredNamesForTasks(sdk::ConcurrentTypeMemo<snapshot::Type, std::set<NameLookup>>& cache,
+                                                                             const std::set<std::string, std::less<>>& non_odr_templates,
+                                                                             const snapshot::Snapshot& schema, std::span<const GeneratorTask> tasks) {
+        std::vector<std::set<NameLookup>> result(tasks.size());
+
+        for (std::size_t i = 0; i < tasks.size(); ++i) {
+            if (const auto* const* class_ = std::get_if<const snapshot::Class*>(&tasks[i].type)) {
+                result[i] = GetRequiredNamesForClass(cache, non_odr_templates, schema, **class_);
+            }
+        }
+
+        return result;
+    }
+
+    /// Node i is tasks[i]. Types that are included but not generated are not part of the graph.
+    /// @param names Result of @ref GetRequiredNamesForTasks()
+    [[nodiscard]] sdk::IncludeGraph BuildIncludeGraph(std::span<const GeneratorTask> tasks, std::span<const std::set<NameLookup>> names) {
+        std::map<sdk::TypeIdentifier, std::size_t> nodes{};
+        for (std::size_t i = 0; i < tasks.size(); ++i) {
+            nodes.emplace(tasks[i].GetIdentifier(), i);
+        }
+
+        std::vector<std::vector<std::size_t>> includes(tasks.size());
+
+        for (std::size_t i = 0; i < tasks.size(); ++i) {
+            for (const auto& name : names[i] | std::views::filter([](const auto& el) { return el.source == NameSource::include; })) {
+                if (const auto found = nodes.find(sdk::TypeIdentifier{.module = name.module, .name = name.type_name}); found != nodes.end()) {
+                    includes[i].emplace_back(found->second);
+                }
+            }
+        }
+
+        return sdk::IncludeGraph{std::move(includes)};
+    }
+
+    /// Removes includes from @p names that are already included by another include of the same type
+    /// @param graph Result of @ref BuildIncludeGraph() for @p names
+    void MinimizeIncludes(const sdk::IncludeGraph& graph, std::span<const GeneratorTask> tasks, std::span<std::set<NameLookup>> names) {
+        for (std::size_t i = 0; i < tasks.size(); ++i) {
+            const auto includes = graph.GetIncludes(i);
+            const auto minimal = graph.GetMinimalIncludes(i);
+
+            for (const auto include : includes) {
+                if (std::ranges::find(minimal, include) == minimal.end()) {
+                    const auto id = tasks[include].GetIdentifier();
+                    names[i].erase(NameLookup{.module = id.module, .type_name = id.name, .source = NameSource::include});
+                }
+            }
+        }
+    }
+
+    /// See @ref sdk::GeneratorResult::include_report
+    /// @param after Result of @ref BuildIncludeGraph() for the configured names, before @ref MinimizeIncludes()
+    [[nodiscard]] std::vector<sdk::IncludeReportEntry> GetIncludeReport(const snapshot::Snapshot& schema, std::span<const GeneratorTask> tasks,
+                                                                       const sdk::IncludeGraph& after) {
+        // Separate cache, the names depend on the templates
+        sdk::ConcurrentTypeMemo<snapshot::Type, std::set<NameLookup>> cache{};
+        const auto before = BuildIncludeGraph(tasks, GetRequiredNamesForTasks(cache, source2_gen::Options{}.non_odr_templates, schema, tasks));
+
+        std::vector<sdk::IncludeReportEntry> result{};
+        result.reserve(tasks.size());
+
+        for (std::size_t i = 0; i < tasks.size(); ++i) {
+            result.emplace_back(sdk::IncludeReportEntry{
+                .type = tasks[i].GetIdentifier(),
+                .includes_before = before.GetIncludes(i).size(),
+                .includes_after = after.GetMinimalIncludes(i).size(),
+                .closure_before = before.GetClosureSize(i),
+                .closure_after = after.GetClosureSize(i),
+            });
+        }
+
+        std::ranges::stable_sort(result, std::ranges::greater{}, &sdk::IncludeReportEntry::closure_before);
+
+        return result;
     }
 } // namespace
 
 namespace sdk {
-    GeneratorResult GenerateTypeScopeSdk(const source2_gen::Options& options, GeneratorCache& cache, std::string_view module_name,
-                                         const std::unordered_set<const CSchemaEnumBinding*>& enums,
-                                         const std::unordered_set<const CSchemaClassBinding*>& classes) {
-        // @note: @es3n1n: print debug info
-        //
-        std::cout << std::format("{}: Assembling module {} with {} enum(s) and {} class(es)", __FUNCTION__, module_name, enums.size(), classes.size())
-                  << std::endl;
+    std::vector<EmitTarget> GetEmitTargets(const source2_gen::Options& options) {
+        std::vector<EmitTarget> result{};
+
+        for (const auto language : options.emit_languages) {
+            // c-ida is parsed by IDA, which doesn't understand static members or assertions
+            const bool is_ida = (language == source2_gen::Language::c_ida);
+            const bool is_cpp = (language == source2_gen::Language::cpp);
+            const bool is_cpp_modules = (language == source2_gen::Language::cpp_modules);
+            const bool is_cpp_offsets = (language == source2_gen::Language::cpp_offsets);
+            // written from the snapshot after generating
+            const bool is_schema_export = (language == source2_gen::Language::schema_bin) || (language == source2_gen::Language::json);
+
+            result.emplace_back(EmitTarget{
+                .language = language,
+                .directory = (options.emit_languages.size() == 1) ? std::filesystem::path{kOutDirName} :
+                                                                    std::filesystem::path{kOutDirName} / source2_gen::get_language_name(language),
+                // getters are only implemented in C++
+                .static_members = options.static_members && (is_cpp || is_cpp_modules),
+                .static_assertions = options.static_assertions && !is_ida && !is_cpp_offsets && !is_schema_export,
+                // amalgamated into ida.h or into module interface units
+                .keep_files = is_ida || is_cpp_modules || (is_cpp && (options.amalgamation != source2_gen::Amalgamation::none)),
+                .write_type_files = !(is_cpp && options.amalgamation_only) && !is_cpp_modules && !is_schema_export,
+                .generates_types = !is_schema_export,
+                .amalgamation = is_cpp ? options.amalgamation : source2_gen::Amalgamation::none,
+                // precompiled by sdk-static/cpp/CMakeLists.txt
+                .umbrella_headers = (is_cpp && !options.amalgamation_only) || is_cpp_offsets,
+                .offsets_only = is_cpp_offsets,
+                .field_table = options.field_table && (is_cpp || is_cpp_offsets),
+            });
+        }
 
-        const std::filesystem::path out_directory_path = std::format("{}/include/{}/{}", kOutDirName, kIncludeDirName, module_name);
+        return result;
+    }
+
+    GeneratorResult GenerateSdk(const source2_gen::Options& options, std::span<const EmitTarget> targets, GeneratorCache& cache,
+                                util::AsyncFileWriter& writer, const snapshot::Snapshot& schema, TimingHistory& history) {
+        if (std::ranges::none_of(targets, &EmitTarget::generates_types)) {
+            return GeneratorResult{
+                .generated_files = std::vector<std::unordered_set<std::filesystem::path>>(targets.size()),
+                .files = std::vector<std::vector<GeneratedFile>>(targets.size()),
+            };
+        }
+
+        std::vector<GeneratorTask> tasks{};
+
+        for (const auto& [module_name, dump] : schema.modules) {
+            // @note: @es3n1n: print debug info
+            //
+            std::cout << std::format("{}: Assembling module {} with {} enum(s) and {} class(es)", __FUNCTION__, module_name, dump.enums.size(),
+                                     dump.classes.size())
+                      << std::endl;
+
+            for (const auto& target : targets | std::views::filter(&EmitTarget::write_type_files)) {
+                const auto out_directory_path = target.directory / std::format("include/{}/{}", kIncludeDirName, module_name);
 
-        if (!std::filesystem::exists(out_directory_path))
-            std::filesystem::create_directories(out_directory_path);
+                if (!std::filesystem::exists(out_directory_path))
+                    std::filesystem::create_directories(out_directory_path);
+            }
+
+            for (const auto index : dump.enums) {
+                const auto& el = schema.enums[index];
+                tasks.emplace_back(GeneratorTask{.module_name = module_name, .type = &el, .estimated_cost = EstimateEnumCost(el)});
+            }
 
-        GeneratorResult result{};
+            for (const auto index : dump.classes) {
+                const auto& el = schema.classes[index];
+                tasks.emplace_back(GeneratorTask{.module_name = module_name, .type = &el, .estimated_cost = EstimateClassCost(schema, el)});
+            }
+        }
 
-        std::ranges::for_each(enums, [&](const auto* el) { result.generated_files.emplace(GenerateEnumSdk(options, module_name, *el)); });
-        std::ranges::for_each(classes, [&](const auto* el) { result.generated_files.emplace(GenerateClassSdk(options, cache, module_name, *el)); });
+        const auto schedule = ScheduleLargestFirst(tasks, history);
+
+        // Includes are minimized with the whole include graph, so all names are looked up before generating
+        auto names = GetRequiredNamesForTasks(cache.required_names, options.non_odr_templates, schema, tasks);
+        const auto include_graph = BuildIncludeGraph(tasks, names);
+        MinimizeIncludes(include_graph, tasks, names);
+
+        // Every task writes its files into its own slot, one file per target. The files are collected in task order afterwards so the result
+        // doesn't depend on the schedule or on which thread finished first.
+        std::vector<std::vector<GeneratedFile>> generated_files(tasks.size());
+
+        // Hands the file to the writer, it might not have been written when this function returns. Keeps only what's needed afterwards.
+        const auto write = [&writer](const EmitTarget& target, GeneratedFile&& file) {
+            if (target.write_type_files) {
+                if (target.keep_files) {
+                    writer.Enqueue(file.path, file.contents);
+                } else {
+                    writer.Enqueue(file.path, std::move(file.contents));
+                    file.contents = {};
+                }
+            }
+
+            return std::move(file);
+        };
+
+        {
+            util::ThreadPool pool{options.jobs};
+
+            std::cout << std::format("{}: Generating {} type(s) in {} language(s) on {} thread(s)", __FUNCTION__, tasks.size(), targets.size(),
+                                     pool.GetThreadCount())
+                      << std::endl;
+
+            for (const auto index : schedule) {
+                pool.Submit([&, index]() {
+                    const auto& task = tasks[index];
+                    const auto start = std::chrono::steady_clock::now();
+                    auto& files = generated_files[index];
+
+                    std::visit(
+                        [&](const auto* type) {
+                            if constexpr (std::is_same_v<std::decay_t<decltype(*type)>, snapshot::Enum>) {
+                                for (const auto& target : targets) {
+                                    if (!target.generates_types) {
+                                        files.emplace_back();
+                                        continue;
+                                    }
+
+                                    files.emplace_back(write(target, VisitGenerator(target.language, [&](auto& generator) {
+                                                                 return GenerateEnumSdk(generator, target, task.module_name, *type);
+                                                             })));
+                                }
+                            } else {
+                                for (const auto& target : targets) {
+                                    if (!target.generates_types) {
+                                        files.emplace_back();
+                                        continue;
+                                    }
+
+                                    files.emplace_back(write(target, VisitGenerator(target.language, [&](auto& generator) {
+                                                                 return GenerateClassSdk(generator, target, cache, schema, names[index], task.module_name, *type);
+                                                             })));
+                                }
+                            }
+                        },
+                        task.type);
+
+                    history.Record(task.GetIdentifier(), std::chrono::steady_clock::now() - start);
+                });
+            }
+
+            // Rethrows errors from generator threads
+            pool.Wait();
+        }
+
+        GeneratorResult result{
+            .generated_files = std::vector<std::unordered_set<std::filesystem::path>>(targets.size()),
+            .files = std::vector<std::vector<GeneratedFile>>(targets.size()),
+            .include_report = options.include_report.has_value() ? GetIncludeReport(schema, tasks, include_graph) : std::vector<IncludeReportEntry>{},
+        };
+
+        for (std::size_t i = 0; i < targets.size(); ++i) {
+            const auto& target = targets[i];
+
+            if (!target.umbrella_headers) {
+                continue;
+            }
+
+            std::map<std::string_view, std::vector<std::filesystem::path>> module_headers{};
+            std::map<std::string_view, std::vector<std::pair<std::filesystem::path, const snapshot::Class*>>> module_static_fields{};
+            for (std::size_t task = 0; task < tasks.size(); ++task) {
+                module_headers[tasks[task].module_name].emplace_back(generated_files[task][i].path);
+
+                if (const auto* const class_ = std::get_if<const snapshot::Class*>(&tasks[task].type);
+                    target.static_members && (class_ != nullptr) && !(*class_)->static_fields.empty()) {
+                    module_static_fields[tasks[task].module_name].emplace_back(generated_files[task][i].path, *class_);
+                }
+            }
+
+            for (auto& [module_name, classes] : module_static_fields) {
+                auto [path, contents] = VisitGenerator(target.language, [&](auto& generator) {
+                    return GenerateStaticFieldsHeader(generator, target, module_name, std::move(classes));
+                });
+
+                result.generated_files[i].emplace(path);
+                writer.Enqueue(std::move(path), std::move(contents));
+            }
+
+            for (auto& [module_name, headers] : module_headers) {
+                auto [path, contents] = VisitGenerator(target.language, [&](auto& generator) {
+                    return GenerateUmbrellaHeader(generator, target, module_name, std::move(headers));
+                });
+
+                result.generated_files[i].emplace(path);
+                writer.Enqueue(std::move(path), std::move(contents));
+            }
+        }
+
+        for (auto& files : generated_files) {
+            for (std::size_t i = 0; i < files.size(); ++i) {
+                if (targets[i].write_type_files) {
+                    result.generated_files[i].emplace(files[i].path);
+                }
+
+                if (targets[i].keep_files) {
+                    result.files[i].emplace_back(std::move(files[i]));
+                }
+            }
+        }
 
         return result;
     }
@@ -0,0 +1,913 @@
+// Copyright (C) 2024 neverlosecc
+// See end of file for extended copyright information.
+#include "sdk/snapshot.h"
+#include "sdk/metadata.h"
+#include "sdk/sdk.h"
+#include "tools/fnv.h"
+#include <absl/container/flat_hash_map.h>
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <cstring>
+#include <deque>
+#include <format>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <memory>
+#include <optional>
+#include <set>
+#include <span>
+#include <stdexcept>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+#include <variant>
+
+namespace {
+    using sdk::snapshot::Index;
+    using sdk::snapshot::kNone;
+
+    /// First line of every snapshot, followed by binary data. Bump the version if the format changes, old snapshots will be rejected.
+    constexpr std::string_view kHeader = "source2gen-snapshot 2\n";
+
+    /// Calls @p fn with every decayed name the generator looks up for @p type_name, e.g. "CUtlVector", "CHandle", and "C_BaseEntity" for
+    /// "CUtlVector< CHandle< C_BaseEntity >* >". Keep in sync with DecomposeTemplate() and DecayTypeName() in sdk.cpp.
+    template <typename Fn>
+    void ForEachLookedUpName(std::string_view type_name, Fn&& fn) {
+        while (!type_name.empty()) {
+            const auto separator = type_name.find_first_of("<,>");
+            auto part = type_name.substr(0, separator);
+
+            part.remove_prefix(std::min(part.find_first_not_of(' '), part.size()));
+            part.remove_suffix(part.size() - (part.find_last_not_of(' ') + 1));
+            part = part.substr(0, part.find('['));
+            part = part.substr(0, part.find('*'));
+
+            if (!part.empty()) {
+                fn(part);
+            }
+
+            if (separator == std::string_view::npos) {
+                break;
+            }
+            type_name.remove_prefix(separator + 1);
+        }
+    }
+
+    /// Copies schema objects into a @ref sdk::snapshot::Snapshot. Every object is copied once, references between objects are turned into
+    /// indices.
+    class Capturer {
+    public:
+        explicit Capturer(sdk::snapshot::Snapshot& snapshot) : _snapshot(snapshot) { }
+
+        [[nodiscard]] const sdk::snapshot::CaptureStats& GetStats() const {
+            return _stats;
+        }
+
+        /// Classes are only reserved, their contents are copied by @ref CapturePendingClasses(). Class hierarchies and field types can be
+        /// nested deeply, this keeps the recursion flat.
+        Index AddClass(const CSchemaClassInfo& class_) {
+            if (const auto found = _classes.find(&class_); found != _classes.end()) {
+                return found->second;
+            }
+
+            const auto index = static_cast<Index>(_snapshot.classes.size());
+            _snapshot.classes.emplace_back();
+            _classes.emplace(&class_, index);
+            _pending_classes.emplace_back(&class_, index);
+
+            return index;
+        }
+
+        Index AddEnum(const CSchemaEnumBinding& enum_) {
+            const auto index = static_cast<Index>(_snapshot.enums.size());
+
+            auto& result = _snapshot.enums.emplace_back(sdk::snapshot::Enum{
+                .name = enum_.m_pszName,
+                .module = enum_.m_pszModule,
+                .size = enum_.m_unSizeOf,
+                .alignment = enum_.m_unAlignOf,
+                .static_metadata = CaptureMetadata(std::span{enum_.m_pStaticMetadata, static_cast<std::size_t>(enum_.m_nStaticMetadataSize)}),
+            });
+
+            for (const auto& enumerator : std::span{enum_.m_pEnumerators, static_cast<std::size_t>(enum_.m_nEnumeratorCount)}) {
+                result.enumerators.emplace_back(sdk::snapshot::Enumerator{
+                    .name = enumerator.m_szName,
+                    .value = GetEnumeratorValue(enum_, enumerator),
+                    .metadata = CaptureMetadata(std::span{enumerator.m_pMetadata, static_cast<std::size_t>(enumerator.m_nMetadataSize)}),
+                });
+            }
+
+            return index;
+        }
+
+        void CapturePendingClasses() {
+            while (!_pending_classes.empty()) {
+                const auto [class_, index] = _pending_classes.front();
+                _pending_classes.pop_front();
+
+                // Don't hold references into the class table while capturing, Add*() may grow it
+                auto result = CaptureClass(*class_);
+                _snapshot.classes[index] = std::move(result);
+            }
+        }
+
+    private:
+        [[nodiscard]] static std::uint64_t GetEnumeratorValue(const CSchemaEnumBinding& enum_, const SchemaEnumeratorInfoData_t& enumerator) {
+            switch (enum_.m_unAlignOf) {
+            case 1:
+                return enumerator.m_uint8;
+            case 2:
+                return enumerator.m_uint16;
+            case 4:
+                return enumerator.m_uint32;
+            default:
+                return enumerator.m_uint64;
+            }
+        }
+
+        [[nodiscard]] static std::vector<sdk::snapshot::Metadata> CaptureMetadata(std::span<const SchemaMetadataEntryData_t> metadata) {
+            std::vector<sdk::snapshot::Metadata> result{};
+            result.reserve(metadata.size());
+
+            for (const auto& entry : metadata) {
+                result.emplace_back(sdk::snapshot::Metadata{.name = entry.m_szName, .value = sdk::GetMetadataValue(entry)});
+            }
+
+            return result;
+        }
+
+        Index AddScope(const CSchemaSystemTypeScope& scope) {
+            if (const auto found = _scopes.find(&scope); found != _scopes.end()) {
+                return found->second;
+            }
+
+            const auto index = static_cast<Index>(_snapshot.scopes.size());
+            _snapshot.scopes.emplace_back(sdk::snapshot::Scope{.name = scope.BGetScopeName()});
+            _scopes.emplace(&scope, index);
+
+            return index;
+        }
+
+        /// A class or enum binding
+        using DeclaredType = std::variant<const CSchemaClassBinding*, const CSchemaEnumBinding*>;
+
+        /// Bindings declared in a scope. Names are owned by the bindings.
+        struct DeclaredTypeIndex {
+            absl::flat_hash_map<std::string_view, const CSchemaClassBinding*> classes{};
+            absl::flat_hash_map<std::string_view, const CSchemaEnumBinding*> enums{};
+            /// @ref nullptr for the global scope
+            const DeclaredTypeIndex* global{};
+        };
+
+        /// Indexes all bindings of @p scope, so names can be looked up without calling into the schema system
+        const DeclaredTypeIndex& GetDeclaredTypeIndex(const CSchemaSystemTypeScope& scope) {
+            if (const auto found = _declared_types.find(&scope); found != _declared_types.end()) {
+                return *found->second;
+            }
+
+            auto index = std::make_unique<DeclaredTypeIndex>();
+
+            if (const auto* global = scope.GetGlobalTypeScope()) {
+                index->global = &GetDeclaredTypeIndex(*global);
+            }
+
+            // If names are declared more than once, the first one wins
+            for (const auto* el : scope.GetClassBindings().GetElements()) {
+                index->classes.try_emplace(el->m_pszName, el);
+            }
+            for (const auto* el : scope.GetEnumBindings().GetElements()) {
+                index->enums.try_emplace(el->m_pszName, el);
+            }
+
+            return *_declared_types.emplace(&scope, std::move(index)).first->second;
+        }
+
+        /// Equivalent to @ref CSchemaSystemTypeScope::FindDeclaredClass(), then @ref CSchemaSystemTypeScope::FindDeclaredEnum(). Both look
+        /// up names in the global scope if they are not declared in @p index.
+        [[nodiscard]] static std::optional<DeclaredType> FindDeclaredType(const DeclaredTypeIndex& index, std::string_view name) {
+            for (const auto* scope = &index; scope != nullptr; scope = scope->global) {
+                if (const auto found = scope->classes.find(name); found != scope->classes.end()) {
+                    return found->second;
+                }
+            }
+
+            for (const auto* scope = &index; scope != nullptr; scope = scope->global) {
+                if (const auto found = scope->enums.find(name); found != scope->enums.end()) {
+                    return found->second;
+                }
+            }
+
+            return std::nullopt;
+        }
+
+        [[nodiscard]] static std::string_view GetModule(const DeclaredType& type) {
+            return std::visit([](const auto* binding) { return std::string_view{binding->m_pszModule}; }, type);
+        }
+
+        /// Calls into the schema system, only use in assertions
+        [[nodiscard]] static bool IsSameAsSchemaSystem(const CSchemaSystemTypeScope& scope, std::string_view name,
+                                                       const std::optional<DeclaredType>& found) {
+            // The lookup functions need a null-terminated string
+            const std::string terminated_name{name};
+
+            if (const auto* class_ = scope.FindDeclaredClass(terminated_name)) {
+                return found.has_value() && std::holds_alternative<const CSchemaClassBinding*>(found.value()) &&
+                       (GetModule(found.value()) == class_->m_pszModule);
+            } else if (const auto* enum_ = scope.FindDeclaredEnum(terminated_name)) {
+                return found.has_value() && std::holds_alternative<const CSchemaEnumBinding*>(found.value()) &&
+                       (GetModule(found.value()) == enum_->m_pszModule);
+            } else {
+                return !found.has_value();
+            }
+        }
+
+        /// Looks up all names used by @p type_name in @p scope and stores the results
+        void RecordLookups(const CSchemaSystemTypeScope& scope, Index scope_index, std::string_view type_name) {
+            const auto& index = GetDeclaredTypeIndex(scope);
+
+            ForEachLookedUpName(type_name, [&](std::string_view name) {
+                if (!_looked_up.emplace(scope_index, std::string{name}).second) {
+                    return;
+                }
+
+                const auto found = FindDeclaredType(index, name);
+
+                ++_stats.lookups;
+                // FindDeclaredEnum() is only called if FindDeclaredClass() didn't find anything
+                _stats.avoided_virtual_calls += (found.has_value() && std::holds_alternative<const CSchemaClassBinding*>(found.value())) ? 1 : 2;
+
+                assert(IsSameAsSchemaSystem(scope, name, found) && "declared type index is out of sync with the schema system");
+
+                if (found.has_value()) {
+                    _snapshot.scopes[scope_index].declared_types.emplace(name, GetModule(found.value()));
+                }
+            });
+        }
+
+        Index AddType(const CSchemaType& type) {
+            if (const auto found = _types.find(&type); found != _types.end()) {
+                return found->second;
+            }
+
+            const auto index = static_cast<Index>(_snapshot.types.size());
+            _types.emplace(&type, index);
+
+            sdk::snapshot::Type result{
+                .name = type.m_pszName,
+                .category = type.GetTypeCategory(),
+            };
+
+            if (const auto size_and_alignment = type.GetSizeAndAlignment()) {
+                result.size = size_and_alignment->first;
+                result.alignment = size_and_alignment->second;
+            }
+
+            _snapshot.types.emplace_back(result);
+
+            // The generator resolves the name of the array's element type in the scope of the array
+            const auto* element_type = &type;
+            if (const auto* pointee = type.GetRefClass()) {
+                element_type = pointee;
+            }
+            while (element_type->GetTypeCategory() == ETypeCategory::Schema_FixedArray) {
+                element_type = reinterpret_cast<const CSchemaType_FixedArray*>(element_type)->m_pElementType;
+            }
+
+            if (type.m_pTypeScope != nullptr) {
+                result.scope = AddScope(*type.m_pTypeScope);
+                RecordLookups(*type.m_pTypeScope, result.scope, type.m_pszName);
+                RecordLookups(*type.m_pTypeScope, result.scope, element_type->m_pszName);
+            }
+
+            if (const auto* declared_class = type.GetAsDeclaredClass(); declared_class != nullptr && declared_class->m_pClassInfo != nullptr) {
+                result.declared_class = AddClass(*declared_class->m_pClassInfo);
+            }
+
+            if (const auto* pointee = type.GetRefClass()) {
+                result.pointee = AddType(*pointee);
+            }
+
+            if (type.GetTypeCategory() == ETypeCategory::Schema_FixedArray) {
+                const auto& array = *reinterpret_cast<const CSchemaType_FixedArray*>(&type);
+                result.element_type = AddType(*array.m_pElementType);
+                result.element_count = array.m_nElementCount;
+            }
+
+            _snapshot.types[index] = std::move(result);
+
+            return index;
+        }
+
+        [[nodiscard]] sdk::snapshot::Class CaptureClass(const CSchemaClassInfo& class_) {
+            sdk::snapshot::Class result{
+                .name = std::string{class_.GetName()},
+                .module = std::string{class_.GetModule()},
+                .size = class_.GetSize(),
+                .registered_alignment = class_.GetRegisteredAlignment(),
+                .flags = static_cast<std::uint32_t>(class_.m_nClassFlags),
+                .static_metadata = CaptureMetadata(std::span{class_.m_pStaticMetadata, static_cast<std::size_t>(class_.m_nStaticMetadataSize)}),
+            };
+
+            if (class_.m_pTypeScope != nullptr) {
+                result.scope = AddScope(*class_.m_pTypeScope);
+                RecordLookups(*class_.m_pTypeScope, result.scope, result.name);
+            }
+
+            if (class_.m_pSchemaType != nullptr) {
+                result.self_type = AddType(*class_.m_pSchemaType);
+            }
+
+            if (class_.m_pBaseClasses != nullptr && class_.m_pBaseClasses->m_pClass != nullptr) {
+                result.base_class = AddClass(*class_.m_pBaseClasses->m_pClass);
+            }
+
+            for (const auto& field : std::span{class_.m_pFields, static_cast<std::size_t>(class_.m_nFieldSize)}) {
+                result.fields.emplace_back(sdk::snapshot::Field{
+                    .name = field.m_pszName,
+                    .type = AddType(*field.m_pSchemaType),
+                    .offset = field.m_nSingleInheritanceOffset,
+                    .metadata = CaptureMetadata(std::span{field.m_pMetadata, static_cast<std::size_t>(field.m_nMetadataSize)}),
+                });
+            }
+
+            // The class info layouts of the supported games don't have static fields, Class::static_fields stays empty.
+
+            if (const auto* datamap = class_.m_pFieldMetadataOverrides; datamap != nullptr && datamap->m_iTypeDescriptionCount > 1) {
+                for (const auto& entry : std::span{datamap->m_pTypeDescription, static_cast<std::size_t>(datamap->m_iTypeDescriptionCount)}) {
+                    if (entry.GetFieldName().empty()) {
+                        continue;
+                    }
+
+                    result.datamap.emplace_back(sdk::snapshot::DatamapField{
+                        .name = entry.GetFieldName(),
+                        .type = entry.m_iFieldType,
+                        .size = entry.m_nFieldSize,
+                        .offset = entry.m_iOffset,
+                        .embedded_class = (entry.m_iFieldType == fieldtype_t::FIELD_EMBEDDED) ? entry.m_pDataMap->m_pszClassName : "",
+                    });
+                }
+            }
+
+            return result;
+        }
+
+        sdk::snapshot::Snapshot& _snapshot;
+        std::unordered_map<const CSchemaClassInfo*, Index> _classes{};
+        std::unordered_map<const CSchemaType*, Index> _types{};
+        std::unordered_map<const CSchemaSystemTypeScope*, Index> _scopes{};
+        /// {scope, name} of all lookups that have been recorded
+        std::set<std::pair<Index, std::string>> _looked_up{};
+        /// Index entries reference the index of the global scope, they must not move
+        std::unordered_map<const CSchemaSystemTypeScope*, std::unique_ptr<DeclaredTypeIndex>> _declared_types{};
+        sdk::snapshot::CaptureStats _stats{};
+        std::deque<std::pair<const CSchemaClassInfo*, Index>> _pending_classes{};
+    };
+
+    /// The sets of a @ref sdk::ModuleDump are ordered by the addresses of the bindings, which change from run to run
+    /// @return @p bindings in name order
+    template <typename Binding>
+    [[nodiscard]] std::vector<const Binding*> SortByName(const std::unordered_set<const Binding*>& bindings) {
+        std::vector<const Binding*> result{bindings.begin(), bindings.end()};
+        std::ranges::sort(result, {}, [](const Binding* binding) { return std::string_view{binding->m_pszName}; });
+        return result;
+    }
+
+    /// Thrown by @ref Decoder if the snapshot ends early or contains invalid values
+    struct CorruptSnapshot : std::runtime_error {
+        using std::runtime_error::runtime_error;
+    };
+
+    /// Writes integers as LEB128 and strings as indices into a string table. The string table is written in front of the encoded data.
+    class Encoder {
+    public:
+        void Unsigned(std::uint64_t value) {
+            do {
+                const auto byte = static_cast<char>(value & 0x7f);
+                value >>= 7;
+                _data += static_cast<char>(byte | ((value != 0) ? 0x80 : 0));
+            } while (value != 0);
+        }
+
+        void Signed(std::int64_t value) {
+            // zig-zag encoding keeps small negative numbers small
+            Unsigned((static_cast<std::uint64_t>(value) << 1) ^ static_cast<std::uint64_t>(value >> 63));
+        }
+
+        void OptionalInt(const std::optional<int>& value) {
+            Unsigned(value.has_value() ? ((static_cast<std::uint64_t>(static_cast<std::uint32_t>(value.value())) << 1) | 1) : 0);
+        }
+
+        void Reference(Index index) {
+            Unsigned((index == kNone) ? 0 : (std::uint64_t{index} + 1));
+        }
+
+        void String(std::string_view value) {
+            const auto [it, inserted] = _string_ids.try_emplace(std::string{value}, _string_ids.size());
+            if (inserted) {
+                _strings.emplace_back(it->first);
+            }
+            Unsigned(it->second);
+        }
+
+        template <typename Range, typename Fn>
+        void List(const Range& range, Fn&& fn) {
+            Unsigned(std::size(range));
+            for (const auto& el : range) {
+                fn(el);
+            }
+        }
+
+        [[nodiscard]] std::string Finish() && {
+            Encoder table{};
+            table.Unsigned(_strings.size());
+            for (const auto& str : _strings) {
+                table.Unsigned(str.size());
+                table._data += str;
+            }
+
+            return std::format("{}{}{}", kHeader, table._data, _data);
+        }
+
+    private:
+        std::string _data{};
+        std::unordered_map<std::string, std::size_t> _string_ids{};
+        /// Views keys of @ref _string_ids, in order of their ids
+        std::vector<std::string_view> _strings{};
+    };
+
+    class Decoder {
+    public:
+        /// @param data Without @ref kHeader
+        explicit Decoder(std::string_view data) : _data(data) {
+            const auto count = Count();
+            _strings.reserve(count);
+            for (std::size_t i = 0; i < count; ++i) {
+                const auto size = Count();
+                _strings.emplace_back(Take(size));
+            }
+        }
+
+        [[nodiscard]] std::uint64_t Unsigned() {
+            std::uint64_t result = 0;
+
+            for (int shift = 0; shift < 64; shift += 7) {
+                const auto byte = static_cast<std::uint8_t>(Take(1)[0]);
+                result |= static_cast<std::uint64_t>(byte & 0x7f) << shift;
+                if ((byte & 0x80) == 0) {
+                    return result;
+                }
+            }
+
+            throw CorruptSnapshot{"integer is too long"};
+        }
+
+        [[nodiscard]] std::int64_t Signed() {
+            const auto value = Unsigned();
+            return static_cast<std::int64_t>((value >> 1) ^ (~(value & 1) + 1));
+        }
+
+        template <typename Integer>
+        [[nodiscard]] Integer UnsignedAs() {
+            const auto value = Unsigned();
+            if (value > std::numeric_limits<Integer>::max()) {
+                throw CorruptSnapshot{std::format("{} is out of range", value)};
+            }
+            return static_cast<Integer>(value);
+        }
+
+        template <typename Integer>
+        [[nodiscard]] Integer SignedAs() {
+            const auto value = Signed();
+            if (value < std::numeric_limits<Integer>::min() || value > std::numeric_limits<Integer>::max()) {
+                throw CorruptSnapshot{std::format("{} is out of range", value)};
+            }
+            return static_cast<Integer>(value);
+        }
+
+        [[nodiscard]] std::optional<int> OptionalInt() {
+            const auto value = Unsigned();
+            if ((value & 1) == 0) {
+                return std::nullopt;
+            }
+            return static_cast<int>(static_cast<std::uint32_t>(value >> 1));
+        }
+
+        /// Range checks happen once all tables have been read
+        [[nodiscard]] Index Reference() {
+            const auto value = UnsignedAs<Index>();
+            return (value == 0) ? kNone : (value - 1);
+        }
+
+        [[nodiscard]] std::string String() {
+            const auto id = Unsigned();
+            if (id >= _strings.size()) {
+                throw CorruptSnapshot{std::format("string {} is out of range", id)};
+            }
+            return std::string{_strings[id]};
+        }
+
+        /// @return A count of elements that are at least one byte large each, so corrupt counts can't trigger huge allocations
+        [[nodiscard]] std::size_t Count() {
+            const auto count = Unsigned();
+            if (count > _data.size()) {
+                throw CorruptSnapshot{std::format("count {} exceeds the remaining data", count)};
+            }
+            return static_cast<std::size_t>(count);
+        }
+
+        template <typename Value, typename Fn>
+        [[nodiscard]] std::vector<Value> List(Fn&& fn) {
+            std::vector<Value> result(Count());
+            for (auto& el : result) {
+                el = fn();
+            }
+            return result;
+        }
+
+        [[nodiscard]] bool IsDone() const {
+            return _data.empty();
+        }
+
+    private:
+        std::string_view Take(std::size_t size) {
+            if (size > _data.size()) {
+                throw CorruptSnapshot{"unexpected end of data"};
+            }
+
+            const auto result = _data.substr(0, size);
+            _data.remove_prefix(size);
+            return result;
+        }
+
+        std::string_view _data{};
+        std::vector<std::string_view> _strings{};
+    };
+
+    void EncodeMetadata(Encoder& out, const std::vector<sdk::snapshot::Metadata>& metadata) {
+        out.List(metadata, [&](const auto& el) {
+            out.String(el.name);
+            out.String(el.value);
+        });
+    }
+
+    [[nodiscard]] std::vector<sdk::snapshot::Metadata> DecodeMetadata(Decoder& in) {
+        return in.List<sdk::snapshot::Metadata>([&]() { return sdk::snapshot::Metadata{.name = in.String(), .value = in.String()}; });
+    }
+
+    [[nodiscard]] std::string Encode(const sdk::snapshot::Snapshot& snapshot) {
+        Encoder out{};
+
+        out.String(snapshot.game);
+
+        out.List(snapshot.module_hashes, [&](const auto& el) {
+            out.String(el.name);
+            out.Unsigned(el.hash);
+        });
+
+        out.List(snapshot.scopes, [&](const sdk::snapshot::Scope& el) {
+            out.String(el.name);
+            out.List(el.declared_types, [&](const auto& declared_type) {
+                out.String(declared_type.first);
+                out.String(declared_type.second);
+            });
+        });
+
+        out.List(snapshot.types, [&](const sdk::snapshot::Type& el) {
+            out.String(el.name);
+            out.Reference(el.scope);
+            out.Unsigned(static_cast<std::uint64_t>(el.category));
+            out.OptionalInt(el.size);
+            out.OptionalInt(el.alignment);
+            out.Reference(el.declared_class);
+            out.Reference(el.pointee);
+            out.Reference(el.element_type);
+            out.Signed(el.element_count);
+        });
+
+        out.List(snapshot.classes, [&](const sdk::snapshot::Class& el) {
+            out.String(el.name);
+            out.String(el.module);
+            out.Reference(el.scope);
+            out.Reference(el.self_type);
+            out.Signed(el.size);
+            out.OptionalInt(el.registered_alignment);
+            out.Unsigned(el.flags);
+            out.Reference(el.base_class);
+            out.List(el.fields, [&](const sdk::snapshot::Field& field) {
+                out.String(field.name);
+                out.Reference(field.type);
+                out.Signed(field.offset);
+                EncodeMetadata(out, field.metadata);
+            });
+            out.List(el.static_fields, [&](const sdk::snapshot::StaticField& field) {
+                out.String(field.name);
+                out.Reference(field.type);
+                EncodeMetadata(out, field.metadata);
+            });
+            EncodeMetadata(out, el.static_metadata);
+            out.List(el.datamap, [&](const sdk::snapshot::DatamapField& field) {
+                out.String(field.name);
+                out.Unsigned(static_cast<std::uint64_t>(field.type));
+                out.Unsigned(field.size);
+                out.Signed(field.offset);
+                out.String(field.embedded_class);
+            });
+        });
+
+        out.List(snapshot.enums, [&](const sdk::snapshot::Enum& el) {
+            out.String(el.name);
+            out.String(el.module);
+            out.Unsigned(el.size);
+            out.Unsigned(el.alignment);
+            out.List(el.enumerators, [&](const sdk::snapshot::Enumerator& enumerator) {
+                out.String(enumerator.name);
+                out.Unsigned(enumerator.value);
+                EncodeMetadata(out, enumerator.metadata);
+            });
+            EncodeMetadata(out, el.static_metadata);
+        });
+
+        out.List(snapshot.modules, [&](const auto& el) {
+            out.String(el.first);
+            out.List(el.second.enums, [&](Index index) { out.Reference(index); });
+            out.List(el.second.classes, [&](Index index) { out.Reference(index); });
+        });
+
+        return std::move(out).Finish();
+    }
+
+    /// Throws @ref CorruptSnapshot if a reference points outside of its table
+    void ValidateReferences(const sdk::snapshot::Snapshot& snapshot) {
+        const auto check = [](Index index, std::size_t table_size, bool allow_none) {
+            if ((index == kNone) ? !allow_none : (index >= table_size)) {
+                throw CorruptSnapshot{std::format("reference {} is out of range", index)};
+            }
+        };
+
+        for (const auto& el : snapshot.types) {
+            check(el.scope, snapshot.scopes.size(), true);
+            check(el.declared_class, snapshot.classes.size(), true);
+            check(el.pointee, snapshot.types.size(), true);
+            check(el.element_type, snapshot.types.size(), true);
+        }
+
+        for (const auto& el : snapshot.classes) {
+            check(el.scope, snapshot.scopes.size(), true);
+            check(el.self_type, snapshot.types.size(), true);
+            check(el.base_class, snapshot.classes.size(), true);
+            for (const auto& field : el.fields) {
+                check(field.type, snapshot.types.size(), false);
+            }
+            for (const auto& field : el.static_fields) {
+                check(field.type, snapshot.types.size(), false);
+            }
+        }
+
+        for (const auto& [_, module] : snapshot.modules) {
+            for (const auto index : module.enums) {
+                check(index, snapshot.enums.size(), false);
+            }
+            for (const auto index : module.classes) {
+                check(index, snapshot.classes.size(), false);
+            }
+        }
+    }
+
+    [[nodiscard]] sdk::snapshot::Snapshot Decode(std::string_view data) {
+        Decoder in{data};
+        sdk::snapshot::Snapshot result{};
+
+        result.game = in.String();
+
+        result.module_hashes =
+            in.List<sdk::snapshot::ModuleHash>([&]() { return sdk::snapshot::ModuleHash{.name = in.String(), .hash = in.Unsigned()}; });
+
+        result.scopes = in.List<sdk::snapshot::Scope>([&]() {
+            sdk::snapshot::Scope scope{.name = in.String()};
+            for (auto count = in.Count(); count != 0; --count) {
+                auto name = in.String();
+                scope.declared_types.emplace(std::move(name), in.String());
+            }
+            return scope;
+        });
+
+        result.types = in.List<sdk::snapshot::Type>([&]() {
+            return sdk::snapshot::Type{
+                .name = in.String(),
+                .scope = in.Reference(),
+                .category = static_cast<ETypeCategory>(in.UnsignedAs<std::uint8_t>()),
+                .size = in.OptionalInt(),
+                .alignment = in.OptionalInt(),
+                .declared_class = in.Reference(),
+                .pointee = in.Reference(),
+                .element_type = in.Reference(),
+                .element_count = in.SignedAs<int>(),
+            };
+        });
+
+        result.classes = in.List<sdk::snapshot::Class>([&]() {
+            return sdk::snapshot::Class{
+                .name = in.String(),
+                .module = in.String(),
+                .scope = in.Reference(),
+                .self_type = in.Reference(),
+                .size = in.SignedAs<std::int32_t>(),
+                .registered_alignment = in.OptionalInt(),
+                .flags = in.UnsignedAs<std::uint32_t>(),
+                .base_class = in.Reference(),
+                .fields = in.List<sdk::snapshot::Field>([&]() {
+                    return sdk::snapshot::Field{
+                        .name = in.String(),
+                        .type = in.Reference(),
+                        .offset = in.SignedAs<std::int32_t>(),
+                        .metadata = DecodeMetadata(in),
+                    };
+                }),
+                .static_fields = in.List<sdk::snapshot::StaticField>([&]() {
+                    return sdk::snapshot::StaticField{
+                        .name = in.String(),
+                        .type = in.Reference(),
+                        .metadata = DecodeMetadata(in),
+                    };
+                }),
+                .static_metadata = DecodeMetadata(in),
+                .datamap = in.List<sdk::snapshot::DatamapField>([&]() {
+                    return sdk::snapshot::DatamapField{
+                        .name = in.String(),
+                        .type = static_cast<fieldtype_t>(in.UnsignedAs<std::uint8_t>()),
+                        .size = in.UnsignedAs<std::uint16_t>(),
+                        .offset = in.SignedAs<std::int32_t>(),
+                        .embedded_class = in.String(),
+                    };
+                }),
+            };
+        });
+
+        result.enums = in.List<sdk::snapshot::Enum>([&]() {
+            return sdk::snapshot::Enum{
+                .name = in.String(),
+                .module = in.String(),
+                .size = in.UnsignedAs<std::uint8_t>(),
+                .alignment = in.UnsignedAs<std::uint8_t>(),
+                .enumerators = in.List<sdk::snapshot::Enumerator>([&]() {
+                    return sdk::snapshot::Enumerator{
+                        .name = in.String(),
+                        .value = in.Unsigned(),
+                        .metadata = DecodeMetadata(in),
+                    };
+                }),
+                .static_metadata = DecodeMetadata(in),
+            };
+        });
+
+        for (auto count = in.Count(); count != 0; --count) {
+            auto name = in.String();
+            auto enums = in.List<Index>([&]() { return in.Reference(); });
+            auto classes = in.List<Index>([&]() { return in.Reference(); });
+            result.modules.emplace(std::move(name), sdk::snapshot::ModuleTypes{.enums = std::move(enums), .classes = std::move(classes)});
+        }
+
+        if (!in.IsDone()) {
+            throw CorruptSnapshot{"unexpected data after the end of the snapshot"};
+        }
+
+        ValidateReferences(result);
+
+        return result;
+    }
+} // namespace
+
+namespace sdk::snapshot {
+    std::string_view GetCurrentGame() {
+#if defined(CS2)
+        return "CS2";
+#elif defined(DOTA2)
+        return "DOTA2";
+#elif defined(SBOX)
+        return "SBOX";
+#elif defined(ARTIFACT2)
+        return "ARTIFACT2";
+#elif defined(ARTIFACT1)
+        return "ARTIFACT1";
+#elif defined(UNDERLORDS)
+        return "UNDERLORDS";
+#elif defined(DESKJOB)
+        return "DESKJOB";
+#elif defined(HL_ALYX)
+        return "HL_ALYX";
+#elif defined(THE_LAB_ROBOT_REPAIR)
+        return "THE_LAB_ROBOT_REPAIR";
+#elif defined(DEADLOCK)
+        return "DEADLOCK";
+#else
+        return "unknown";
+#endif
+    }
+
+    std::optional<std::uint64_t> HashModuleBinary(const std::filesystem::path& path) {
+        std::ifstream f(path, std::ios::binary);
+        if (!f.good()) {
+            return std::nullopt;
+        }
+
+        auto hash = fnv64::hash_init();
+        std::array<char, 1 << 16> buffer{};
+
+        while (f.read(buffer.data(), buffer.size()) || f.gcount() != 0) {
+            for (const auto c : std::span{buffer.data(), static_cast<std::size_t>(f.gcount())}) {
+                hash = fnv64::hash_byte(hash, static_cast<std::uint8_t>(c));
+            }
+        }
+
+        return f.eof() ? std::make_optional(hash) : std::nullopt;
+    }
+
+    Snapshot Capture(const std::unordered_map<std::string, ModuleDump>& modules, std::vector<ModuleHash> module_hashes, CaptureStats* stats) {
+        Snapshot result{.game = std::string{GetCurrentGame()}, .module_hashes = std::move(module_hashes)};
+        Capturer capturer{result};
+
+        // Indices are assigned in the order types are added. Add them in name order, so the same game build always yields the same snapshot.
+        std::vector<const std::pair<const std::string, ModuleDump>*> sorted_modules{};
+        sorted_modules.reserve(modules.size());
+        for (const auto& entry : modules) {
+            sorted_modules.emplace_back(&entry);
+        }
+        std::ranges::sort(sorted_modules, {}, [](const auto* entry) -> const std::string& { return entry->first; });
+
+        for (const auto* entry : sorted_modules) {
+            const auto& [module_name, dump] = *entry;
+            auto& module = result.modules[module_name];
+
+            for (const auto* el : SortByName(dump.enums)) {
+                module.enums.emplace_back(capturer.AddEnum(*el));
+            }
+
+            for (const auto* el : SortByName(dump.classes)) {
+                module.classes.emplace_back(capturer.AddClass(*el));
+            }
+        }
+
+        capturer.CapturePendingClasses();
+
+        if (stats != nullptr) {
+            *stats = capturer.GetStats();
+        }
+
+        return result;
+    }
+
+    bool Save(const Snapshot& snapshot, const std::filesystem::path& path) {
+        if (path.has_parent_path()) {
+            std::filesystem::create_directories(path.parent_path());
+        }
+
+        const auto data = Encode(snapshot);
+
+        std::ofstream f(path, std::ios::out | std::ios::trunc | std::ios::binary);
+        f.write(data.data(), static_cast<std::streamsize>(data.size()));
+
+        if (!f.good()) {
+            std::cerr << std::format("{}: Could not write to {}: {}", __FUNCTION__, path.string(), std::strerror(errno)) << std::endl;
+            return false;
+        }
+
+        return true;
+    }
+
+    std::expected<Snapshot, std::string> Load(const std::filesystem::path& path) {
+        std::ifstream f(path, std::ios::binary);
+        if (!f.good()) {
+            return std::unexpected(std::format("Could not read from {}: {}", path.string(), std::strerror(errno)));
+        }
+
+        const std::string data{std::istreambuf_iterator<char>{f}, std::istreambuf_iterator<char>{}};
+
+        if (!data.starts_with(kHeader)) {
+            return std::unexpected(std::format("{} is not a snapshot, or it has been saved by an incompatible version of source2gen", path.string()));
+        }
+
+        try {
+            return Decode(std::string_view{data}.substr(kHeader.size()));
+        } catch (const CorruptSnapshot& e) {
+            return std::unexpected(std::format("{} is corrupt: {}", path.string(), e.what()));
+        }
+    }
+} // namespace sdk::snapshot
+
+// source2gen - Source2 games SDK generator
+// Copyright 2024 neverlosecc
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
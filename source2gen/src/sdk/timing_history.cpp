@@ -0,0 +1,108 @@
+// Copyright (C) 2024 neverlosecc
+// See end of file for extended copyright information.
+#include "sdk/timing_history.h"
+#include <charconv>
+#include <cstring>
+#include <format>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <string_view>
+
+namespace {
+    /// First line of every history file. Bump the version if the format changes, old files will be ignored.
+    constexpr std::string_view kHeader = "source2gen-timing-history 1";
+} // namespace
+
+namespace sdk {
+    TimingHistory TimingHistory::Load(const std::filesystem::path& path) {
+        TimingHistory result{};
+
+        std::ifstream f(path);
+        if (!f.good()) {
+            return result;
+        }
+
+        std::string line{};
+        if (!std::getline(f, line) || line != kHeader) {
+            std::cerr << std::format("{}: ignoring {}, it is not a timing history", __FUNCTION__, path.string()) << std::endl;
+            return result;
+        }
+
+        // <module>\t<type>\t<nanoseconds>
+        while (std::getline(f, line)) {
+            const auto first_tab = line.find('\t');
+            const auto second_tab = line.find('\t', first_tab + 1);
+            if (first_tab == std::string::npos || second_tab == std::string::npos) {
+                continue;
+            }
+
+            std::int64_t nanoseconds = 0;
+            const auto* const count_begin = line.data() + second_tab + 1;
+            const auto* const count_end = line.data() + line.size();
+            if (const auto [ptr, ec] = std::from_chars(count_begin, count_end, nanoseconds); ec != std::errc{} || ptr != count_end) {
+                continue;
+            }
+
+            result._timings.insert_or_assign(TypeIdentifier{.module = line.substr(0, first_tab),
+                                                            .name = line.substr(first_tab + 1, second_tab - (first_tab + 1))},
+                                             std::chrono::nanoseconds{nanoseconds});
+        }
+
+        return result;
+    }
+
+    bool TimingHistory::Save(const std::filesystem::path& path) const {
+        if (path.has_parent_path()) {
+            std::filesystem::create_directories(path.parent_path());
+        }
+
+        std::ofstream f(path, std::ios::out | std::ios::trunc);
+        f << kHeader << '\n';
+
+        {
+            std::scoped_lock lock{_mutex};
+            for (const auto& [id, duration] : _timings) {
+                f << id.module << '\t' << id.name << '\t' << duration.count() << '\n';
+            }
+        }
+
+        if (!f.good()) {
+            std::cerr << std::format("{}: Could not write to {}: {}", __FUNCTION__, path.string(), std::strerror(errno)) << std::endl;
+            return false;
+        }
+
+        return true;
+    }
+
+    std::optional<std::chrono::nanoseconds> TimingHistory::Find(const TypeIdentifier& id) const {
+        std::scoped_lock lock{_mutex};
+
+        if (const auto found = _timings.find(id); found != _timings.end()) {
+            return found->second;
+        } else {
+            return std::nullopt;
+        }
+    }
+
+    void TimingHistory::Record(const TypeIdentifier& id, std::chrono::nanoseconds duration) {
+        std::scoped_lock lock{_mutex};
+        _timings.insert_or_assign(id, duration);
+    }
+} // namespace sdk
+
+// source2gen - Source2 games SDK generator
+// Copyright 2024 neverlosecc
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
@@ -0,0 +1,72 @@
+// Copyright (C) 2024 neverlosecc
+// See end of file for extended copyright information.
+#include <chrono>
+#include <format>
+#include <fstream>
+#include <Include.h>
+#include <iostream>
+#include <sdk/schema_diff.h>
+
+namespace source2_gen {
+    int Diff(const DiffOptions& options) {
+        constexpr int kDifferent = 1;
+        constexpr int kError = 2;
+
+        const auto start = std::chrono::steady_clock::now();
+
+        const auto old_schema = sdk::diff::LoadSchema(options.old_schema);
+        if (!old_schema.has_value()) {
+            std::cerr << std::format("{}: {}", __FUNCTION__, old_schema.error()) << std::endl;
+            return kError;
+        }
+
+        const auto new_schema = sdk::diff::LoadSchema(options.new_schema);
+        if (!new_schema.has_value()) {
+            std::cerr << std::format("{}: {}", __FUNCTION__, new_schema.error()) << std::endl;
+            return kError;
+        }
+
+        const auto loaded = std::chrono::steady_clock::now();
+        const auto diff = sdk::diff::Compare(old_schema.value(), new_schema.value());
+        const auto compared = std::chrono::steady_clock::now();
+
+        sdk::diff::PrintSummary(diff, std::cout);
+
+        if (options.report.has_value()) {
+            std::ofstream file{options.report.value(), std::ios::binary};
+
+            if (file.good()) {
+                sdk::diff::WriteReport(diff, file);
+                file.close();
+            }
+
+            if (!file.good()) {
+                std::cerr << std::format("{}: Could not write to {}", __FUNCTION__, options.report->string()) << std::endl;
+                return kError;
+            }
+        }
+
+        std::cerr << std::format("{}: Loaded in {} ms, compared in {} ms", __FUNCTION__,
+                                 std::chrono::duration_cast<std::chrono::milliseconds>(loaded - start).count(),
+                                 std::chrono::duration_cast<std::chrono::milliseconds>(compared - loaded).count())
+                  << std::endl;
+
+        return diff.empty() ? 0 : kDifferent;
+    }
+} // namespace source2_gen
+
+// source2gen - Source2 games SDK generator
+// Copyright 2024 neverlosecc
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
@@ -2,20 +2,35 @@
 // See end of file for extended copyright information.
 #include "options.hpp"
 #include "tools/util.h"
+#include <absl/strings/str_join.h>
 #include <array>
 #include <filesystem>
 #include <fstream>
 #include <Include.h>
 #include <iostream>
 #include <iterator>
+#include <numeric>
+#include <optional>
+#include <ranges>
+#include <sdk/amalgamation.h>
+#include <sdk/field_table.h>
+#include <sdk/include_graph.h>
+#include <sdk/json_export.h>
+#include <sdk/schema_binary.h>
 #include <sdk/sdk.h>
+#include <sdk/snapshot.h>
+#include <sdk/timing_history.h>
+#include <set>
 #include <span>
+#include <sstream>
 #include <string>
 #include <tools/loader/loader.h>
 #include <tools/platform.h>
+#include <tools/writer/output_index.h>
 #include <unordered_map>
 #include <unordered_set>
 #include <utility>
+#include <vector>
 
 namespace {
     [[nodiscard]] auto GetRequiredModules() {
@@ -57,14 +72,11 @@ namespace {
 namespace source2_gen {
     // TODO: this duplicate of the constant in sdk.h. We should let the user specify the sdk path via Options.
     constexpr std::string_view kOutDirName = "sdk";
-
-    struct module_dump {
-        std::unordered_set<const CSchemaEnumBinding*> enums{};
-        std::unordered_set<const CSchemaClassBinding*> classes{};
-    };
+    /// Inside of @ref kOutDirName. Remembers what the previous run wrote.
+    constexpr std::string_view kOutputIndexName = ".source2gen-index";
 
     /// @return Key is the module name
-    std::unordered_map<std::string, module_dump> CollectModules(std::span<CSchemaSystemTypeScope*> type_scopes) {
+    std::unordered_map<std::string, sdk::ModuleDump> CollectModules(std::span<CSchemaSystemTypeScope*> type_scopes) {
         struct unique_module_dump {
             /// Key is the enum name. Used for de-duplication.
             std::unordered_map<std::string, CSchemaEnumBinding*> enums{};
@@ -89,14 +101,14 @@ namespace source2_gen {
             }
         }
 
-        std::unordered_map<std::string, module_dump> result{};
+        std::unordered_map<std::string, sdk::ModuleDump> result{};
 
         for (const auto& [module_name, unique_dump] : dumped_modules) {
             constexpr auto to_set = [](const auto& pair) {
                 return pair.second;
             };
 
-            module_dump dump{};
+            sdk::ModuleDump dump{};
 
             std::ranges::transform(unique_dump.enums, std::inserter(dump.enums, dump.enums.end()), to_set);
 
@@ -108,45 +120,128 @@ namespace source2_gen {
         return result;
     }
 
-    /// A very basic C preprocessor.
-    /// Writes contents of @p path to @p out while expanding `#include` directives
-    void ExpandIncludesRecursive(std::ofstream& out, std::unordered_set<std::filesystem::path>& seen_files, const std::filesystem::path& path) {
-        std::ifstream f(path);
-        if (!f.good()) {
-            std::cerr << std::format("Could not read from {}: {}", path.string(), std::strerror(errno)) << std::endl;
-            std::exit(1);
-        }
+    /// Appends @p contents to @p out without preprocessor directives. IDA doesn't need them, every type is in the same file.
+    /// `#include "source2sdk/..."` directives of files that have not been generated are expanded from disk the first time they appear. Those
+    /// files are part of sdk-static.
+    /// @param generated_files Paths of the generated files
+    /// @param seen_files Files of sdk-static that have already been expanded
+    /// @return false if a file could not be read. Errors have been logged.
+    bool AppendForIda(std::string& out, std::unordered_set<std::filesystem::path>& seen_files,
+                      const std::unordered_set<std::filesystem::path>& generated_files, const std::filesystem::path& sdk_directory,
+                      std::string_view contents) {
+        constexpr std::string_view prefix = "#include \"source2sdk/";
+
+        while (!contents.empty()) {
+            const auto end_of_line = contents.find('\n');
+            const auto line = contents.substr(0, end_of_line);
+            contents.remove_prefix((end_of_line == std::string_view::npos) ? contents.size() : (end_of_line + 1));
+
+            if (!line.starts_with('#')) {
+                out.append(line);
+                out.push_back('\n');
+                continue;
+            }
 
-        std::string line{};
-        while (std::getline(f, line)) {
-            if (line.starts_with('#')) {
-                constexpr std::string_view prefix = "#include \"source2sdk/";
-
-                if (line.starts_with(prefix)) {
-                    const std::filesystem::path include_path{std::string{kOutDirName} + "/include/source2sdk/" +
-                                                             line.substr(prefix.length(), line.length() - (prefix.length() + 1))};
-                    if (!seen_files.contains(include_path)) {
-                        seen_files.emplace(include_path);
-                        ExpandIncludesRecursive(out, seen_files, include_path);
-                    }
-                }
-            } else {
-                out << line << '\n';
+            if (!line.starts_with(prefix)) {
+                continue;
+            }
+
+            const auto include_path = sdk_directory / "include/source2sdk" / line.substr(prefix.length(), line.length() - (prefix.length() + 1));
+            if (generated_files.contains(include_path) || !seen_files.emplace(include_path).second) {
+                continue;
+            }
+
+            std::ifstream f(include_path, std::ios::binary);
+            if (!f.good()) {
+                std::cerr << std::format("{}: Could not read from {}: {}", __FUNCTION__, include_path.string(), std::strerror(errno)) << std::endl;
+                return false;
+            }
+
+            const std::string included{std::istreambuf_iterator<char>{f}, std::istreambuf_iterator<char>{}};
+            if (!AppendForIda(out, seen_files, generated_files, sdk_directory, included)) {
+                return false;
             }
         }
+
+        return true;
     }
 
-    // Post-processes an already-generated C SDK so it can be parsed by IDA.
-    // - merges all files into a single file by resolving `#include`s
-    void PostProcessCIDA(const std::unordered_set<std::filesystem::path>& generated_files) {
-        const auto out_file_path = std::string{kOutDirName} + "/ida.h";
-        std::ofstream out(out_file_path, std::ios::out);
+    // Post-processes a generated C SDK so it can be parsed by IDA.
+    // - merges all files into a single file. Types are ordered by their includes, the generated files are not read back from disk.
+    // @return Contents of ida.h, @ref std::nullopt if a file of sdk-static could not be read. Errors have been logged.
+    [[nodiscard]]
+    std::optional<std::string> PostProcessCIDA(const sdk::EmitTarget& target, std::span<const sdk::GeneratedFile> files) {
+        std::unordered_set<std::filesystem::path> generated_files{};
+        std::size_t size = 0;
+
+        for (const auto& file : files) {
+            generated_files.emplace(file.path);
+            size += file.contents.size();
+        }
+
+        std::string out{};
+        out.reserve(size);
 
         std::unordered_set<std::filesystem::path> seen_files{};
 
-        for (const auto& file : generated_files) {
-            ExpandIncludesRecursive(out, seen_files, file);
+        for (const auto* file : sdk::SortByIncludes(files)) {
+            if (!AppendForIda(out, seen_files, generated_files, target.directory, file->contents)) {
+                return std::nullopt;
+            }
+        }
+
+        return out;
+    }
+
+    struct LoadedModule {
+        /// File name
+        std::string name{};
+        loader::module_handle_t handle{};
+    };
+
+    /// @return @ref std::nullopt if a module could not be hashed. Errors have been logged.
+    std::optional<std::vector<sdk::snapshot::ModuleHash>> HashModules(std::span<const LoadedModule> modules) {
+        std::vector<sdk::snapshot::ModuleHash> result{};
+
+        for (const auto& [name, handle] : modules) {
+            const auto path = loader::get_module_path(handle);
+            if (!path.has_value()) {
+                std::cerr << std::format("{}: Unable to find the file of module {}: {}", __FUNCTION__, name, path.error().as_string()) << std::endl;
+                return std::nullopt;
+            }
+
+            if (const auto hash = sdk::snapshot::HashModuleBinary(path.value())) {
+                result.emplace_back(sdk::snapshot::ModuleHash{.name = name, .hash = hash.value()});
+            } else {
+                std::cerr << std::format("{}: Could not read from {}", __FUNCTION__, path.value()) << std::endl;
+                return std::nullopt;
+            }
+        }
+
+        return result;
+    }
+
+    /// Deletes files of types that have not been generated by this run
+    /// @return Number of deleted files
+    std::size_t RemoveStaleFiles(util::OutputIndex& index) {
+        std::size_t removed = 0;
+
+        for (const auto& path : index.TakeStaleFiles()) {
+            std::error_code ec{};
+            if (std::filesystem::remove(path, ec)) {
+                ++removed;
+            } else if (ec) {
+                std::cerr << std::format("Could not remove {}: {}", path.string(), ec.message()) << std::endl;
+                continue;
+            }
+
+            // Remove directories of modules that don't exist anymore
+            if (path.has_parent_path() && std::filesystem::is_empty(path.parent_path(), ec)) {
+                std::filesystem::remove(path.parent_path(), ec);
+            }
         }
+
+        return removed;
     }
 
     [[nodiscard]]
@@ -154,22 +249,29 @@ namespace source2_gen {
         using enum source2_gen::Language;
         switch (language) {
         case cpp:
+        case cpp_offsets:
             return "cpp";
+        case cpp_modules:
+            return "cpp-modules";
         case c:
         case c_ida:
             return "c";
+        case schema_bin:
+            return "schema-bin";
+        case json:
+            return "json";
         }
 
         assert(false && "unhandled enumerator");
     }
 
+    /// @param relative_path Path relative to the repository root
+    /// @return @ref std::nullopt if @p relative_path doesn't exist
     [[nodiscard]]
-    std::filesystem::path FindSdkStatic(const Options& options) {
-        const auto directories = std::format("sdk-static/{}", GetStaticSdkName(options.emit_language));
-
+    std::optional<std::filesystem::path> FindInRepository(const std::filesystem::path& relative_path) {
         /// Try from the current cwd first
-        if (auto path = std::filesystem::path(directories); is_directory(path)) {
-            return path;
+        if (exists(relative_path)) {
+            return relative_path;
         }
 
         /// On windows, cwd will be `source2gen\build\bin\Release`.
@@ -179,24 +281,76 @@ namespace source2_gen {
         for (std::size_t i = 0; i < kDepth; ++i) {
             cwd = cwd.parent_path();
 
-            if (auto path = cwd / directories; is_directory(path)) {
+            if (auto path = cwd / relative_path; exists(path)) {
                 return path;
             }
         }
 
+        return std::nullopt;
+    }
+
+    [[nodiscard]]
+    std::filesystem::path FindSdkStatic(source2_gen::Language language) {
+        const auto directories = std::format("sdk-static/{}", GetStaticSdkName(language));
+
+        if (auto path = FindInRepository(directories); path.has_value() && is_directory(path.value())) {
+            return path.value();
+        }
+
         throw std::runtime_error(std::format("Unable to find sdk-static: {}", directories));
     }
 
-    bool Dump(Options options) try {
-        std::locale::global(std::locale(""));
-        std::cout.imbue(std::locale());
+    /// Reads the templates that don't odr-use their template arguments, see @ref Options::non_odr_templates
+    /// @return @ref std::nullopt if the file cannot be found or read. Errors have been logged.
+    [[nodiscard]]
+    std::optional<std::set<std::string, std::less<>>> LoadNonOdrTemplates() {
+        constexpr std::string_view kFileName = "sdk-static/non-odr-templates.txt";
+
+        const auto path = FindInRepository(kFileName);
+        if (!path.has_value()) {
+            std::cerr << std::format("{}: Unable to find {}, run scripts/generate_static.py", __FUNCTION__, kFileName) << std::endl;
+            return std::nullopt;
+        }
 
-        const auto modules = GetRequiredModules();
+        std::ifstream f(path.value());
+        std::set<std::string, std::less<>> result{};
 
-        for (const auto& name : modules) {
+        for (std::string line{}; std::getline(f, line);) {
+            if (!line.empty() && !line.starts_with('#')) {
+                result.emplace(std::move(line));
+            }
+        }
+
+        if (f.bad()) {
+            std::cerr << std::format("{}: Could not read {}", __FUNCTION__, path->string()) << std::endl;
+            return std::nullopt;
+        }
+
+        return result;
+    }
+
+    /// Unloads @p modules in the reverse order they have been loaded in, so modules are unloaded before the modules they depend on.
+    /// Nothing may reference memory of the modules afterwards. Failures are logged, but not fatal.
+    void UnloadModules(std::span<const LoadedModule> modules) {
+        sdk::g_schema = nullptr;
+
+        for (const auto& [name, handle] : modules | std::views::reverse) {
+            if (const auto result = loader::unload_module(handle); !result.has_value()) {
+                std::cerr << std::format("{}: Unable to unload module {}: {}", __FUNCTION__, name, result.error().as_string()) << std::endl;
+            }
+        }
+    }
+
+    /// Loads the game's modules and copies their schemas. The modules are unloaded once their schemas have been copied.
+    /// @return @ref std::nullopt on error. Errors have been logged.
+    std::optional<sdk::snapshot::Snapshot> CaptureSchemaSystem(const Options& options) {
+        std::vector<LoadedModule> modules{};
+
+        for (const auto& name : GetRequiredModules()) {
             std::cout << std::format("{}: Loading {}", __FUNCTION__, name) << std::endl;
 
-            if (loader::load_module(name).has_value()) {
+            if (const auto handle = loader::load_module(name); handle.has_value()) {
+                modules.emplace_back(LoadedModule{.name = name, .handle = handle.value()});
                 continue;
             }
 
@@ -205,7 +359,7 @@ namespace source2_gen {
             // libraries being loaded.
             std::cerr << std::format("{}: Unable to load module {}, is {} set?", __FUNCTION__, name, IF_WINDOWS("PATH") IF_LINUX("LD_LIBRARY_PATH"))
                       << std::endl;
-            return false;
+            return std::nullopt;
         }
 
         std::cout << std::format("{}: Starting", __FUNCTION__) << std::endl;
@@ -215,13 +369,10 @@ namespace source2_gen {
         sdk::g_schema = CSchemaSystem::GetInstance();
         if (!sdk::g_schema) {
             std::cerr << std::format("{}: Unable to obtain Schema interface", __FUNCTION__) << std::endl;
-            return false;
+            return std::nullopt;
         }
 
-        for (const auto& name : modules) {
-            auto* handle = loader::find_module_handle(name);
-            assert(handle != nullptr && "we loaded modules at startup, where did they go?");
-
+        for (const auto& [name, handle] : modules) {
             using InstallSchemaBindingsTy = std::uint8_t (*)(const char*, CSchemaSystem*);
             if (auto InstallSchemaBindings = loader::find_module_symbol<InstallSchemaBindingsTy>(handle, "InstallSchemaBindings");
                 InstallSchemaBindings.has_value()) {
@@ -230,7 +381,7 @@ namespace source2_gen {
                 }
 
                 std::cerr << std::format("{}: Unable to install schema bindings in {}", __FUNCTION__, name) << std::endl;
-                return false;
+                return std::nullopt;
             }
 
             std::cout << std::format("{}: No schemas in {}", __FUNCTION__, name) << std::endl;
@@ -242,28 +393,185 @@ namespace source2_gen {
 
         const std::unordered_map all_modules = CollectModules(std::span{type_scopes.m_pElements, static_cast<std::size_t>(type_scopes.m_Size)});
 
-        sdk::GeneratorCache cache{};
-        std::unordered_set<std::filesystem::path> generated_files{};
+        std::vector<sdk::snapshot::ModuleHash> module_hashes{};
 
-        for (const auto& [module_name, dump] : all_modules) {
-            const auto result = sdk::GenerateTypeScopeSdk(options, cache, module_name, dump.enums, dump.classes);
-            std::ranges::move(result.generated_files, std::inserter(generated_files, generated_files.end()));
+        // Hashing reads all modules from disk, only do it if the hashes are used
+        if (options.save_snapshot.has_value()) {
+            if (auto hashes = HashModules(modules)) {
+                module_hashes = std::move(hashes.value());
+            } else {
+                return std::nullopt;
+            }
         }
 
-        // Throws an exception with descriptive message. No need for explicit error handling.
-        // Need to do this before PostProcessCIDA() because sdk-static contains types that are
-        // missing in the generated sdk.
-        std::filesystem::copy(FindSdkStatic(options), kOutDirName,
-                              std::filesystem::copy_options::recursive | std::filesystem::copy_options::overwrite_existing);
-
-        if (options.emit_language == source2_gen::Language::c_ida) {
-            PostProcessCIDA(generated_files);
-        }
+        sdk::snapshot::CaptureStats capture_stats{};
+        auto result = sdk::snapshot::Capture(all_modules, std::move(module_hashes), &capture_stats);
 
         std::cout << std::format("Schema stats: {} registrations; {} were redundant; {} were ignored ({} bytes of ignored data)",
                                  util::PrettifyNum(sdk::g_schema->GetRegistration()), util::PrettifyNum(sdk::g_schema->GetRedundant()),
                                  util::PrettifyNum(sdk::g_schema->GetIgnored()), util::PrettifyNum(sdk::g_schema->GetIgnoredBytes()))
                   << std::endl;
+        std::cout << std::format("Capture stats: {} type name lookup(s); {} virtual call(s) into the schema system avoided", capture_stats.lookups,
+                                 capture_stats.avoided_virtual_calls)
+                  << std::endl;
+
+        // The snapshot doesn't reference the modules, their memory can be used for generation
+        UnloadModules(modules);
+
+        std::cout << std::format("{}: Unloaded {} module(s)", __FUNCTION__, modules.size()) << std::endl;
+
+        return result;
+    }
+
+    void PrintIncludeReportSummary(std::span<const sdk::IncludeReportEntry> entries) {
+        if (entries.empty()) {
+            return;
+        }
+
+        const auto sum = [entries](auto member) {
+            return std::accumulate(entries.begin(), entries.end(), std::size_t{0}, [member](std::size_t total, const auto& el) { return total + el.*member; });
+        };
+        const auto max = [entries](auto member) { return std::ranges::max(entries | std::views::transform(member)); };
+        const auto average = [&](auto member) { return static_cast<double>(sum(member)) / static_cast<double>(entries.size()); };
+
+        using Entry = sdk::IncludeReportEntry;
+        std::cout << std::format("Includes per header: {:.1f} -> {:.1f} direct; {:.1f} -> {:.1f} transitive on average, {} -> {} at most",
+                                 average(&Entry::includes_before), average(&Entry::includes_after), average(&Entry::closure_before),
+                                 average(&Entry::closure_after), max(&Entry::closure_before), max(&Entry::closure_after))
+                  << std::endl;
+    }
+
+    /// @return @ref std::nullopt on error. Errors have been logged.
+    std::optional<sdk::snapshot::Snapshot> LoadSnapshot(const std::filesystem::path& path) {
+        std::cout << std::format("{}: Loading snapshot {}", __FUNCTION__, path.string()) << std::endl;
+
+        auto result = sdk::snapshot::Load(path);
+        if (!result.has_value()) {
+            std::cerr << std::format("{}: {}", __FUNCTION__, result.error()) << std::endl;
+            return std::nullopt;
+        }
+
+        // Class flags and the layout of the generated sdk depend on the game
+        if (result->game != sdk::snapshot::GetCurrentGame()) {
+            std::cerr << std::format("{}: {} has been captured from {}, but source2gen has been built for {}", __FUNCTION__, path.string(),
+                                     result->game, sdk::snapshot::GetCurrentGame())
+                      << std::endl;
+            return std::nullopt;
+        }
+
+        // The snapshot may be of another game build than the one installed, tell the user which one it is
+        if (result->module_hashes.empty()) {
+            std::cout << std::format("{}: The snapshot doesn't record the game modules it has been captured from", __FUNCTION__) << std::endl;
+        } else {
+            std::cout << std::format("{}: Captured from {}", __FUNCTION__,
+                                     absl::StrJoin(result->module_hashes, ", ",
+                                                   [](std::string* out, const sdk::snapshot::ModuleHash& el) {
+                                                       out->append(std::format("{} ({:#018x})", el.name, el.hash));
+                                                   }))
+                      << std::endl;
+        }
+
+        return std::move(result.value());
+    }
+
+    bool Dump(Options options) try {
+        std::locale::global(std::locale(""));
+        std::cout.imbue(std::locale());
+
+        auto schema = options.from_snapshot.has_value() ? LoadSnapshot(options.from_snapshot.value()) : CaptureSchemaSystem(options);
+        if (!schema.has_value()) {
+            return false;
+        }
+
+        if (options.save_snapshot.has_value()) {
+            if (!sdk::snapshot::Save(schema.value(), options.save_snapshot.value())) {
+                return false;
+            }
+
+            std::cout << std::format("{}: Saved snapshot of {} class(es) and {} enum(s) to {}", __FUNCTION__, schema->classes.size(),
+                                     schema->enums.size(), options.save_snapshot->string())
+                      << std::endl;
+        }
+
+        if (auto non_odr_templates = LoadNonOdrTemplates(); non_odr_templates.has_value()) {
+            options.non_odr_templates = std::move(non_odr_templates.value());
+        } else {
+            std::cerr << std::format("{}: Including the arguments of all templates except {}", __FUNCTION__,
+                                     absl::StrJoin(options.non_odr_templates, ", "))
+                      << std::endl;
+        }
+
+        sdk::GeneratorCache cache{};
+        auto history = options.timing_history.has_value() ? sdk::TimingHistory::Load(options.timing_history.value()) : sdk::TimingHistory{};
+
+        const auto index_path = std::format("{}/{}", kOutDirName, kOutputIndexName);
+        auto index = util::OutputIndex::Load(index_path);
+
+        util::AsyncFileWriter writer{[&options]() { return util::MakeWriteBackend(options.write_backend); }, util::AsyncWriterOptions{}, &index};
+
+        const auto targets = sdk::GetEmitTargets(options);
+        const auto generated = sdk::GenerateSdk(options, targets, cache, writer, schema.value(), history);
+        const auto field_table = options.field_table ? sdk::BuildFieldTable(schema.value()) : sdk::FieldTable{};
+
+        for (std::size_t i = 0; i < targets.size(); ++i) {
+            const auto& target = targets[i];
+
+            // Throws an exception with descriptive message. No need for explicit error handling.
+            // Need to do this before PostProcessCIDA() because sdk-static contains types that are
+            // missing in the generated sdk.
+            // Files that are already up-to-date are not copied to preserve their modification time.
+            std::filesystem::copy(FindSdkStatic(target.language), target.directory,
+                                  std::filesystem::copy_options::recursive | std::filesystem::copy_options::update_existing);
+
+            if (target.language == source2_gen::Language::c_ida) {
+                auto ida = PostProcessCIDA(target, generated.files[i]);
+                if (!ida.has_value()) {
+                    return false;
+                }
+
+                writer.Enqueue(target.directory / "ida.h", std::move(ida.value()));
+            }
+
+            sdk::AmalgamateSdk(target, generated.files[i], writer);
+            sdk::AssembleModuleUnits(target, generated.files[i], writer);
+            sdk::WriteFieldTable(target, field_table, writer);
+            sdk::WriteSchemaBinary(target, schema.value(), writer);
+
+            if (!sdk::WriteJsonSchema(target, schema.value())) {
+                return false;
+            }
+        }
+
+        const auto summary = writer.Finish();
+
+        if (!summary.errors.empty()) {
+            for (const auto& error : summary.errors) {
+                std::cerr << std::format("Could not write to {}: {}", error.path.string(), error.message) << std::endl;
+            }
+
+            std::cerr << std::format("{}: {} file(s) could not be written", __FUNCTION__, summary.errors.size()) << std::endl;
+            index.Save(index_path);
+            return false;
+        }
+
+        const auto removed = RemoveStaleFiles(index);
+        index.Save(index_path);
+
+        std::cout << std::format("Output: {} file(s) written; {} unchanged file(s) skipped; {} stale file(s) removed",
+                                 summary.written, summary.skipped, removed)
+                  << std::endl;
+
+        if (options.timing_history.has_value()) {
+            history.Save(options.timing_history.value());
+        }
+
+        if (options.include_report.has_value()) {
+            PrintIncludeReportSummary(generated.include_report);
+
+            if (!sdk::SaveIncludeReport(options.include_report.value(), generated.include_report)) {
+                return false;
+            }
+        }
 
         return true;
     } catch (const std::runtime_error& err) {
@@ -0,0 +1,172 @@
+// Copyright (C) 2024 neverlosecc
+// See end of file for extended copyright information.
+#include "tools/json_writer.h"
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <iterator>
+
+namespace {
+    /// Characters that need to be escaped in JSON strings are `"`, `\`, and the control characters
+    constexpr auto kEscapes = []() {
+        std::array<bool, 256> result{};
+
+        for (std::size_t i = 0; i < 0x20; ++i) {
+            result[i] = true;
+        }
+
+        result['"'] = true;
+        result['\\'] = true;
+
+        return result;
+    }();
+
+    void AppendEscaped(std::string& out, std::string_view value) {
+        constexpr std::string_view hex = "0123456789abcdef";
+
+        out.push_back('"');
+
+        while (!value.empty()) {
+            // Copy runs of characters that don't need escaping at once, most names don't need any
+            const auto escape = std::ranges::find_if(value, [](char c) { return kEscapes[static_cast<unsigned char>(c)]; });
+            const auto run = static_cast<std::size_t>(std::distance(value.begin(), escape));
+            out.append(value.data(), run);
+            value.remove_prefix(run);
+
+            if (value.empty()) {
+                break;
+            }
+
+            switch (const auto c = value.front()) {
+            case '"':
+                out.append("\\\"");
+                break;
+            case '\\':
+                out.append("\\\\");
+                break;
+            case '\n':
+                out.append("\\n");
+                break;
+            case '\r':
+                out.append("\\r");
+                break;
+            case '\t':
+                out.append("\\t");
+                break;
+            default:
+                out.append("\\u00");
+                out.push_back(hex[static_cast<unsigned char>(c) >> 4]);
+                out.push_back(hex[static_cast<unsigned char>(c) & 0xf]);
+                break;
+            }
+
+            value.remove_prefix(1);
+        }
+
+        out.push_back('"');
+    }
+} // namespace
+
+namespace util {
+    JsonWriter::JsonWriter(std::ostream& out) : _out(out) {
+        _buffer.reserve(kBufferSize);
+    }
+
+    JsonWriter::~JsonWriter() {
+        Flush();
+    }
+
+    void JsonWriter::BeginObject() {
+        BeginValue();
+        _buffer.push_back('{');
+        _has_elements.emplace_back(false);
+    }
+
+    void JsonWriter::EndObject() {
+        assert(!_has_elements.empty() && !_after_key);
+        _has_elements.pop_back();
+        _buffer.push_back('}');
+        FlushIfFull();
+    }
+
+    void JsonWriter::BeginArray() {
+        BeginValue();
+        _buffer.push_back('[');
+        _has_elements.emplace_back(false);
+    }
+
+    void JsonWriter::EndArray() {
+        assert(!_has_elements.empty());
+        _has_elements.pop_back();
+        _buffer.push_back(']');
+        FlushIfFull();
+    }
+
+    void JsonWriter::Key(std::string_view key) {
+        assert(!_after_key);
+        BeginValue();
+        AppendEscaped(_buffer, key);
+        _buffer.push_back(':');
+        _after_key = true;
+    }
+
+    void JsonWriter::String(std::string_view value) {
+        BeginValue();
+        AppendEscaped(_buffer, value);
+        FlushIfFull();
+    }
+
+    void JsonWriter::Bool(bool value) {
+        BeginValue();
+        _buffer.append(value ? "true" : "false");
+        FlushIfFull();
+    }
+
+    void JsonWriter::Null() {
+        BeginValue();
+        _buffer.append("null");
+        FlushIfFull();
+    }
+
+    void JsonWriter::Flush() {
+        _out.write(_buffer.data(), static_cast<std::streamsize>(_buffer.size()));
+        _buffer.clear();
+    }
+
+    void JsonWriter::BeginValue() {
+        if (_after_key) {
+            _after_key = false;
+            return;
+        }
+
+        if (!_has_elements.empty()) {
+            if (_has_elements.back()) {
+                _buffer.push_back(',');
+            }
+
+            _has_elements.back() = true;
+        }
+    }
+
+    void JsonWriter::FlushIfFull() {
+        if (_buffer.size() >= kBufferSize) {
+            Flush();
+        }
+    }
+} // namespace util
+
+// source2gen - Source2 games SDK generator
+// Copyright 2024 neverlosecc
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
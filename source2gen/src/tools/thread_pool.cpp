@@ -0,0 +1,147 @@
+// Copyright (C) 2024 neverlosecc
+// See end of file for extended copyright information.
+#include "tools/thread_pool.h"
+#include <algorithm>
+#include <utility>
+
+namespace util {
+    ThreadPool::ThreadPool(std::size_t thread_count) {
+        const auto count = ResolveThreadCount(thread_count);
+
+        _queues.reserve(count);
+        for (std::size_t i = 0; i < count; ++i) {
+            _queues.emplace_back(std::make_unique<Queue>());
+        }
+
+        _workers.reserve(count);
+        for (std::size_t i = 0; i < count; ++i) {
+            _workers.emplace_back([this, i]() { WorkerLoop(i); });
+        }
+    }
+
+    ThreadPool::~ThreadPool() {
+        {
+            std::unique_lock lock{_state_mutex};
+            _all_done.wait(lock, [this]() { return _pending == 0; });
+            _stopping = true;
+        }
+
+        _work_available.notify_all();
+
+        for (auto& worker : _workers) {
+            worker.join();
+        }
+    }
+
+    std::size_t ThreadPool::ResolveThreadCount(std::size_t requested) {
+        if (requested != 0) {
+            return requested;
+        }
+
+        // hardware_concurrency() may return 0 if it can't tell
+        return std::max(std::size_t{1}, static_cast<std::size_t>(std::thread::hardware_concurrency()));
+    }
+
+    void ThreadPool::Submit(Task task) {
+        auto& queue = *_queues[_next_queue.fetch_add(1, std::memory_order_relaxed) % _queues.size()];
+
+        {
+            // Counters are updated while the task is being pushed so that a worker can't pop the task and decrement the counters before
+            // we incremented them.
+            std::scoped_lock state_lock{_state_mutex};
+
+            {
+                std::scoped_lock queue_lock{queue.mutex};
+                queue.tasks.emplace_back(std::move(task));
+            }
+
+            ++_pending;
+            ++_queued;
+        }
+
+        _work_available.notify_one();
+    }
+
+    void ThreadPool::Wait() {
+        std::unique_lock lock{_state_mutex};
+        _all_done.wait(lock, [this]() { return _pending == 0; });
+
+        if (_first_error != nullptr) {
+            std::rethrow_exception(std::exchange(_first_error, nullptr));
+        }
+    }
+
+    std::optional<ThreadPool::Task> ThreadPool::TryPop(std::size_t index) {
+        {
+            auto& own = *_queues[index];
+            std::scoped_lock lock{own.mutex};
+            if (!own.tasks.empty()) {
+                auto task = std::move(own.tasks.front());
+                own.tasks.pop_front();
+                return task;
+            }
+        }
+
+        for (std::size_t offset = 1; offset < _queues.size(); ++offset) {
+            auto& victim = *_queues[(index + offset) % _queues.size()];
+            std::scoped_lock lock{victim.mutex};
+            if (!victim.tasks.empty()) {
+                auto task = std::move(victim.tasks.front());
+                victim.tasks.pop_front();
+                return task;
+            }
+        }
+
+        return std::nullopt;
+    }
+
+    void ThreadPool::WorkerLoop(std::size_t index) {
+        while (true) {
+            if (auto task = TryPop(index)) {
+                {
+                    std::scoped_lock lock{_state_mutex};
+                    --_queued;
+                }
+
+                std::exception_ptr error{};
+                try {
+                    (*task)();
+                } catch (...) {
+                    error = std::current_exception();
+                }
+
+                std::scoped_lock lock{_state_mutex};
+                if (error != nullptr && _first_error == nullptr) {
+                    _first_error = error;
+                }
+                if (--_pending == 0) {
+                    _all_done.notify_all();
+                }
+                continue;
+            }
+
+            std::unique_lock lock{_state_mutex};
+            _work_available.wait(lock, [this]() { return _stopping || _queued != 0; });
+
+            if (_stopping && _queued == 0) {
+                return;
+            }
+        }
+    }
+} // namespace util
+
+// source2gen - Source2 games SDK generator
+// Copyright 2024 neverlosecc
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
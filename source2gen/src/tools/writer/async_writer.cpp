@@ -0,0 +1,140 @@
+// Copyright (C) 2024 neverlosecc
+// See end of file for extended copyright information.
+#include "tools/writer/async_writer.h"
+#include <algorithm>
+#include <ranges>
+#include <utility>
+
+namespace util {
+    AsyncFileWriter::AsyncFileWriter(const BackendFactory& make_backend, AsyncWriterOptions options, OutputIndex* index)
+        : _options(options), _index(index) {
+        const auto thread_count = std::max(std::size_t{1}, _options.thread_count);
+
+        _backends.reserve(thread_count);
+        for (std::size_t i = 0; i < thread_count; ++i) {
+            _backends.emplace_back(make_backend());
+        }
+
+        _threads.reserve(thread_count);
+        for (auto& backend : _backends) {
+            _threads.emplace_back([this, &backend]() { WriterLoop(*backend); });
+        }
+    }
+
+    AsyncFileWriter::~AsyncFileWriter() {
+        if (!_threads.empty()) {
+            static_cast<void>(Finish());
+        }
+    }
+
+    void AsyncFileWriter::Enqueue(std::filesystem::path path, std::string contents) {
+        // Hashing happens on the caller's thread, which is usually one of many generator threads
+        const auto entry = (_index != nullptr) ? OutputIndex::MakeEntry(contents) : OutputIndex::Entry{};
+        if (_index != nullptr && _index->IsUpToDate(path, entry)) {
+            std::scoped_lock lock{_mutex};
+            ++_summary.skipped;
+            return;
+        }
+
+        {
+            std::unique_lock lock{_mutex};
+            _not_full.wait(lock, [this]() { return _queue.size() < std::max(std::size_t{1}, _options.queue_capacity); });
+            _queue.emplace_back(QueuedWrite{.file = PendingWrite{.path = std::move(path), .contents = std::move(contents)}, .entry = entry});
+        }
+
+        _not_empty.notify_one();
+    }
+
+    void AsyncFileWriter::Flush() {
+        std::unique_lock lock{_mutex};
+        _idle.wait(lock, [this]() { return _queue.empty() && _in_flight == 0; });
+    }
+
+    WriteSummary AsyncFileWriter::Finish() {
+        {
+            std::scoped_lock lock{_mutex};
+            _finishing = true;
+        }
+
+        _not_empty.notify_all();
+
+        for (auto& thread : _threads) {
+            thread.join();
+        }
+        _threads.clear();
+
+        std::scoped_lock lock{_mutex};
+        return std::exchange(_summary, {});
+    }
+
+    void AsyncFileWriter::WriterLoop(IWriteBackend& backend) {
+        std::vector<PendingWrite> batch{};
+        std::vector<OutputIndex::Entry> entries{};
+        std::vector<WriteError> errors{};
+
+        while (true) {
+            {
+                std::unique_lock lock{_mutex};
+                _not_empty.wait(lock, [this]() { return _finishing || !_queue.empty(); });
+
+                if (_queue.empty()) {
+                    // _finishing and nothing left to do
+                    return;
+                }
+
+                const auto count = std::min(_queue.size(), std::max(std::size_t{1}, _options.batch_size));
+                for (auto& queued : std::ranges::subrange(_queue.begin(), _queue.begin() + static_cast<std::ptrdiff_t>(count))) {
+                    batch.emplace_back(std::move(queued.file));
+                    entries.emplace_back(queued.entry);
+                }
+                _queue.erase(_queue.begin(), _queue.begin() + static_cast<std::ptrdiff_t>(count));
+                _in_flight += count;
+            }
+
+            _not_full.notify_all();
+
+            backend.Write(batch, errors);
+
+            if (_index != nullptr) {
+                for (std::size_t i = 0; i < batch.size(); ++i) {
+                    if (std::ranges::find(errors, batch[i].path, &WriteError::path) == errors.end()) {
+                        _index->Record(batch[i].path, entries[i]);
+                    } else {
+                        _index->Forget(batch[i].path);
+                    }
+                }
+            }
+
+            {
+                std::scoped_lock lock{_mutex};
+                _summary.written += batch.size() - errors.size();
+                std::ranges::move(errors, std::back_inserter(_summary.errors));
+                _in_flight -= batch.size();
+
+                if (_queue.empty() && _in_flight == 0) {
+                    _idle.notify_all();
+                }
+            }
+
+            batch.clear();
+            entries.clear();
+            errors.clear();
+        }
+    }
+} // namespace util
+
+// source2gen - Source2 games SDK generator
+// Copyright 2024 neverlosecc
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
@@ -0,0 +1,375 @@
+// Copyright (C) 2024 neverlosecc
+// See end of file for extended copyright information.
+#include "tools/writer/backend_io_uring.h"
+
+#if TARGET_OS == LINUX
+    #include "tools/writer/backend_posix.h"
+    #include <algorithm>
+    #include <atomic>
+    #include <cerrno>
+    #include <cstddef>
+    #include <cstdint>
+    #include <cstring>
+    #include <fcntl.h>
+    #include <format>
+    #include <iostream>
+    #include <limits>
+    #include <linux/io_uring.h>
+    #include <span>
+    #include <sys/mman.h>
+    #include <sys/syscall.h>
+    #include <unistd.h>
+    #include <utility>
+    #include <vector>
+
+namespace {
+    /// Number of submission queue entries. Every file needs two entries in its second stage, so we can write half as many files per chunk.
+    constexpr unsigned kRingEntries = 256;
+
+    [[nodiscard]] int io_uring_setup(unsigned entries, io_uring_params* params) {
+        return static_cast<int>(::syscall(__NR_io_uring_setup, entries, params));
+    }
+
+    [[nodiscard]] int io_uring_enter(int ring_fd, unsigned to_submit, unsigned min_complete, unsigned flags) {
+        return static_cast<int>(::syscall(__NR_io_uring_enter, ring_fd, to_submit, min_complete, flags, nullptr, 0));
+    }
+
+    [[nodiscard]] unsigned load_acquire(const unsigned* p) {
+        return std::atomic_ref{*const_cast<unsigned*>(p)}.load(std::memory_order_acquire);
+    }
+
+    void store_release(unsigned* p, unsigned value) {
+        std::atomic_ref{*p}.store(value, std::memory_order_release);
+    }
+
+    /// Used once the ring failed
+    void WritePosix(std::span<const util::PendingWrite> files, std::vector<util::WriteError>& errors) {
+        for (const auto& file : files) {
+            if (auto error = util::PosixWriteBackend::WriteFile(file); error.has_value()) {
+                errors.emplace_back(util::WriteError{.path = file.path, .message = std::move(error.value())});
+            }
+        }
+    }
+} // namespace
+
+namespace util {
+    /// Memory shared with the kernel
+    struct IoUringWriteBackend::Ring {
+        int fd = -1;
+
+        void* sq_ring = MAP_FAILED;
+        std::size_t sq_ring_size = 0;
+        void* cq_ring = MAP_FAILED;
+        std::size_t cq_ring_size = 0;
+        io_uring_sqe* sqes = static_cast<io_uring_sqe*>(MAP_FAILED);
+        std::size_t sqes_size = 0;
+
+        unsigned* sq_tail = nullptr;
+        unsigned sq_mask = 0;
+        unsigned* sq_array = nullptr;
+        unsigned sq_entries = 0;
+
+        unsigned* cq_head = nullptr;
+        unsigned* cq_tail = nullptr;
+        unsigned cq_mask = 0;
+        io_uring_cqe* cqes = nullptr;
+
+        /// Number of entries that have been prepared, but not submitted
+        unsigned unsubmitted = 0;
+
+        /// errno of the io_uring_enter(2) call that failed, 0 if none did. Entries that haven't been submitted are still in the submission
+        /// queue, a failed ring must not be used again.
+        int error = 0;
+        /// Set if the ring failed and waiting for the submitted entries failed, too. The kernel may still complete them.
+        bool in_flight = false;
+
+        Ring() = default;
+        Ring(const Ring&) = delete;
+        Ring& operator=(const Ring&) = delete;
+
+        ~Ring() {
+            if (sqes != MAP_FAILED) {
+                ::munmap(sqes, sqes_size);
+            }
+            if (cq_ring != MAP_FAILED && cq_ring != sq_ring) {
+                ::munmap(cq_ring, cq_ring_size);
+            }
+            if (sq_ring != MAP_FAILED) {
+                ::munmap(sq_ring, sq_ring_size);
+            }
+            if (fd >= 0) {
+                ::close(fd);
+            }
+        }
+
+        /// @return A zeroed submission queue entry. There must be room in the queue.
+        [[nodiscard]] io_uring_sqe& Prepare() {
+            const unsigned tail = *sq_tail + unsubmitted;
+            const unsigned index = tail & sq_mask;
+
+            sq_array[index] = index;
+            ++unsubmitted;
+
+            auto& sqe = sqes[index];
+            std::memset(&sqe, 0, sizeof(sqe));
+            return sqe;
+        }
+
+        /// Submits all prepared entries and calls @p on_completion for @p completion_count completions. Every entry completes once.
+        /// If io_uring_enter(2) fails, sets @ref error and waits for the entries that have been submitted, so the kernel doesn't use the
+        /// caller's buffers after this returns and no completions are left in the queue. @p on_completion is called for them, too.
+        /// @return errno if io_uring_enter(2) failed, 0 otherwise
+        template <typename Fn>
+        [[nodiscard]] int SubmitAndWait(unsigned completion_count, Fn&& on_completion) {
+            store_release(sq_tail, *sq_tail + unsubmitted);
+
+            const unsigned prepared = std::exchange(unsubmitted, 0);
+            unsigned to_submit = prepared;
+            unsigned completed = 0;
+
+            const auto reap = [&]() {
+                unsigned head = *cq_head;
+                const unsigned tail = load_acquire(cq_tail);
+                for (; head != tail; ++head) {
+                    const auto& cqe = cqes[head & cq_mask];
+                    on_completion(cqe.user_data, cqe.res);
+                    ++completed;
+                }
+                store_release(cq_head, head);
+            };
+
+            while (completed < completion_count) {
+                const int result = io_uring_enter(fd, to_submit, completion_count - completed, IORING_ENTER_GETEVENTS);
+                if (result < 0) {
+                    if (errno == EINTR) {
+                        continue;
+                    }
+
+                    error = errno;
+                    const unsigned submitted = prepared - to_submit;
+
+                    reap();
+                    while (completed < submitted) {
+                        if ((io_uring_enter(fd, 0, submitted - completed, IORING_ENTER_GETEVENTS) < 0) && (errno != EINTR)) {
+                            in_flight = true;
+                            break;
+                        }
+                        reap();
+                    }
+
+                    return error;
+                }
+                to_submit -= std::min(to_submit, static_cast<unsigned>(result));
+
+                reap();
+            }
+
+            return 0;
+        }
+    };
+
+    std::expected<std::unique_ptr<IoUringWriteBackend>, std::string> IoUringWriteBackend::Create() {
+        auto ring = std::make_unique<Ring>();
+
+        io_uring_params params{};
+        ring->fd = io_uring_setup(kRingEntries, &params);
+        if (ring->fd < 0) {
+            return std::unexpected(std::strerror(errno));
+        }
+
+        // IORING_FEAT_RW_CUR_POS was added in the same release as IORING_OP_OPENAT and IORING_OP_CLOSE
+        if ((params.features & IORING_FEAT_RW_CUR_POS) == 0) {
+            return std::unexpected("kernel is too old");
+        }
+
+        ring->sq_ring_size = params.sq_off.array + params.sq_entries * sizeof(unsigned);
+        ring->cq_ring_size = params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe);
+
+        const bool single_mmap = (params.features & IORING_FEAT_SINGLE_MMAP) != 0;
+        if (single_mmap) {
+            ring->sq_ring_size = ring->cq_ring_size = std::max(ring->sq_ring_size, ring->cq_ring_size);
+        }
+
+        ring->sq_ring = ::mmap(nullptr, ring->sq_ring_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ring->fd, IORING_OFF_SQ_RING);
+        if (ring->sq_ring == MAP_FAILED) {
+            return std::unexpected(std::strerror(errno));
+        }
+
+        if (single_mmap) {
+            ring->cq_ring = ring->sq_ring;
+        } else {
+            ring->cq_ring = ::mmap(nullptr, ring->cq_ring_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ring->fd, IORING_OFF_CQ_RING);
+            if (ring->cq_ring == MAP_FAILED) {
+                return std::unexpected(std::strerror(errno));
+            }
+        }
+
+        ring->sqes_size = params.sq_entries * sizeof(io_uring_sqe);
+        ring->sqes = static_cast<io_uring_sqe*>(
+            ::mmap(nullptr, ring->sqes_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ring->fd, IORING_OFF_SQES));
+        if (ring->sqes == MAP_FAILED) {
+            return std::unexpected(std::strerror(errno));
+        }
+
+        auto* const sq = static_cast<std::byte*>(ring->sq_ring);
+        ring->sq_tail = reinterpret_cast<unsigned*>(sq + params.sq_off.tail);
+        ring->sq_mask = *reinterpret_cast<unsigned*>(sq + params.sq_off.ring_mask);
+        ring->sq_array = reinterpret_cast<unsigned*>(sq + params.sq_off.array);
+        ring->sq_entries = params.sq_entries;
+
+        auto* const cq = static_cast<std::byte*>(ring->cq_ring);
+        ring->cq_head = reinterpret_cast<unsigned*>(cq + params.cq_off.head);
+        ring->cq_tail = reinterpret_cast<unsigned*>(cq + params.cq_off.tail);
+        ring->cq_mask = *reinterpret_cast<unsigned*>(cq + params.cq_off.ring_mask);
+        ring->cqes = reinterpret_cast<io_uring_cqe*>(cq + params.cq_off.cqes);
+
+        return std::unique_ptr<IoUringWriteBackend>(new IoUringWriteBackend(std::move(ring)));
+    }
+
+    IoUringWriteBackend::IoUringWriteBackend(std::unique_ptr<Ring> ring): _ring(std::move(ring)) { }
+
+    IoUringWriteBackend::~IoUringWriteBackend() = default;
+
+    void IoUringWriteBackend::Write(std::span<const PendingWrite> batch, std::vector<WriteError>& errors) {
+        const std::size_t chunk_size = _ring->sq_entries / 2;
+
+        for (std::size_t offset = 0; offset < batch.size(); offset += chunk_size) {
+            const auto chunk = batch.subspan(offset, std::min(chunk_size, batch.size() - offset));
+
+            if (_ring->error != 0) {
+                WritePosix(chunk, errors);
+                continue;
+            }
+
+            WriteChunk(chunk, errors);
+
+            if (_ring->error != 0) {
+                std::cerr << std::format("{}: io_uring_enter: {}, writing the remaining files without io_uring", __FUNCTION__,
+                                         std::strerror(_ring->error))
+                          << std::endl;
+            }
+        }
+    }
+
+    void IoUringWriteBackend::WriteChunk(std::span<const PendingWrite> chunk, std::vector<WriteError>& errors) {
+        struct FileState {
+            int fd = -1;
+            /// Result of the write. Bytes written or -errno.
+            int write_result = 0;
+            /// Result of the close, -ECANCELED if the write didn't complete
+            int close_result = 0;
+            /// The close has run, successful or not
+            bool closed = false;
+        };
+
+        std::vector<FileState> states(chunk.size());
+
+        // The ring failed, this and all following chunks are written by the posix backend. Entries that haven't completed will never run.
+        // Unless they might still be running, closing their files is safe. Leaking file descriptors is better than closing descriptors that
+        // have been reused.
+        const auto fall_back = [&]() {
+            for (const auto& state : states) {
+                if (!_ring->in_flight && (state.fd >= 0) && !state.closed) {
+                    ::close(state.fd);
+                }
+            }
+
+            WritePosix(chunk, errors);
+        };
+
+        // Stage 1: open all files
+        for (std::size_t i = 0; i < chunk.size(); ++i) {
+            auto& sqe = _ring->Prepare();
+            sqe.opcode = IORING_OP_OPENAT;
+            sqe.fd = AT_FDCWD;
+            sqe.addr = reinterpret_cast<std::uintptr_t>(chunk[i].path.c_str());
+            sqe.len = 0644;
+            sqe.open_flags = O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC;
+            sqe.user_data = i;
+        }
+
+        if (const int error = _ring->SubmitAndWait(static_cast<unsigned>(chunk.size()), [&](std::uint64_t user_data, int result) {
+                states[user_data].fd = (result >= 0) ? result : -1;
+                states[user_data].write_result = (result >= 0) ? 0 : result;
+            });
+            error != 0) {
+            fall_back();
+            return;
+        }
+
+        // Stage 2: write all opened files and close them. Closes are linked to the writes, they don't run if the write failed or was short.
+        unsigned expected_completions = 0;
+        for (std::size_t i = 0; i < chunk.size(); ++i) {
+            if (states[i].fd < 0) {
+                continue;
+            }
+
+            auto& write = _ring->Prepare();
+            write.opcode = IORING_OP_WRITE;
+            write.flags = IOSQE_IO_LINK;
+            write.fd = states[i].fd;
+            write.addr = reinterpret_cast<std::uintptr_t>(chunk[i].contents.data());
+            write.len = static_cast<std::uint32_t>(std::min<std::size_t>(chunk[i].contents.size(), std::numeric_limits<std::int32_t>::max()));
+            write.off = 0;
+            write.user_data = i << 1;
+
+            auto& close = _ring->Prepare();
+            close.opcode = IORING_OP_CLOSE;
+            close.fd = states[i].fd;
+            close.user_data = (i << 1) | 1;
+
+            expected_completions += 2;
+        }
+
+        if (const int error = _ring->SubmitAndWait(expected_completions, [&](std::uint64_t user_data, int result) {
+                auto& state = states[user_data >> 1];
+                if ((user_data & 1) == 0) {
+                    state.write_result = result;
+                } else {
+                    state.close_result = result;
+                    state.closed = (result != -ECANCELED);
+                }
+            });
+            error != 0) {
+            fall_back();
+            return;
+        }
+
+        for (std::size_t i = 0; i < chunk.size(); ++i) {
+            const auto& file = chunk[i];
+            const auto& state = states[i];
+
+            if (state.fd < 0) {
+                errors.emplace_back(WriteError{.path = file.path, .message = std::strerror(-state.write_result)});
+            } else if (state.write_result < 0) {
+                ::close(state.fd);
+                errors.emplace_back(WriteError{.path = file.path, .message = std::strerror(-state.write_result)});
+            } else if (static_cast<std::size_t>(state.write_result) < file.contents.size()) {
+                // Short writes are rare, let the posix backend rewrite the file rather than tracking offsets here
+                ::close(state.fd);
+                if (auto error = PosixWriteBackend::WriteFile(file); error.has_value()) {
+                    errors.emplace_back(WriteError{.path = file.path, .message = std::move(error.value())});
+                }
+            } else if (state.close_result < 0) {
+                errors.emplace_back(WriteError{.path = file.path, .message = std::strerror(-state.close_result)});
+            }
+        }
+    }
+} // namespace util
+#endif
+
+// source2gen - Source2 games SDK generator
+// Copyright 2024 neverlosecc
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
@@ -0,0 +1,65 @@
+// Copyright (C) 2024 neverlosecc
+// See end of file for extended copyright information.
+#include "tools/writer/backend_posix.h"
+
+#if TARGET_OS == LINUX
+    #include <cerrno>
+    #include <cstring>
+    #include <fcntl.h>
+    #include <unistd.h>
+
+namespace util {
+    void PosixWriteBackend::Write(std::span<const PendingWrite> batch, std::vector<WriteError>& errors) {
+        for (const auto& file : batch) {
+            if (auto error = WriteFile(file); error.has_value()) {
+                errors.emplace_back(WriteError{.path = file.path, .message = std::move(error.value())});
+            }
+        }
+    }
+
+    std::optional<std::string> PosixWriteBackend::WriteFile(const PendingWrite& file) {
+        const int fd = ::open(file.path.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+        if (fd < 0) {
+            return std::strerror(errno);
+        }
+
+        std::string_view remaining = file.contents;
+        while (!remaining.empty()) {
+            const auto written = ::write(fd, remaining.data(), remaining.size());
+            if (written < 0) {
+                if (errno == EINTR) {
+                    continue;
+                }
+
+                const int error = errno;
+                ::close(fd);
+                return std::strerror(error);
+            }
+
+            remaining.remove_prefix(static_cast<std::size_t>(written));
+        }
+
+        if (::close(fd) != 0) {
+            return std::strerror(errno);
+        }
+
+        return std::nullopt;
+    }
+} // namespace util
+#endif
+
+// source2gen - Source2 games SDK generator
+// Copyright 2024 neverlosecc
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
@@ -0,0 +1,36 @@
+// Copyright (C) 2024 neverlosecc
+// See end of file for extended copyright information.
+#include "tools/writer/backend_stream.h"
+#include <cerrno>
+#include <cstring>
+#include <fstream>
+
+namespace util {
+    void StreamWriteBackend::Write(std::span<const PendingWrite> batch, std::vector<WriteError>& errors) {
+        for (const auto& file : batch) {
+            std::ofstream f(file.path, std::ios::out);
+            f << file.contents;
+            f.close();
+
+            if (!f.good()) {
+                errors.emplace_back(WriteError{.path = file.path, .message = std::strerror(errno)});
+            }
+        }
+    }
+} // namespace util
+
+// source2gen - Source2 games SDK generator
+// Copyright 2024 neverlosecc
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
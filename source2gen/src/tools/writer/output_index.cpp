@@ -0,0 +1,164 @@
+// Copyright (C) 2024 neverlosecc
+// See end of file for extended copyright information.
+#include "tools/writer/output_index.h"
+#include "tools/fnv.h"
+#include <charconv>
+#include <cstring>
+#include <format>
+#include <fstream>
+#include <iostream>
+#include <utility>
+
+namespace {
+    /// First line of every index file. Bump the version if the format changes, old files will be ignored.
+    constexpr std::string_view kHeader = "source2gen-output-index 1";
+
+    template <typename T>
+    [[nodiscard]] bool ParseNumber(std::string_view str, T& out) {
+        const auto [ptr, ec] = std::from_chars(str.data(), str.data() + str.size(), out, 16);
+        return ec == std::errc{} && ptr == str.data() + str.size();
+    }
+} // namespace
+
+namespace util {
+    OutputIndex::OutputIndex(OutputIndex&& other) noexcept
+        : _entries(std::move(other._entries)), _used(std::move(other._used)), _saved_at(other._saved_at) { }
+
+    OutputIndex OutputIndex::Load(const std::filesystem::path& path) {
+        OutputIndex result{};
+
+        std::error_code ec{};
+        const auto saved_at = std::filesystem::last_write_time(path, ec);
+        if (ec) {
+            return result;
+        }
+
+        std::ifstream f(path);
+        std::string line{};
+        if (!std::getline(f, line) || line != kHeader) {
+            std::cerr << std::format("{}: ignoring {}, it is not an output index", __FUNCTION__, path.string()) << std::endl;
+            return result;
+        }
+
+        // <hash>\t<size>\t<path>
+        while (std::getline(f, line)) {
+            const std::string_view view{line};
+            const auto first_tab = view.find('\t');
+            const auto second_tab = view.find('\t', first_tab + 1);
+            if (first_tab == std::string_view::npos || second_tab == std::string_view::npos) {
+                continue;
+            }
+
+            Entry entry{};
+            if (!ParseNumber(view.substr(0, first_tab), entry.hash) ||
+                !ParseNumber(view.substr(first_tab + 1, second_tab - (first_tab + 1)), entry.size)) {
+                continue;
+            }
+
+            result._entries.insert_or_assign(std::string{view.substr(second_tab + 1)}, entry);
+        }
+
+        result._saved_at = saved_at;
+        return result;
+    }
+
+    bool OutputIndex::Save(const std::filesystem::path& path) const {
+        if (path.has_parent_path()) {
+            std::filesystem::create_directories(path.parent_path());
+        }
+
+        std::ofstream f(path, std::ios::out | std::ios::trunc);
+        f << kHeader << '\n';
+
+        {
+            std::scoped_lock lock{_mutex};
+            for (const auto& [key, entry] : _entries) {
+                f << std::format("{:x}\t{:x}\t{}\n", entry.hash, entry.size, key);
+            }
+        }
+
+        if (!f.good()) {
+            std::cerr << std::format("{}: Could not write to {}: {}", __FUNCTION__, path.string(), std::strerror(errno)) << std::endl;
+            return false;
+        }
+
+        return true;
+    }
+
+    OutputIndex::Entry OutputIndex::MakeEntry(std::string_view contents) {
+        return Entry{.hash = fnv64::hash_bytes(contents), .size = contents.size()};
+    }
+
+    bool OutputIndex::IsUpToDate(const std::filesystem::path& path, const Entry& entry) {
+        auto key = path.generic_string();
+
+        {
+            std::scoped_lock lock{_mutex};
+            _used.emplace(key);
+
+            const auto found = _entries.find(key);
+            if (found == _entries.end() || found->second.hash != entry.hash || found->second.size != entry.size) {
+                return false;
+            }
+        }
+
+        std::error_code ec{};
+        if (const auto size = std::filesystem::file_size(path, ec); ec || size != entry.size) {
+            return false;
+        }
+
+        if (const auto modified_at = std::filesystem::last_write_time(path, ec); ec || modified_at > _saved_at) {
+            return false;
+        }
+
+        return true;
+    }
+
+    void OutputIndex::Record(const std::filesystem::path& path, const Entry& entry) {
+        auto key = path.generic_string();
+
+        std::scoped_lock lock{_mutex};
+        _entries.insert_or_assign(key, entry);
+        _used.emplace(std::move(key));
+    }
+
+    void OutputIndex::Forget(const std::filesystem::path& path) {
+        const auto key = path.generic_string();
+
+        std::scoped_lock lock{_mutex};
+        _entries.erase(key);
+        _used.erase(key);
+    }
+
+    std::vector<std::filesystem::path> OutputIndex::TakeStaleFiles() {
+        std::scoped_lock lock{_mutex};
+
+        std::vector<std::filesystem::path> result{};
+        for (auto it = _entries.begin(); it != _entries.end();) {
+            if (_used.contains(it->first)) {
+                ++it;
+            } else {
+                result.emplace_back(it->first);
+                it = _entries.erase(it);
+            }
+        }
+
+        return result;
+    }
+} // namespace util
+
+// source2gen - Source2 games SDK generator
+// Copyright 2024 neverlosecc
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
@@ -0,0 +1,73 @@
+// Copyright (C) 2024 neverlosecc
+// See end of file for extended copyright information.
+#include "tools/writer/writer.h"
+#include "tools/writer/backend_io_uring.h"
+#include "tools/writer/backend_posix.h"
+#include "tools/writer/backend_stream.h"
+#include <format>
+#include <iostream>
+#include <mutex>
+
+namespace util {
+    std::optional<WriteBackend> ParseWriteBackend(std::string_view name) {
+        if (name == "stream") {
+            return WriteBackend::stream;
+        }
+
+#if TARGET_OS == LINUX
+        if (name == "posix") {
+            return WriteBackend::posix;
+        } else if (name == "io-uring") {
+            return WriteBackend::io_uring;
+        }
+#endif
+
+        return std::nullopt;
+    }
+
+    std::unique_ptr<IWriteBackend> MakeWriteBackend(WriteBackend backend) {
+        switch (backend) {
+        case WriteBackend::stream:
+            return std::make_unique<StreamWriteBackend>();
+#if TARGET_OS == LINUX
+        case WriteBackend::posix:
+            return std::make_unique<PosixWriteBackend>();
+        case WriteBackend::io_uring: {
+            if (auto io_uring = IoUringWriteBackend::Create(); io_uring.has_value()) {
+                return std::move(io_uring.value());
+            } else {
+                // Every writer thread creates a backend, don't repeat the warning for each of them
+                static std::once_flag warned{};
+                std::call_once(warned, [&]() {
+                    std::cerr << std::format("{}: io_uring is unavailable ({}), falling back to posix writes", __FUNCTION__, io_uring.error())
+                              << std::endl;
+                });
+                return std::make_unique<PosixWriteBackend>();
+            }
+        }
+#else
+        case WriteBackend::posix:
+        case WriteBackend::io_uring:
+            break;
+#endif
+        }
+
+        return std::make_unique<StreamWriteBackend>();
+    }
+} // namespace util
+
+// source2gen - Source2 games SDK generator
+// Copyright 2024 neverlosecc
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
@@ -179,3 +179,23 @@ TEST(CodeGenC, BitfieldBlock) {
     EXPECT_EQ(builder.str(), "// start of bitfield block\n"
                              "// end of bitfield block\n");
 }
+
+TEST(CodeGenC, Reset) {
+    auto builder = codegen::generator_c_t{};
+
+    builder.begin_namespace("sourcesdk");
+    builder.begin_struct("Mario");
+    (void)builder.take();
+
+    builder.reset();
+    builder.begin_struct("Luigi");
+    builder.end_struct();
+
+    // the namespace and struct of the previous file are gone
+    EXPECT_EQ(builder.str(), "struct Luigi\n"
+                             "{\n"
+                             "    // This is an empty struct. There is no data in this struct. A pad has been generated for compliance with C.\n"
+                             "    char pad_do_not_access;\n"
+                             "};\n"
+                             "\n");
+}
@@ -1,5 +1,6 @@
 #include "tools/codegen/codegen.h"
 #include "tools/codegen/cpp.h"
+#include <format>
 #include <gtest/gtest.h>
 
 TEST(CodeGenCpp, Simple) {
@@ -56,9 +57,9 @@ TEST(CodeGenCpp, ClassContents) {
     EXPECT_EQ(builder.str(), "class Test\n"
                              "{\n"
                              "public:\n"
-                             "    static int &Get_power(){return "
-                             "*reinterpret_cast<int*>(interfaces::g_schema->FindTypeScopeForModule(\"tier0\")->FindDeclaredClass(\"Game\")->"
-                             "GetStaticFields()[19]->m_pInstance);};\n"
+                             "    static int &Get_power(){static auto* const instance = "
+                             "reinterpret_cast<int*>(interfaces::g_schema->FindTypeScopeForModule(\"tier0\")->FindDeclaredClass(\"Game\")->"
+                             "GetStaticFields()[19]->m_pInstance); return *instance;};\n"
                              "    int up;\n"
                              "};\n");
 }
@@ -161,3 +162,57 @@ TEST(CodeGenCpp, BitfieldBlock) {
     EXPECT_EQ(builder.str(), "// start of bitfield block\n"
                              "// end of bitfield block\n");
 }
+
+TEST(CodeGenCpp, TakeAndReset) {
+    auto builder = codegen::generator_cpp_t{};
+
+    builder.begin_namespace("sourcesdk");
+    builder.forward_declaration("Mario");
+
+    EXPECT_EQ(builder.take(), "namespace sourcesdk\n"
+                              "{\n"
+                              "    struct Mario;\n");
+    EXPECT_EQ(builder.str(), "");
+
+    builder.reset();
+    builder.forward_declaration("Mario");
+
+    // indentation and forward declarations of the previous file are gone
+    EXPECT_EQ(builder.str(), "struct Mario;\n");
+}
+
+TEST(CodeGenCpp, DeepIndentation) {
+    auto builder = codegen::generator_cpp_t{};
+
+    for (int i = 0; i < 20; ++i) {
+        builder.begin_namespace("n");
+    }
+    builder.comment("deep");
+
+    EXPECT_TRUE(builder.str().ends_with(std::format("\n{}// deep\n", std::string(20 * codegen::kIndentWidth, ' '))));
+}
+
+TEST(CodeGenCpp, Constant) {
+    auto builder = codegen::generator_cpp_t{};
+
+    builder.begin_namespace("C_BaseEntity");
+    builder.constant("std::ptrdiff_t", "m_iHealth", 0x344);
+    builder.end_namespace();
+
+    EXPECT_EQ(builder.str(), "namespace C_BaseEntity\n"
+                             "{\n"
+                             "    constexpr std::ptrdiff_t m_iHealth = 0x344;\n"
+                             "};\n");
+}
+
+TEST(CodeGenCpp, OffsetsPreamble) {
+    auto builder = codegen::generator_cpp_offsets_t{};
+
+    builder.preamble();
+
+    // no sdk-static
+    EXPECT_EQ(builder.str(), "#pragma once\n"
+                             "\n"
+                             "#include <cstddef>\n"
+                             "#include <cstdint>\n");
+}
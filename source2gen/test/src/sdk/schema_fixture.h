@@ -0,0 +1,66 @@
+#pragma once
+
+#include "sdk/interfaces/client/game/datamap_t.h"
+#include "sdk/interfaces/schemasystem/schema.h"
+#include "sdk/snapshot.h"
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <span>
+#include <string_view>
+#include <vector>
+
+namespace fixtures {
+    /// Modules "client" and "server". "client" declares CDerived before its base class CBase, and EState. Covers metadata with and without
+    /// values, types the game doesn't know the size of, static fields, and datamap fields.
+    [[nodiscard]] inline sdk::snapshot::Snapshot MakeSchemaSnapshot() {
+        using namespace sdk::snapshot;
+
+        return Snapshot{
+            .game = "cs2",
+            .types = {Type{.name = "int32", .category = ETypeCategory::Schema_Builtin, .size = 4, .alignment = 4},
+                      Type{.name = "CUtlSymbolLarge", .category = ETypeCategory::Schema_Atomic}},
+            .classes = {Class{.name = "CBase",
+                              .module = "client",
+                              .size = 8,
+                              .registered_alignment = 8,
+                              .fields = {Field{.name = "m_nBaseValue", .type = 0, .offset = 0}}},
+                        Class{.name = "CDerived",
+                              .module = "client",
+                              .size = 0x18,
+                              .flags = 1,
+                              .base_class = 0,
+                              .fields = {Field{.name = "m_value", .type = 0, .offset = 8, .metadata = {Metadata{.name = "MNetworkEnable"}}},
+                                         Field{.name = "m_name", .type = 1, .offset = 0x10}},
+                              .static_fields = {StaticField{.name = "s_count", .type = 0}},
+                              .static_metadata = {Metadata{.name = "MNetworkVarNames", .value = "int32 \"m_value\""}},
+                              .datamap = {DatamapField{.name = "m_position", .type = fieldtype_t::FIELD_VECTOR, .size = 1, .offset = 0x20},
+                                          DatamapField{.name = "m_embedded", .type = fieldtype_t::FIELD_EMBEDDED, .size = 1, .offset = 0x30,
+                                                       .embedded_class = "CBase"}}},
+                        Class{.name = "CServer", .module = "server", .size = 4, .fields = {Field{.name = "m_value", .type = 0, .offset = 0}}}},
+            .enums = {Enum{.name = "EState",
+                           .module = "client",
+                           .size = 4,
+                           .alignment = 4,
+                           .enumerators = {Enumerator{.name = "kIdle", .value = 0}, Enumerator{.name = "kRunning", .value = 1},
+                                           Enumerator{.name = "kInvalid", .value = 0xffffffff}}}},
+            .modules = {{"client", ModuleTypes{.enums = {0}, .classes = {1, 0}}}, {"server", ModuleTypes{.classes = {2}}}},
+        };
+    }
+
+    /// Copy of a serialized schema.bin. The file is read in place, its records need to be aligned.
+    class AlignedBytes {
+    public:
+        explicit AlignedBytes(std::string_view bytes) : _words((bytes.size() + sizeof(std::uint64_t) - 1) / sizeof(std::uint64_t)), _size(bytes.size()) {
+            std::memcpy(_words.data(), bytes.data(), bytes.size());
+        }
+
+        [[nodiscard]] std::span<const std::byte> get() const {
+            return {reinterpret_cast<const std::byte*>(_words.data()), _size};
+        }
+
+    private:
+        std::vector<std::uint64_t> _words{};
+        std::size_t _size{};
+    };
+} // namespace fixtures
@@ -0,0 +1,63 @@
+#include "sdk/amalgamation.h"
+#include <format>
+#include <gtest/gtest.h>
+#include <string>
+#include <vector>
+
+namespace {
+    [[nodiscard]] std::vector<std::string> GetPaths(const std::vector<const sdk::GeneratedFile*>& files) {
+        std::vector<std::string> result{};
+
+        for (const auto* file : files) {
+            result.emplace_back(file->path.generic_string());
+        }
+
+        return result;
+    }
+} // namespace
+
+TEST(Amalgamation, IncludedFilesComeFirst) {
+    const std::vector<sdk::GeneratedFile> files{
+        sdk::GeneratedFile{.path = "a.h", .includes = {"c.h"}},
+        sdk::GeneratedFile{.path = "b.h"},
+        sdk::GeneratedFile{.path = "c.h", .includes = {"d.h", "b.h"}},
+        sdk::GeneratedFile{.path = "d.h"},
+    };
+
+    EXPECT_EQ(GetPaths(sdk::SortByIncludes(files)), (std::vector<std::string>{"d.h", "b.h", "c.h", "a.h"}));
+}
+
+TEST(Amalgamation, IgnoresFilesThatHaveNotBeenGenerated) {
+    const std::vector<sdk::GeneratedFile> files{
+        sdk::GeneratedFile{.path = "b.h", .includes = {"source2gen.h"}},
+        sdk::GeneratedFile{.path = "a.h", .includes = {"b.h", "missing.h"}},
+    };
+
+    EXPECT_EQ(GetPaths(sdk::SortByIncludes(files)), (std::vector<std::string>{"b.h", "a.h"}));
+}
+
+TEST(Amalgamation, BreaksCycles) {
+    const std::vector<sdk::GeneratedFile> files{
+        sdk::GeneratedFile{.path = "a.h", .includes = {"b.h"}},
+        sdk::GeneratedFile{.path = "b.h", .includes = {"a.h"}},
+    };
+
+    EXPECT_EQ(GetPaths(sdk::SortByIncludes(files)), (std::vector<std::string>{"b.h", "a.h"}));
+}
+
+TEST(Amalgamation, HandlesLongIncludeChains) {
+    constexpr std::size_t kLength = 100'000;
+    std::vector<sdk::GeneratedFile> files(kLength);
+
+    for (std::size_t i = 0; i < kLength; ++i) {
+        files[i].path = std::format("{:06}.h", i);
+        if (i + 1 < kLength) {
+            files[i].includes.emplace_back(std::format("{:06}.h", i + 1));
+        }
+    }
+
+    const auto sorted = sdk::SortByIncludes(files);
+    ASSERT_EQ(sorted.size(), kLength);
+    EXPECT_EQ(sorted.front()->path, files.back().path);
+    EXPECT_EQ(sorted.back()->path, files.front().path);
+}
@@ -0,0 +1,111 @@
+#include "sdk/field_table.h"
+#include <algorithm>
+#include <bit>
+#include <format>
+#include <gtest/gtest.h>
+
+namespace {
+    /// @param class_count Classes of module "client", each with fields "m_a" to "m_d"
+    sdk::snapshot::Snapshot MakeSnapshot(std::size_t class_count) {
+        using namespace sdk::snapshot;
+
+        Snapshot result{
+            .types = {Type{.name = "int32", .category = ETypeCategory::Schema_Builtin, .size = 4, .alignment = 4},
+                      Type{.name = "CHandle< C_BaseEntity >", .category = ETypeCategory::Schema_Atomic, .size = 4, .alignment = 4},
+                      Type{.name = "CUtlSymbolLarge", .category = ETypeCategory::Schema_Atomic}},
+        };
+
+        for (std::size_t i = 0; i < class_count; ++i) {
+            result.modules["client"].classes.emplace_back(static_cast<Index>(result.classes.size()));
+            result.classes.emplace_back(Class{.name = std::format("C{}", i),
+                                              .module = "client",
+                                              .size = 0x10,
+                                              .fields = {Field{.name = "m_a", .type = 0, .offset = 0},
+                                                         Field{.name = "m_b", .type = 1, .offset = 4},
+                                                         Field{.name = "m_c", .type = 0, .offset = 8},
+                                                         Field{.name = "m_d", .type = 2, .offset = static_cast<std::int32_t>(0xc + i)}}});
+        }
+
+        return result;
+    }
+} // namespace
+
+TEST(FieldTable, FindsEveryField) {
+    const auto schema = MakeSnapshot(1000);
+    const auto table = sdk::BuildFieldTable(schema);
+
+    EXPECT_TRUE(std::has_single_bit(table.slots.size()));
+    EXPECT_TRUE(std::has_single_bit(table.displacements.size()));
+
+    for (const auto& class_ : schema.classes) {
+        for (const auto& field : class_.fields) {
+            const auto* found = table.Find("client", class_.name, field.name);
+
+            ASSERT_NE(found, nullptr) << class_.name << "::" << field.name;
+            EXPECT_EQ(found->offset, static_cast<std::uint32_t>(field.offset));
+            EXPECT_EQ(table.type_names.at(found->type_id), schema.types[field.type].name);
+        }
+    }
+}
+
+TEST(FieldTable, StoresSizeAndTypeOfFields) {
+    const auto table = sdk::BuildFieldTable(MakeSnapshot(1));
+
+    EXPECT_EQ(table.type_names, (std::vector<std::string>{"CHandle< C_BaseEntity >", "CUtlSymbolLarge", "int32"}));
+    EXPECT_EQ(*table.Find("client", "C0", "m_b"), (sdk::FieldInfo{.offset = 4, .size = 4, .type_id = 0}));
+    // The game doesn't know the size
+    EXPECT_EQ(*table.Find("client", "C0", "m_d"), (sdk::FieldInfo{.offset = 0xc, .size = 0, .type_id = 1}));
+}
+
+TEST(FieldTable, DoesntFindUnknownFields) {
+    const auto table = sdk::BuildFieldTable(MakeSnapshot(100));
+
+    EXPECT_EQ(table.Find("client", "C0", "m_e"), nullptr);
+    EXPECT_EQ(table.Find("client", "C100", "m_a"), nullptr);
+    EXPECT_EQ(table.Find("server", "C0", "m_a"), nullptr);
+    EXPECT_EQ(table.Find("", "", ""), nullptr);
+}
+
+TEST(FieldTable, DoesntDependOnSnapshotOrder) {
+    auto schema = MakeSnapshot(100);
+    // Its first field has another type than those of the other classes
+    schema.modules["client"].classes.emplace_back(static_cast<sdk::snapshot::Index>(schema.classes.size()));
+    schema.classes.emplace_back(sdk::snapshot::Class{.name = "CZ", .module = "client", .fields = {sdk::snapshot::Field{.name = "m_z", .type = 2}}});
+
+    // Same schema, captured with types and classes in another order
+    auto reordered = schema;
+    std::ranges::reverse(reordered.types);
+    for (auto& class_ : reordered.classes) {
+        for (auto& field : class_.fields) {
+            field.type = static_cast<sdk::snapshot::Index>(reordered.types.size() - 1 - field.type);
+        }
+    }
+    std::ranges::reverse(reordered.modules["client"].classes);
+
+    const auto table = sdk::BuildFieldTable(schema);
+    const auto reordered_table = sdk::BuildFieldTable(reordered);
+
+    EXPECT_EQ(table.keys, reordered_table.keys);
+    EXPECT_EQ(table.type_names, reordered_table.type_names);
+    EXPECT_EQ(sdk::EmitFieldTable(table), sdk::EmitFieldTable(reordered_table));
+}
+
+TEST(FieldTable, BuildsEmptyTable) {
+    const auto table = sdk::BuildFieldTable(MakeSnapshot(0));
+
+    EXPECT_EQ(table.Find("client", "C0", "m_a"), nullptr);
+    EXPECT_TRUE(sdk::EmitFieldTable(table).contains("std::array<std::string_view, 0> kTypeNames"));
+}
+
+TEST(FieldTable, EmitsTable) {
+    const auto table = sdk::BuildFieldTable(MakeSnapshot(1));
+    const auto header = sdk::EmitFieldTable(table);
+
+    EXPECT_TRUE(header.starts_with("#pragma once")) << header;
+    EXPECT_TRUE(header.contains("namespace source2sdk::field_table")) << header;
+    EXPECT_TRUE(header.contains(R"(std::string_view{"client" "\0" "C0" "\0" "m_b", 13}, {0x4, 0x4, 0}},)")) << header;
+    EXPECT_TRUE(header.contains("\"CHandle< C_BaseEntity >\",")) << header;
+    EXPECT_TRUE(header.contains(std::format("kSlotMask = {:#x};", table.slots.size() - 1))) << header;
+    EXPECT_TRUE(header.contains("constexpr const Field* Find(std::string_view module, std::string_view class_name, std::string_view field_name)"))
+        << header;
+}
@@ -0,0 +1,81 @@
+#include "sdk/include_graph.h"
+#include <filesystem>
+#include <fstream>
+#include <gtest/gtest.h>
+#include <iterator>
+#include <numeric>
+#include <vector>
+
+TEST(IncludeGraph, ComputesTransitiveClosure) {
+    // 0 -> 1 -> 2, 3 is not included
+    const sdk::IncludeGraph graph{{{1}, {2}, {}, {}}};
+
+    EXPECT_TRUE(graph.Reaches(0, 2));
+    EXPECT_FALSE(graph.Reaches(2, 0));
+    EXPECT_FALSE(graph.Reaches(0, 0));
+    EXPECT_FALSE(graph.Reaches(0, 3));
+
+    EXPECT_EQ(graph.GetClosureSize(0), 2);
+    EXPECT_EQ(graph.GetClosureSize(1), 1);
+    EXPECT_EQ(graph.GetClosureSize(2), 0);
+}
+
+TEST(IncludeGraph, HandlesCycles) {
+    // 0 -> 1 -> 2 -> 1, 2 -> 3
+    const sdk::IncludeGraph graph{{{1}, {2}, {1, 3}, {}}};
+
+    EXPECT_TRUE(graph.Reaches(1, 1));
+    EXPECT_TRUE(graph.Reaches(2, 2));
+    EXPECT_TRUE(graph.Reaches(1, 3));
+    EXPECT_FALSE(graph.Reaches(0, 0));
+
+    EXPECT_EQ(graph.GetClosureSize(0), 3);
+    EXPECT_EQ(graph.GetClosureSize(1), 3);
+    EXPECT_EQ(graph.GetClosureSize(3), 0);
+}
+
+TEST(IncludeGraph, RemovesRedundantIncludes) {
+    // 0 includes 1 and 2, 1 already includes 2
+    const sdk::IncludeGraph graph{{{2, 1}, {2}, {}}};
+
+    EXPECT_EQ(graph.GetMinimalIncludes(0), (std::vector<std::size_t>{1}));
+    EXPECT_EQ(graph.GetMinimalIncludes(1), (std::vector<std::size_t>{2}));
+}
+
+TEST(IncludeGraph, KeepsIncludesThatIncludeEachOther) {
+    // 1 and 2 include each other
+    const sdk::IncludeGraph graph{{{1, 2, 0}, {2}, {1}}};
+
+    EXPECT_EQ(graph.GetMinimalIncludes(0), (std::vector<std::size_t>{1, 2}));
+}
+
+TEST(IncludeGraph, HandlesLongChains) {
+    constexpr std::size_t kLength = 10'000;
+
+    std::vector<std::vector<std::size_t>> includes(kLength);
+    for (std::size_t i = 0; i + 1 < kLength; ++i) {
+        includes[i] = {i + 1};
+    }
+    includes[0].emplace_back(kLength - 1);
+
+    const sdk::IncludeGraph graph{std::move(includes)};
+
+    EXPECT_EQ(graph.GetClosureSize(0), kLength - 1);
+    EXPECT_EQ(graph.GetMinimalIncludes(0), (std::vector<std::size_t>{1}));
+}
+
+TEST(IncludeGraph, SavesReport) {
+    const auto path = std::filesystem::temp_directory_path() / "source2gen-test-include-report";
+    const std::vector<sdk::IncludeReportEntry> entries{
+        sdk::IncludeReportEntry{.type = {.module = "client", .name = "C_BaseEntity"}, .includes_before = 4, .includes_after = 2, .closure_before = 9, .closure_after = 3},
+    };
+
+    ASSERT_TRUE(sdk::SaveIncludeReport(path, entries));
+
+    std::ifstream f(path);
+    const std::string contents{std::istreambuf_iterator<char>{f}, std::istreambuf_iterator<char>{}};
+    f.close();
+    std::filesystem::remove(path);
+
+    EXPECT_TRUE(contents.ends_with("\nclient\tC_BaseEntity\t4\t2\t9\t3\n")) << contents;
+}
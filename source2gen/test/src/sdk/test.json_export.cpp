@@ -0,0 +1,66 @@
+#include "schema_fixture.h"
+#include "sdk/json_export.h"
+#include <algorithm>
+#include <gtest/gtest.h>
+#include <sstream>
+
+namespace {
+    std::string Export(const sdk::snapshot::Snapshot& schema) {
+        std::ostringstream out{};
+        sdk::ExportJson(schema, out);
+        return out.str();
+    }
+} // namespace
+
+TEST(JsonExport, ExportsEnums) {
+    const auto json = Export(fixtures::MakeSchemaSnapshot());
+
+    EXPECT_TRUE(json.starts_with(R"({"game":"cs2","modules":[{"name":"client","enums":[)")) << json;
+    EXPECT_TRUE(json.contains(R"({"name":"EState","size":4,"alignment":4,"metadata":[],"enumerators":[{"name":"kIdle","value":0,"metadata":[]},)"
+                              R"({"name":"kRunning","value":1,"metadata":[]},{"name":"kInvalid","value":4294967295,"metadata":[]}]})"))
+        << json;
+}
+
+TEST(JsonExport, ExportsClasses) {
+    const auto json = Export(fixtures::MakeSchemaSnapshot());
+
+    EXPECT_TRUE(json.contains(R"({"name":"CBase","size":8,"alignment":8,"flags":0,"base_class":null,"metadata":[],)"
+                              R"("fields":[{"name":"m_nBaseValue","type":"int32","offset":0,"size":4,"alignment":4,"metadata":[]}])")) << json;
+    EXPECT_TRUE(json.contains(R"({"name":"CDerived","size":24,"alignment":null,"flags":1,"base_class":{"module":"client","name":"CBase"},)"
+                              R"("metadata":[{"name":"MNetworkVarNames","value":"int32 \"m_value\""}],)"))
+        << json;
+    // Sizes the game doesn't know are null
+    EXPECT_TRUE(json.contains(R"("fields":[{"name":"m_value","type":"int32","offset":8,"size":4,"alignment":4,)"
+                              R"("metadata":[{"name":"MNetworkEnable","value":null}]},)"
+                              R"({"name":"m_name","type":"CUtlSymbolLarge","offset":16,"size":null,"alignment":null,"metadata":[]}])"))
+        << json;
+    EXPECT_TRUE(json.contains(R"("static_fields":[{"name":"s_count","type":"int32","metadata":[]}])")) << json;
+    EXPECT_TRUE(json.ends_with("}]}]}")) << json;
+}
+
+TEST(JsonExport, ExportsDatamapFields) {
+    const auto json = Export(fixtures::MakeSchemaSnapshot());
+
+    EXPECT_TRUE(json.contains(R"("datamap":[{"name":"m_position","type":"Vector","field_type":3,"offset":32,"count":1},)"
+                              R"({"name":"m_embedded","type":"CBase","field_type":10,"offset":48,"count":1}])"))
+        << json;
+}
+
+TEST(JsonExport, ExportsTypesInNameOrder) {
+    const auto schema = fixtures::MakeSchemaSnapshot();
+    const auto json = Export(schema);
+
+    // Declared in another order
+    auto reordered = schema;
+    std::ranges::reverse(reordered.modules["client"].classes);
+    reordered.enums.emplace_back(sdk::snapshot::Enum{.name = "EAlpha", .module = "client", .size = 1, .alignment = 1});
+    reordered.modules["client"].enums.emplace_back(1);
+    const auto reordered_json = Export(reordered);
+
+    EXPECT_LT(json.find(R"({"name":"CBase",)"), json.find(R"({"name":"CDerived",)")) << json;
+    EXPECT_LT(reordered_json.find(R"({"name":"EAlpha",)"), reordered_json.find(R"({"name":"EState",)")) << reordered_json;
+
+    // Without the added enum, the output is the same
+    reordered.modules["client"].enums.pop_back();
+    EXPECT_EQ(Export(reordered), json);
+}
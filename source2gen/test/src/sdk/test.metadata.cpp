@@ -0,0 +1,35 @@
+#include "sdk/metadata.h"
+#include <gtest/gtest.h>
+
+using sdk::MetadataValueKind;
+
+TEST(Metadata, ClassifiesKnownEntries) {
+    EXPECT_EQ(sdk::GetMetadataValueKind("MNetworkVarNames"), MetadataValueKind::var_name);
+    EXPECT_EQ(sdk::GetMetadataValueKind("MResourceTypeForInfoType"), MetadataValueKind::inline_string);
+    EXPECT_EQ(sdk::GetMetadataValueKind("MNetworkAlias"), MetadataValueKind::string);
+    EXPECT_EQ(sdk::GetMetadataValueKind("MNetworkBitCount"), MetadataValueKind::integer);
+    EXPECT_EQ(sdk::GetMetadataValueKind("MNetworkMaxValue"), MetadataValueKind::floating_point);
+}
+
+TEST(Metadata, FirstTableWinsForDuplicateEntries) {
+    // Listed as both a var name and a string
+    EXPECT_EQ(sdk::GetMetadataValueKind("MScriptDescription"), MetadataValueKind::var_name);
+}
+
+TEST(Metadata, ClassifiesUnknownEntries) {
+    EXPECT_EQ(sdk::GetMetadataValueKind("MNetworkEnable"), MetadataValueKind::unknown);
+    EXPECT_EQ(sdk::GetMetadataValueKind("MNetworkBitCoun"), MetadataValueKind::unknown);
+    EXPECT_EQ(sdk::GetMetadataValueKind(""), MetadataValueKind::unknown);
+}
+
+TEST(Metadata, DecodesValues) {
+    CSchemaNetworkValue integer{};
+    integer.m_nValue = 17;
+    EXPECT_EQ(sdk::GetMetadataValue(SchemaMetadataEntryData_t{.m_szName = "MNetworkBitCount", .m_pNetworkValue = &integer}), "17");
+
+    CSchemaNetworkValue inline_string{};
+    inline_string.m_szValue = {'v', 'p', 'c', 'f', 0, 'x', 'x', 'x'};
+    EXPECT_EQ(sdk::GetMetadataValue(SchemaMetadataEntryData_t{.m_szName = "MResourceTypeForInfoType", .m_pNetworkValue = &inline_string}), "vpcf");
+
+    EXPECT_EQ(sdk::GetMetadataValue(SchemaMetadataEntryData_t{.m_szName = "MNetworkEnable", .m_pNetworkValue = nullptr}), "");
+}
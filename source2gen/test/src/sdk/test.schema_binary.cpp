@@ -0,0 +1,132 @@
+#include "schema_fixture.h"
+#include "sdk/schema_binary.h"
+#include <filesystem>
+#include <fstream>
+#include <gtest/gtest.h>
+#include <source2sdk/schema_view.hpp>
+#include <vector>
+
+using fixtures::AlignedBytes;
+using fixtures::MakeSchemaSnapshot;
+
+TEST(SchemaBinary, FindsClassesAndFields) {
+    const AlignedBytes bytes{sdk::SerializeSchemaBinary(MakeSchemaSnapshot())};
+    const auto view = source2sdk::schema::View::FromBytes(bytes.get());
+    ASSERT_TRUE(view.has_value());
+
+    const auto derived = view->FindClass("CDerived");
+    ASSERT_TRUE(derived.has_value());
+    EXPECT_EQ(derived->module(), "client");
+    EXPECT_EQ(derived->size(), 0x18u);
+    EXPECT_EQ(derived->flags(), 1u);
+    EXPECT_EQ(derived->alignment(), 0u);
+
+    const auto field = derived->FindField("m_name");
+    ASSERT_TRUE(field.has_value());
+    EXPECT_EQ(field->type_name(), "CUtlSymbolLarge");
+    EXPECT_EQ(field->offset(), 0x10u);
+    // The game doesn't know the size
+    EXPECT_EQ(field->size(), 0u);
+
+    const auto base = derived->base_class();
+    ASSERT_TRUE(base.has_value());
+    EXPECT_EQ(base->name(), "CBase");
+    EXPECT_EQ(base->alignment(), 8u);
+    EXPECT_EQ(base->FindField("m_nBaseValue")->size(), 4u);
+
+    // Fields of base classes are only found in their own class
+    EXPECT_FALSE(derived->FindField("m_nBaseValue").has_value());
+    EXPECT_FALSE(base->base_class().has_value());
+
+    EXPECT_FALSE(view->FindClass("CMissing").has_value());
+    EXPECT_FALSE(view->FindClass("server", "CBase").has_value());
+    EXPECT_TRUE(view->FindClass("client", "CBase").has_value());
+}
+
+TEST(SchemaBinary, SortsModulesAndClassesByName) {
+    const AlignedBytes bytes{sdk::SerializeSchemaBinary(MakeSchemaSnapshot())};
+    const auto view = source2sdk::schema::View::FromBytes(bytes.get());
+    ASSERT_TRUE(view.has_value());
+
+    std::vector<std::string_view> names{};
+    for (const auto module : view->modules()) {
+        for (const auto class_ : module.classes()) {
+            names.emplace_back(class_.name());
+        }
+    }
+
+    // CDerived is declared before CBase
+    EXPECT_EQ(names, (std::vector<std::string_view>{"CBase", "CDerived", "CServer"}));
+    EXPECT_EQ(view->FindModule("server")->classes().size(), 1u);
+    EXPECT_FALSE(view->FindModule("engine2").has_value());
+}
+
+TEST(SchemaBinary, StoresMetadata) {
+    const AlignedBytes bytes{sdk::SerializeSchemaBinary(MakeSchemaSnapshot())};
+    const auto view = source2sdk::schema::View::FromBytes(bytes.get());
+    ASSERT_TRUE(view.has_value());
+
+    const auto derived = view->FindClass("CDerived");
+    ASSERT_EQ(derived->metadata().size(), 1u);
+    EXPECT_EQ(derived->metadata()[0].name(), "MNetworkVarNames");
+    EXPECT_EQ(derived->metadata()[0].value(), "int32 \"m_value\"");
+
+    const auto field_metadata = derived->FindField("m_value")->metadata();
+    ASSERT_EQ(field_metadata.size(), 1u);
+    EXPECT_EQ(field_metadata[0].name(), "MNetworkEnable");
+    EXPECT_TRUE(field_metadata[0].value().empty());
+}
+
+TEST(SchemaBinary, FindsEnums) {
+    const AlignedBytes bytes{sdk::SerializeSchemaBinary(MakeSchemaSnapshot())};
+    const auto view = source2sdk::schema::View::FromBytes(bytes.get());
+    ASSERT_TRUE(view.has_value());
+
+    const auto enum_ = view->FindEnum("client", "EState");
+    ASSERT_TRUE(enum_.has_value());
+    EXPECT_EQ(enum_->size(), 4u);
+    EXPECT_EQ(enum_->enumerators().size(), 3u);
+    EXPECT_EQ(enum_->FindEnumerator("kInvalid")->value(), 0xffffffffu);
+    EXPECT_FALSE(enum_->FindEnumerator("kDone").has_value());
+    EXPECT_FALSE(view->FindEnum("EMissing").has_value());
+}
+
+TEST(SchemaBinary, IsDeterministic) {
+    EXPECT_EQ(sdk::SerializeSchemaBinary(MakeSchemaSnapshot()), sdk::SerializeSchemaBinary(MakeSchemaSnapshot()));
+}
+
+TEST(SchemaBinary, RejectsInvalidFiles) {
+    const auto serialized = sdk::SerializeSchemaBinary(MakeSchemaSnapshot());
+
+    EXPECT_FALSE(source2sdk::schema::View::FromBytes(AlignedBytes{serialized.substr(0, serialized.size() - 1)}.get()).has_value());
+    EXPECT_FALSE(source2sdk::schema::View::FromBytes(AlignedBytes{serialized.substr(0, 16)}.get()).has_value());
+
+    auto wrong_magic = serialized;
+    wrong_magic[0] = 'X';
+    EXPECT_FALSE(source2sdk::schema::View::FromBytes(AlignedBytes{wrong_magic}.get()).has_value());
+
+    auto wrong_version = serialized;
+    wrong_version[offsetof(source2sdk::schema::format::Header, version)] = 2;
+    EXPECT_FALSE(source2sdk::schema::View::FromBytes(AlignedBytes{wrong_version}.get()).has_value());
+}
+
+TEST(SchemaBinary, MapsFiles) {
+    const auto path = std::filesystem::temp_directory_path() / "source2gen-test-schema.bin";
+
+    {
+        std::ofstream file{path, std::ios::binary};
+        file << sdk::SerializeSchemaBinary(MakeSchemaSnapshot());
+    }
+
+    {
+        const auto file = source2sdk::schema::MappedFile::Open(path.string().c_str());
+        ASSERT_TRUE(file.has_value());
+
+        const auto view = source2sdk::schema::View::FromBytes(file->bytes());
+        ASSERT_TRUE(view.has_value());
+        EXPECT_EQ(view->FindClass("CDerived")->FindField("m_value")->offset(), 8u);
+    }
+
+    std::filesystem::remove(path);
+    EXPECT_FALSE(source2sdk::schema::MappedFile::Open(path.string().c_str()).has_value());
+}
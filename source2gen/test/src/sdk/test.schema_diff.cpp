@@ -0,0 +1,198 @@
+#include "schema_fixture.h"
+#include "sdk/schema_binary.h"
+#include "sdk/schema_diff.h"
+#include <filesystem>
+#include <fstream>
+#include <gtest/gtest.h>
+#include <sstream>
+
+using fixtures::MakeSchemaSnapshot;
+
+TEST(SchemaDiff, FindsNoChangesInEqualSchemas) {
+    const auto diff = sdk::diff::Compare(MakeSchemaSnapshot(), MakeSchemaSnapshot());
+
+    EXPECT_TRUE(diff.empty());
+    EXPECT_EQ(diff.unchanged_classes, 3u);
+    EXPECT_EQ(diff.unchanged_enums, 1u);
+}
+
+TEST(SchemaDiff, HashesDontDependOnIndices) {
+    const auto schema = MakeSchemaSnapshot();
+
+    // Same class, but its types are stored in a different order
+    auto reordered = schema;
+    std::swap(reordered.types[0], reordered.types[1]);
+    for (auto& class_ : reordered.classes) {
+        for (auto& field : class_.fields) {
+            field.type = 1 - field.type;
+        }
+        for (auto& field : class_.static_fields) {
+            field.type = 1 - field.type;
+        }
+    }
+
+    EXPECT_EQ(sdk::diff::HashClass(schema, schema.classes[1]), sdk::diff::HashClass(reordered, reordered.classes[1]));
+    EXPECT_TRUE(sdk::diff::Compare(schema, reordered).empty());
+
+    reordered.classes[1].fields[0].offset = 0xc;
+    EXPECT_NE(sdk::diff::HashClass(schema, schema.classes[1]), sdk::diff::HashClass(reordered, reordered.classes[1]));
+}
+
+TEST(SchemaDiff, FindsChangedFields) {
+    auto updated = MakeSchemaSnapshot();
+    auto& derived = updated.classes[1];
+    derived.size = 0x20;
+    derived.fields[0].offset = 0xc;
+    derived.fields[1].type = 0;
+    derived.fields.emplace_back(sdk::snapshot::Field{.name = "m_added", .type = 0, .offset = 0x18});
+    updated.classes[2].fields.erase(updated.classes[2].fields.begin());
+
+    const auto diff = sdk::diff::Compare(MakeSchemaSnapshot(), updated);
+
+    ASSERT_EQ(diff.classes.size(), 2u);
+    EXPECT_EQ(diff.unchanged_classes, 1u);
+
+    const auto& changed = diff.classes[0];
+    EXPECT_EQ(changed.module, "client");
+    EXPECT_EQ(changed.name, "CDerived");
+    EXPECT_EQ(changed.old_class->size, 0x18);
+    EXPECT_EQ(changed.new_class->size, 0x20);
+    EXPECT_EQ(changed.new_class->base_class, "client::CBase");
+    EXPECT_FALSE(changed.metadata_changed);
+
+    ASSERT_EQ(changed.fields.size(), 3u);
+    EXPECT_EQ(changed.fields[0].name, "m_value");
+    EXPECT_EQ(changed.fields[0].old_field->offset, 8);
+    EXPECT_EQ(changed.fields[0].new_field->offset, 0xc);
+    EXPECT_EQ(changed.fields[1].name, "m_name");
+    EXPECT_EQ(changed.fields[1].old_field->type, "CUtlSymbolLarge");
+    EXPECT_EQ(changed.fields[1].new_field, (sdk::diff::FieldState{.type = "int32", .offset = 0x10, .size = 4}));
+    EXPECT_EQ(changed.fields[2].name, "m_added");
+    EXPECT_FALSE(changed.fields[2].old_field.has_value());
+
+    const auto& removed_field = diff.classes[1];
+    EXPECT_EQ(removed_field.name, "CServer");
+    ASSERT_EQ(removed_field.fields.size(), 1u);
+    EXPECT_FALSE(removed_field.fields[0].new_field.has_value());
+}
+
+TEST(SchemaDiff, FindsAddedAndRemovedTypes) {
+    auto updated = MakeSchemaSnapshot();
+    updated.modules["client"].classes = {1};
+    updated.modules["engine2"].classes = {0};
+    updated.classes[0].module = "engine2";
+    updated.enums[0].enumerators[1].value = 2;
+    updated.enums[0].enumerators.emplace_back(sdk::snapshot::Enumerator{.name = "kDone", .value = 3});
+
+    const auto diff = sdk::diff::Compare(MakeSchemaSnapshot(), updated);
+
+    // Sorted by module and name, a class that moved to another module is a different class
+    ASSERT_EQ(diff.classes.size(), 3u);
+    EXPECT_EQ(diff.classes[0].name, "CBase");
+    EXPECT_FALSE(diff.classes[0].new_class.has_value());
+    // The base class is identified by module and name, too
+    EXPECT_EQ(diff.classes[1].name, "CDerived");
+    EXPECT_EQ(diff.classes[1].new_class->base_class, "engine2::CBase");
+    EXPECT_EQ(diff.classes[2].module, "engine2");
+    EXPECT_FALSE(diff.classes[2].old_class.has_value());
+
+    ASSERT_EQ(diff.enums.size(), 1u);
+    ASSERT_EQ(diff.enums[0].enumerators.size(), 2u);
+    EXPECT_EQ(diff.enums[0].enumerators[0].old_value, 1u);
+    EXPECT_EQ(diff.enums[0].enumerators[0].new_value, 2u);
+    EXPECT_EQ(diff.enums[0].enumerators[1].name, "kDone");
+    EXPECT_FALSE(diff.enums[0].enumerators[1].old_value.has_value());
+}
+
+TEST(SchemaDiff, ComparesModuleHashes) {
+    using sdk::snapshot::ModuleHash;
+
+    auto old_schema = MakeSchemaSnapshot();
+    old_schema.module_hashes = {ModuleHash{.name = "libserver.so", .hash = 2}, ModuleHash{.name = "libclient.so", .hash = 1}};
+    auto new_schema = MakeSchemaSnapshot();
+    new_schema.module_hashes = {ModuleHash{.name = "libclient.so", .hash = 1}, ModuleHash{.name = "libserver.so", .hash = 3},
+                                ModuleHash{.name = "libengine2.so", .hash = 4}};
+
+    const auto diff = sdk::diff::Compare(old_schema, new_schema);
+
+    // Types are equal, only the game build differs
+    EXPECT_TRUE(diff.empty());
+    EXPECT_EQ(diff.changed_modules, (std::vector<std::string>{"libengine2.so", "libserver.so"}));
+    EXPECT_EQ(sdk::diff::Compare(old_schema, old_schema).changed_modules, std::vector<std::string>{});
+    // schema.bin doesn't record module hashes
+    EXPECT_EQ(sdk::diff::Compare(old_schema, MakeSchemaSnapshot()).changed_modules, std::nullopt);
+
+    std::ostringstream summary{};
+    sdk::diff::PrintSummary(diff, summary);
+    EXPECT_TRUE(summary.str().contains("\nGame build: different, 2 game module(s) changed: libengine2.so, libserver.so\n")) << summary.str();
+
+    std::ostringstream report{};
+    sdk::diff::WriteReport(diff, report);
+    EXPECT_TRUE(report.str().contains(R"("changed_modules":["libengine2.so","libserver.so"],)")) << report.str();
+}
+
+TEST(SchemaDiff, ComparesSchemaBinaryWithSnapshot) {
+    const auto schema = MakeSchemaSnapshot();
+    const fixtures::AlignedBytes bytes{sdk::SerializeSchemaBinary(schema)};
+    const auto view = source2sdk::schema::View::FromBytes(bytes.get());
+    ASSERT_TRUE(view.has_value());
+
+    const auto converted = sdk::diff::FromSchemaBinary(view.value());
+
+    EXPECT_TRUE(sdk::diff::Compare(schema, converted).empty());
+    EXPECT_TRUE(sdk::diff::Compare(converted, schema).empty());
+}
+
+TEST(SchemaDiff, LoadsSnapshotsAndSchemaBinaries) {
+    const auto directory = std::filesystem::temp_directory_path() / "source2gen-test-schema-diff";
+    std::filesystem::create_directories(directory);
+
+    ASSERT_TRUE(sdk::snapshot::Save(MakeSchemaSnapshot(), directory / "snapshot.bin"));
+    {
+        std::ofstream file{directory / "schema.bin", std::ios::binary};
+        file << sdk::SerializeSchemaBinary(MakeSchemaSnapshot());
+    }
+    {
+        std::ofstream file{directory / "garbage.bin", std::ios::binary};
+        file << "S2SCHEMA but not really";
+    }
+
+    const auto snapshot = sdk::diff::LoadSchema(directory / "snapshot.bin");
+    const auto binary = sdk::diff::LoadSchema(directory / "schema.bin");
+    ASSERT_TRUE(snapshot.has_value()) << snapshot.error();
+    ASSERT_TRUE(binary.has_value()) << binary.error();
+    EXPECT_TRUE(sdk::diff::Compare(snapshot.value(), binary.value()).empty());
+
+    EXPECT_FALSE(sdk::diff::LoadSchema(directory / "garbage.bin").has_value());
+    EXPECT_FALSE(sdk::diff::LoadSchema(directory / "missing.bin").has_value());
+
+    std::filesystem::remove_all(directory);
+}
+
+TEST(SchemaDiff, WritesReportAndSummary) {
+    auto updated = MakeSchemaSnapshot();
+    updated.classes[1].size = 0x20;
+    updated.classes[1].fields[0].offset = 0xc;
+
+    const auto diff = sdk::diff::Compare(MakeSchemaSnapshot(), updated);
+
+    std::ostringstream report{};
+    sdk::diff::WriteReport(diff, report);
+
+    EXPECT_TRUE(report.str().starts_with(R"({"summary":{"classes":{"changed":1,"added":0,"removed":0,"unchanged":2},)"
+                                         R"("enums":{"changed":0,"added":0,"removed":0,"unchanged":1}},"changed_modules":null,)"))
+        << report.str();
+    EXPECT_TRUE(report.str().contains(R"({"module":"client","name":"CDerived","change":"changed",)"
+                                      R"("old":{"size":24,"alignment":null,"flags":1,"base_class":"client::CBase"},)"
+                                      R"("new":{"size":32,"alignment":null,"flags":1,"base_class":"client::CBase"},"metadata_changed":false,)"
+                                      R"("fields":[{"name":"m_value","change":"changed","old":{"type":"int32","offset":8,"size":4},)"
+                                      R"("new":{"type":"int32","offset":12,"size":4},"metadata_changed":false}]})"))
+        << report.str();
+
+    std::ostringstream summary{};
+    sdk::diff::PrintSummary(diff, summary);
+
+    EXPECT_TRUE(summary.str().starts_with("Classes: 1 changed, 0 added, 0 removed, 2 unchanged\n")) << summary.str();
+    EXPECT_TRUE(summary.str().contains("\nGame build: unknown")) << summary.str();
+    EXPECT_TRUE(summary.str().contains("\n~ client::CDerived, size 0x18 -> 0x20\n    ~ m_value, offset 0x8 -> 0xc\n")) << summary.str();
+}
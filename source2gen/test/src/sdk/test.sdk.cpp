@@ -0,0 +1,534 @@
+#include "sdk/amalgamation.h"
+#include "sdk/sdk.h"
+#include "sdk/timing_history.h"
+#include <algorithm>
+#include <filesystem>
+#include <gtest/gtest.h>
+#include <map>
+#include <mutex>
+#include <set>
+#include <utility>
+
+namespace {
+    /// Keeps generated files in memory
+    class MemoryBackend final : public util::IWriteBackend {
+    public:
+        struct Shared {
+            std::mutex mutex{};
+            /// Key is the generic path
+            std::map<std::string, std::string> files{};
+        };
+
+        explicit MemoryBackend(Shared& shared) : _shared(shared) { }
+
+        void Write(std::span<const util::PendingWrite> batch, std::vector<util::WriteError>&) override {
+            std::scoped_lock lock{_shared.mutex};
+
+            for (const auto& file : batch) {
+                _shared.files.insert_or_assign(file.path.generic_string(), file.contents);
+            }
+        }
+
+    private:
+        Shared& _shared;
+    };
+
+    /// client::C_BaseEntity derives from entity2::CEntityInstance and has a few fields
+    sdk::snapshot::Snapshot MakeSnapshot() {
+        using namespace sdk::snapshot;
+
+        return Snapshot{
+            .game = std::string{GetCurrentGame()},
+            .scopes = {Scope{.name = "client.dll",
+                             .declared_types = {{"C_BaseEntity", "client"}, {"CEntityInstance", "entity2"}, {"MoveType_t", "client"}}}},
+            .types =
+                {
+                    Type{.name = "C_BaseEntity", .scope = 0, .category = ETypeCategory::Schema_DeclaredClass, .size = 0x20, .declared_class = 0},
+                    Type{.name = "CEntityInstance", .scope = 0, .category = ETypeCategory::Schema_DeclaredClass, .size = 8, .declared_class = 1},
+                    Type{.name = "int32", .scope = 0, .category = ETypeCategory::Schema_Builtin, .size = 4, .alignment = 4},
+                    Type{.name = "MoveType_t", .scope = 0, .category = ETypeCategory::Schema_DeclaredEnum, .size = 1, .alignment = 1},
+                    Type{.name = "int32[3]",
+                         .scope = 0,
+                         .category = ETypeCategory::Schema_FixedArray,
+                         .size = 12,
+                         .alignment = 4,
+                         .element_type = 2,
+                         .element_count = 3},
+                },
+            .classes =
+                {
+                    Class{.name = "C_BaseEntity",
+                          .module = "client",
+                          .scope = 0,
+                          .self_type = 0,
+                          .size = 0x20,
+                          .base_class = 1,
+                          .fields = {Field{.name = "m_iHealth", .type = 2, .offset = 8, .metadata = {Metadata{.name = "MNetworkEnable"}}},
+                                     Field{.name = "m_MoveType", .type = 3, .offset = 0xc},
+                                     Field{.name = "m_values", .type = 4, .offset = 0x10}}},
+                    Class{.name = "CEntityInstance", .module = "entity2", .scope = 0, .self_type = 1, .size = 8, .registered_alignment = 8},
+                },
+            .enums = {Enum{.name = "MoveType_t",
+                           .module = "client",
+                           .size = 1,
+                           .alignment = 1,
+                           .enumerators = {Enumerator{.name = "MOVETYPE_NONE", .value = 0}, Enumerator{.name = "MOVETYPE_WALK", .value = 2}}}},
+            .modules = {{"client", ModuleTypes{.enums = {0}, .classes = {0}}}, {"entity2", ModuleTypes{.classes = {1}}}},
+        };
+    }
+
+    /// client::CA has fields of type CB and CC, CB has a field of type CC. client::CD has a field of type CUtlVector< CC >.
+    sdk::snapshot::Snapshot MakeIncludeSnapshot() {
+        using namespace sdk::snapshot;
+
+        return Snapshot{
+            .game = std::string{GetCurrentGame()},
+            .scopes = {Scope{.name = "client.dll", .declared_types = {{"CA", "client"}, {"CB", "client"}, {"CC", "client"}, {"CD", "client"}}}},
+            .types =
+                {
+                    Type{.name = "CA", .scope = 0, .category = ETypeCategory::Schema_DeclaredClass, .size = 0x10, .declared_class = 0},
+                    Type{.name = "CB", .scope = 0, .category = ETypeCategory::Schema_DeclaredClass, .size = 8, .declared_class = 1},
+                    Type{.name = "CC", .scope = 0, .category = ETypeCategory::Schema_DeclaredClass, .size = 8, .declared_class = 2},
+                    Type{.name = "CD", .scope = 0, .category = ETypeCategory::Schema_DeclaredClass, .size = 0x18, .declared_class = 3},
+                    Type{.name = "CUtlVector< CC >", .scope = 0, .category = ETypeCategory::Schema_Atomic, .size = 0x18, .alignment = 8},
+                },
+            .classes =
+                {
+                    Class{.name = "CA",
+                          .module = "client",
+                          .scope = 0,
+                          .self_type = 0,
+                          .size = 0x10,
+                          .fields = {Field{.name = "m_b", .type = 1, .offset = 0}, Field{.name = "m_c", .type = 2, .offset = 8}}},
+                    Class{.name = "CB", .module = "client", .scope = 0, .self_type = 1, .size = 8, .fields = {Field{.name = "m_c", .type = 2, .offset = 0}}},
+                    Class{.name = "CC", .module = "client", .scope = 0, .self_type = 2, .size = 8, .registered_alignment = 8},
+                    Class{.name = "CD", .module = "client", .scope = 0, .self_type = 3, .size = 0x18, .fields = {Field{.name = "m_c", .type = 4, .offset = 0}}},
+                },
+            .modules = {{"client", ModuleTypes{.classes = {0, 1, 2, 3}}}},
+        };
+    }
+
+    /// GenerateSdk() writes relative to the working directory
+    class GenerateSdkTest : public testing::Test {
+    protected:
+        void SetUp() override {
+            std::filesystem::remove_all(directory);
+            std::filesystem::create_directories(directory);
+            previous_directory = std::filesystem::current_path();
+            std::filesystem::current_path(directory);
+        }
+
+        void TearDown() override {
+            std::filesystem::current_path(previous_directory);
+            std::filesystem::remove_all(directory);
+        }
+
+        [[nodiscard]] std::map<std::string, std::string> Generate(const sdk::snapshot::Snapshot& schema, const source2_gen::Options& options,
+                                                                  sdk::GeneratorCache& cache, sdk::GeneratorResult* out_result = nullptr) {
+            MemoryBackend::Shared shared{};
+
+            {
+                util::AsyncFileWriter writer{[&shared]() { return std::make_unique<MemoryBackend>(shared); }, util::AsyncWriterOptions{}};
+                sdk::TimingHistory history{};
+
+                const auto targets = sdk::GetEmitTargets(options);
+                auto result = sdk::GenerateSdk(options, targets, cache, writer, schema, history);
+
+                std::size_t type_count = 0;
+                std::size_t static_field_module_count = 0;
+                for (const auto& [_, module] : schema.modules) {
+                    type_count += module.enums.size() + module.classes.size();
+                    static_field_module_count += std::ranges::any_of(module.classes, [&](auto i) { return !schema.classes[i].static_fields.empty(); });
+                }
+
+                EXPECT_EQ(result.generated_files.size(), targets.size());
+                for (std::size_t i = 0; i < targets.size(); ++i) {
+                    const auto& target = targets[i];
+                    EXPECT_EQ(result.generated_files[i].size(),
+                              (target.write_type_files ? type_count : 0) + (target.umbrella_headers ? schema.modules.size() : 0) +
+                                  ((target.umbrella_headers && target.static_members) ? static_field_module_count : 0));
+                }
+                EXPECT_TRUE(writer.Finish().errors.empty());
+
+                if (out_result != nullptr) {
+                    *out_result = std::move(result);
+                }
+            }
+
+            return std::move(shared.files);
+        }
+
+        /// Runs @ref sdk::AmalgamateSdk() and @ref sdk::AssembleModuleUnits() for every target after generating
+        [[nodiscard]] std::map<std::string, std::string> Amalgamate(const sdk::snapshot::Snapshot& schema, const source2_gen::Options& options) {
+            MemoryBackend::Shared shared{};
+
+            {
+                util::AsyncFileWriter writer{[&shared]() { return std::make_unique<MemoryBackend>(shared); }, util::AsyncWriterOptions{}};
+                sdk::GeneratorCache cache{};
+                sdk::TimingHistory history{};
+
+                const auto targets = sdk::GetEmitTargets(options);
+                const auto result = sdk::GenerateSdk(options, targets, cache, writer, schema, history);
+
+                for (std::size_t i = 0; i < targets.size(); ++i) {
+                    sdk::AmalgamateSdk(targets[i], result.files[i], writer);
+                    sdk::AssembleModuleUnits(targets[i], result.files[i], writer);
+                }
+
+                EXPECT_TRUE(writer.Finish().errors.empty());
+            }
+
+            return std::move(shared.files);
+        }
+
+        [[nodiscard]] std::map<std::string, std::string> Generate(const sdk::snapshot::Snapshot& schema, const source2_gen::Options& options) {
+            sdk::GeneratorCache cache{};
+            return Generate(schema, options, cache);
+        }
+
+        [[nodiscard]] std::map<std::string, std::string> Generate(const sdk::snapshot::Snapshot& schema) {
+            return Generate(schema, source2_gen::Options{.static_assertions = true});
+        }
+
+        const std::filesystem::path directory = std::filesystem::temp_directory_path() / "source2gen-test-generate-sdk";
+        std::filesystem::path previous_directory{};
+    };
+} // namespace
+
+TEST_F(GenerateSdkTest, GeneratesClassFromSnapshot) {
+    const auto files = Generate(MakeSnapshot());
+
+    ASSERT_TRUE(files.contains("sdk/include/source2sdk/client/C_BaseEntity.hpp"));
+    const auto& class_ = files.at("sdk/include/source2sdk/client/C_BaseEntity.hpp");
+
+    EXPECT_TRUE(class_.contains("#include \"source2sdk/entity2/CEntityInstance.hpp\"")) << class_;
+    EXPECT_TRUE(class_.contains("#include \"source2sdk/client/MoveType_t.hpp\"")) << class_;
+    EXPECT_TRUE(class_.contains("class C_BaseEntity : public source2sdk::entity2::CEntityInstance")) << class_;
+    EXPECT_TRUE(class_.contains("// metadata: MNetworkEnable")) << class_;
+    EXPECT_TRUE(class_.contains("std::int32_t m_iHealth;")) << class_;
+    EXPECT_TRUE(class_.contains("source2sdk::client::MoveType_t m_MoveType;")) << class_;
+    EXPECT_TRUE(class_.contains("std::int32_t m_values[3];")) << class_;
+    EXPECT_TRUE(class_.contains("static_assert(sizeof(source2sdk::client::C_BaseEntity) == 0x20);")) << class_;
+}
+
+TEST_F(GenerateSdkTest, GeneratesEnumFromSnapshot) {
+    const auto files = Generate(MakeSnapshot());
+
+    ASSERT_TRUE(files.contains("sdk/include/source2sdk/client/MoveType_t.hpp"));
+    const auto& enum_ = files.at("sdk/include/source2sdk/client/MoveType_t.hpp");
+
+    EXPECT_TRUE(enum_.contains("enum class MoveType_t : std::uint8_t")) << enum_;
+    EXPECT_TRUE(enum_.contains("MOVETYPE_WALK = 0x2")) << enum_;
+}
+
+TEST_F(GenerateSdkTest, GeneratesEveryLanguageInOnePass) {
+    const auto files = Generate(MakeSnapshot(), source2_gen::Options{.emit_languages = {source2_gen::Language::cpp, source2_gen::Language::c_ida},
+                                                                     .static_assertions = true});
+
+    ASSERT_TRUE(files.contains("sdk/cpp/include/source2sdk/client/C_BaseEntity.hpp"));
+    ASSERT_TRUE(files.contains("sdk/c-ida/include/source2sdk/client/C_BaseEntity.h"));
+    EXPECT_FALSE(files.contains("sdk/include/source2sdk/client/C_BaseEntity.hpp"));
+
+    EXPECT_TRUE(files.at("sdk/cpp/include/source2sdk/client/C_BaseEntity.hpp").contains("static_assert("));
+    // c-ida doesn't support static assertions
+    EXPECT_FALSE(files.at("sdk/c-ida/include/source2sdk/client/C_BaseEntity.h").contains("static_assert("));
+}
+
+TEST_F(GenerateSdkTest, GeneratesUmbrellaHeaders) {
+    const auto files = Generate(MakeSnapshot(), source2_gen::Options{.emit_languages = {source2_gen::Language::cpp, source2_gen::Language::c}});
+
+    ASSERT_TRUE(files.contains("sdk/cpp/include/source2sdk/client/all.hpp"));
+    ASSERT_TRUE(files.contains("sdk/cpp/include/source2sdk/entity2/all.hpp"));
+    EXPECT_FALSE(files.contains("sdk/c/include/source2sdk/client/all.h"));
+
+    const auto& client = files.at("sdk/cpp/include/source2sdk/client/all.hpp");
+    const auto class_ = client.find("#include \"source2sdk/client/C_BaseEntity.hpp\"");
+    const auto enum_ = client.find("#include \"source2sdk/client/MoveType_t.hpp\"");
+    ASSERT_NE(class_, std::string::npos) << client;
+    ASSERT_NE(enum_, std::string::npos) << client;
+    // Sorted, so the header doesn't change between runs
+    EXPECT_LT(class_, enum_);
+    EXPECT_FALSE(client.contains("entity2")) << client;
+}
+
+TEST_F(GenerateSdkTest, ResolvesTypesOncePerLanguage) {
+    const auto schema = MakeSnapshot();
+    sdk::GeneratorCache cache{};
+    (void)Generate(schema, source2_gen::Options{.emit_languages = {source2_gen::Language::cpp, source2_gen::Language::c}}, cache);
+
+    const auto& int32_array = schema.types[4];
+    const auto fail = []() {
+        ADD_FAILURE() << "type has not been resolved during generation";
+        return sdk::ResolvedType{};
+    };
+
+    const auto& cpp = cache.resolved_types[std::to_underlying(source2_gen::Language::cpp)].GetOrCompute(int32_array, fail);
+    EXPECT_EQ(cpp.name, "std::int32_t");
+    EXPECT_EQ(cpp.array_sizes, std::vector<std::size_t>{3});
+
+    const auto& c = cache.resolved_types[std::to_underlying(source2_gen::Language::c)].GetOrCompute(int32_array, fail);
+    EXPECT_EQ(c.name, "int32_t");
+
+    const auto& names = cache.required_names.GetOrCompute(schema.types[3], []() {
+        ADD_FAILURE() << "names have not been looked up during generation";
+        return std::set<sdk::NameLookup>{};
+    });
+    EXPECT_EQ(names, (std::set<sdk::NameLookup>{{.module = "client", .type_name = "MoveType_t", .source = sdk::NameSource::include}}));
+}
+
+TEST_F(GenerateSdkTest, KeepsFilesForAmalgamation) {
+    sdk::GeneratorCache cache{};
+    sdk::GeneratorResult result{};
+    const auto files = Generate(MakeSnapshot(), source2_gen::Options{.emit_languages = {source2_gen::Language::c_ida}}, cache, &result);
+
+    ASSERT_EQ(result.files.size(), 1);
+    ASSERT_EQ(result.files[0].size(), 3);
+
+    for (const auto& file : result.files[0]) {
+        EXPECT_EQ(file.contents, files.at(file.path.generic_string()));
+    }
+
+    const auto sorted = sdk::SortByIncludes(result.files[0]);
+    EXPECT_EQ(sorted.back()->path, std::filesystem::path{"sdk/include/source2sdk/client/C_BaseEntity.h"});
+    EXPECT_EQ(sorted.back()->includes, (std::vector<std::filesystem::path>{"sdk/include/source2sdk/client/MoveType_t.h",
+                                                                            "sdk/include/source2sdk/entity2/CEntityInstance.h"}));
+}
+
+TEST_F(GenerateSdkTest, KeepsNoFilesByDefault) {
+    sdk::GeneratorCache cache{};
+    sdk::GeneratorResult result{};
+    (void)Generate(MakeSnapshot(), source2_gen::Options{}, cache, &result);
+
+    ASSERT_EQ(result.files.size(), 1);
+    EXPECT_TRUE(result.files[0].empty());
+}
+
+TEST_F(GenerateSdkTest, AmalgamatesModules) {
+    const auto files = Amalgamate(MakeSnapshot(), source2_gen::Options{.amalgamation = source2_gen::Amalgamation::module});
+
+    // One-file-per-type output is kept
+    EXPECT_TRUE(files.contains("sdk/include/source2sdk/client/C_BaseEntity.hpp"));
+
+    ASSERT_TRUE(files.contains("sdk/amalgamated/source2sdk/client.hpp"));
+    ASSERT_TRUE(files.contains("sdk/amalgamated/source2sdk/entity2.hpp"));
+    const auto& client = files.at("sdk/amalgamated/source2sdk/client.hpp");
+
+    EXPECT_TRUE(client.contains("#include \"source2sdk/entity2.hpp\"")) << client;
+    EXPECT_FALSE(client.contains("#include \"source2sdk/client/")) << client;
+    EXPECT_FALSE(client.contains("#include \"source2sdk/entity2/")) << client;
+    // Included once, by the preamble
+    EXPECT_EQ(client.find("#pragma once"), client.rfind("#pragma once")) << client;
+
+    // Enum is defined before the class that uses it
+    const auto enum_ = client.find("enum class MoveType_t");
+    const auto class_ = client.find("class C_BaseEntity :");
+    ASSERT_NE(enum_, std::string::npos) << client;
+    ASSERT_NE(class_, std::string::npos) << client;
+    EXPECT_LT(enum_, class_);
+
+    EXPECT_FALSE(files.at("sdk/amalgamated/source2sdk/entity2.hpp").contains("#include \"source2sdk/client.hpp\""));
+}
+
+TEST_F(GenerateSdkTest, AmalgamatesSdk) {
+    const auto files = Amalgamate(MakeSnapshot(), source2_gen::Options{.amalgamation = source2_gen::Amalgamation::sdk, .amalgamation_only = true});
+
+    // One-file-per-type output is replaced
+    EXPECT_FALSE(files.contains("sdk/include/source2sdk/client/C_BaseEntity.hpp"));
+
+    ASSERT_TRUE(files.contains("sdk/amalgamated/source2sdk.hpp"));
+    const auto& sdk = files.at("sdk/amalgamated/source2sdk.hpp");
+
+    // Base class is defined before the class that derives from it
+    const auto base = sdk.find("class CEntityInstance");
+    const auto derived = sdk.find("class C_BaseEntity :");
+    ASSERT_NE(base, std::string::npos) << sdk;
+    ASSERT_NE(derived, std::string::npos) << sdk;
+    EXPECT_LT(base, derived);
+    EXPECT_FALSE(sdk.contains("#include \"source2sdk/client")) << sdk;
+}
+
+TEST_F(GenerateSdkTest, AssemblesModuleUnits) {
+    const auto files = Amalgamate(MakeSnapshot(), source2_gen::Options{.emit_languages = {source2_gen::Language::cpp_modules}});
+
+    // Types are only written to module interface units
+    EXPECT_FALSE(files.contains("sdk/include/source2sdk/client/C_BaseEntity.hpp"));
+    EXPECT_FALSE(files.contains("sdk/include/source2sdk/client/C_BaseEntity.cppm"));
+
+    ASSERT_TRUE(files.contains("sdk/modules/source2sdk.client.cppm"));
+    ASSERT_TRUE(files.contains("sdk/modules/source2sdk.entity2.cppm"));
+    const auto& client = files.at("sdk/modules/source2sdk.client.cppm");
+
+    EXPECT_TRUE(client.starts_with("module;\n#include <cstddef>\n#include <cstdint>\nexport module source2sdk.client;\n")) << client;
+    EXPECT_TRUE(client.contains("export import source2sdk.source2gen;\n")) << client;
+    EXPECT_TRUE(client.contains("export import source2sdk.entity2;\n")) << client;
+    EXPECT_FALSE(client.contains("#include \"source2sdk/")) << client;
+    EXPECT_TRUE(client.contains("export namespace source2sdk\n{\n    namespace client\n")) << client;
+
+    // Enum is defined before the class that uses it
+    const auto enum_ = client.find("enum class MoveType_t");
+    const auto class_ = client.find("class C_BaseEntity :");
+    ASSERT_NE(enum_, std::string::npos) << client;
+    ASSERT_NE(class_, std::string::npos) << client;
+    EXPECT_LT(enum_, class_);
+
+    EXPECT_FALSE(files.at("sdk/modules/source2sdk.entity2.cppm").contains("import source2sdk.client;"));
+}
+
+TEST_F(GenerateSdkTest, MergesModuleUnitsThatDependOnEachOther) {
+    auto schema = MakeSnapshot();
+    // entity2::CEntityInstance points to client::C_BaseEntity, which derives from it
+    schema.types.emplace_back(sdk::snapshot::Type{
+        .name = "C_BaseEntity*", .scope = 0, .category = ETypeCategory::Schema_Ptr, .size = 8, .alignment = 8, .pointee = 0});
+    schema.classes[1].fields.emplace_back(sdk::snapshot::Field{.name = "m_pEntity", .type = static_cast<sdk::snapshot::Index>(schema.types.size() - 1)});
+
+    const auto files = Amalgamate(schema, source2_gen::Options{.emit_languages = {source2_gen::Language::cpp_modules}});
+
+    ASSERT_TRUE(files.contains("sdk/modules/source2sdk.client.cppm"));
+    ASSERT_TRUE(files.contains("sdk/modules/source2sdk.entity2.cppm"));
+    const auto& client = files.at("sdk/modules/source2sdk.client.cppm");
+    const auto& entity2 = files.at("sdk/modules/source2sdk.entity2.cppm");
+
+    // Types of both modules are in the unit of the first module by name
+    EXPECT_TRUE(client.contains("class C_BaseEntity :")) << client;
+    EXPECT_TRUE(client.contains("class CEntityInstance")) << client;
+    EXPECT_FALSE(client.contains("import source2sdk.entity2;")) << client;
+    // The forward declaration is in the same module as the definition
+    EXPECT_TRUE(client.contains("struct C_BaseEntity;")) << client;
+    EXPECT_LT(client.find("class CEntityInstance"), client.find("class C_BaseEntity :")) << client;
+
+    EXPECT_TRUE(entity2.starts_with("export module source2sdk.entity2;\n")) << entity2;
+    EXPECT_TRUE(entity2.contains("export import source2sdk.client;\n")) << entity2;
+    EXPECT_FALSE(entity2.contains("class")) << entity2;
+}
+
+TEST_F(GenerateSdkTest, GeneratesOffsets) {
+    const auto files = Generate(MakeSnapshot(), source2_gen::Options{.emit_languages = {source2_gen::Language::cpp_offsets}, .static_assertions = true});
+
+    ASSERT_TRUE(files.contains("sdk/include/source2sdk/client/C_BaseEntity.hpp"));
+    const auto& class_ = files.at("sdk/include/source2sdk/client/C_BaseEntity.hpp");
+
+    EXPECT_FALSE(class_.contains("#include \"source2sdk/")) << class_;
+    EXPECT_FALSE(class_.contains("class C_BaseEntity")) << class_;
+    EXPECT_FALSE(class_.contains("static_assert")) << class_;
+    EXPECT_TRUE(class_.contains("// Base: source2sdk::entity2::CEntityInstance")) << class_;
+    EXPECT_TRUE(class_.contains("namespace C_BaseEntity\n")) << class_;
+    EXPECT_TRUE(class_.contains("constexpr std::size_t kSize = 0x20;")) << class_;
+    EXPECT_TRUE(class_.contains("constexpr std::ptrdiff_t m_iHealth = 0x8;")) << class_;
+    EXPECT_TRUE(class_.contains("constexpr std::ptrdiff_t m_MoveType = 0xc;")) << class_;
+    EXPECT_TRUE(class_.contains("constexpr std::ptrdiff_t m_values = 0x10;")) << class_;
+
+    EXPECT_TRUE(files.at("sdk/include/source2sdk/client/MoveType_t.hpp").contains("enum class MoveType_t"));
+    EXPECT_TRUE(files.contains("sdk/include/source2sdk/client/all.hpp"));
+}
+
+TEST_F(GenerateSdkTest, GeneratesOffsetsOfEmittedFieldsOnly) {
+    // m_iHealth overlaps the base class, C_BaseEntity doesn't contain it
+    auto schema = MakeSnapshot();
+    schema.classes[0].fields[0].offset = 4;
+
+    const auto files =
+        Generate(schema, source2_gen::Options{.emit_languages = {source2_gen::Language::cpp, source2_gen::Language::cpp_offsets}});
+    const auto& class_ = files.at("sdk/cpp/include/source2sdk/client/C_BaseEntity.hpp");
+    const auto& offsets = files.at("sdk/cpp-offsets/include/source2sdk/client/C_BaseEntity.hpp");
+
+    EXPECT_TRUE(class_.contains("// Skipped field \"m_iHealth\" @ 0x4 because of the struct collision")) << class_;
+    EXPECT_FALSE(offsets.contains("std::ptrdiff_t m_iHealth")) << offsets;
+    EXPECT_TRUE(offsets.contains("// m_iHealth @ 0x4 has been skipped because of the struct collision")) << offsets;
+    EXPECT_TRUE(offsets.contains("constexpr std::ptrdiff_t m_MoveType = 0xc;")) << offsets;
+}
+
+TEST_F(GenerateSdkTest, GeneratesNoTypesForSchemaExports) {
+    const auto files = Generate(MakeSnapshot(), source2_gen::Options{.emit_languages = {source2_gen::Language::cpp, source2_gen::Language::schema_bin,
+                                                                                       source2_gen::Language::json}});
+
+    EXPECT_TRUE(files.contains("sdk/cpp/include/source2sdk/client/C_BaseEntity.hpp"));
+    EXPECT_TRUE(std::ranges::none_of(files, [](const auto& file) { return file.first.starts_with("sdk/schema-bin/"); }));
+    EXPECT_TRUE(std::ranges::none_of(files, [](const auto& file) { return file.first.starts_with("sdk/json/"); }));
+
+    // Nothing to generate at all
+    EXPECT_TRUE(Generate(MakeSnapshot(), source2_gen::Options{.emit_languages = {source2_gen::Language::schema_bin, source2_gen::Language::json}}).empty());
+}
+
+TEST_F(GenerateSdkTest, GeneratesStaticFieldGetters) {
+    auto schema = MakeSnapshot();
+    schema.classes[0].static_fields = {sdk::snapshot::StaticField{.name = "s_nCount", .type = 2},
+                                       sdk::snapshot::StaticField{.name = "s_values", .type = 4}};
+
+    const auto files = Generate(schema, source2_gen::Options{.emit_languages = {source2_gen::Language::cpp, source2_gen::Language::c},
+                                                             .static_members = true});
+    const auto& class_ = files.at("sdk/cpp/include/source2sdk/client/C_BaseEntity.hpp");
+
+    EXPECT_TRUE(class_.contains("static std::int32_t &Get_s_nCount(){static auto* const instance = reinterpret_cast<std::int32_t*>("
+                                "interfaces::g_schema->FindTypeScopeForModule(\"client.dll\")->FindDeclaredClass(\"C_BaseEntity\")->"
+                                "GetStaticFields()[0]->m_pInstance); return *instance;};"))
+        << class_;
+    EXPECT_FALSE(class_.contains("Get_s_values")) << class_;
+    EXPECT_TRUE(class_.contains("static void ResolveStaticFields()")) << class_;
+    EXPECT_TRUE(class_.contains("(void)Get_s_nCount();")) << class_;
+
+    ASSERT_TRUE(files.contains("sdk/cpp/include/source2sdk/client/static_fields.hpp"));
+    const auto& header = files.at("sdk/cpp/include/source2sdk/client/static_fields.hpp");
+    EXPECT_TRUE(header.contains("#include \"source2sdk/client/C_BaseEntity.hpp\"")) << header;
+    EXPECT_TRUE(header.contains("inline void ResolveStaticFields()")) << header;
+    EXPECT_TRUE(header.contains("C_BaseEntity::ResolveStaticFields();")) << header;
+    EXPECT_FALSE(files.contains("sdk/cpp/include/source2sdk/entity2/static_fields.hpp"));
+
+    EXPECT_FALSE(files.at("sdk/c/include/source2sdk/client/C_BaseEntity.h").contains("ResolveStaticFields"));
+    EXPECT_FALSE(files.contains("sdk/c/include/source2sdk/client/static_fields.h"));
+}
+
+TEST_F(GenerateSdkTest, OmitsStaticFieldGettersIfDisabled) {
+    auto schema = MakeSnapshot();
+    schema.classes[0].static_fields = {sdk::snapshot::StaticField{.name = "s_nCount", .type = 2}};
+
+    const auto files = Generate(schema, source2_gen::Options{.static_members = false});
+
+    EXPECT_FALSE(files.at("sdk/include/source2sdk/client/C_BaseEntity.hpp").contains("s_nCount"));
+    EXPECT_FALSE(files.contains("sdk/include/source2sdk/client/static_fields.hpp"));
+}
+
+TEST_F(GenerateSdkTest, RemovesRedundantIncludes) {
+    const auto files = Generate(MakeIncludeSnapshot());
+    const auto& a = files.at("sdk/include/source2sdk/client/CA.hpp");
+
+    EXPECT_TRUE(a.contains("#include \"source2sdk/client/CB.hpp\"")) << a;
+    // CB.hpp includes CC.hpp
+    EXPECT_FALSE(a.contains("#include \"source2sdk/client/CC.hpp\"")) << a;
+    EXPECT_TRUE(a.contains("source2sdk::client::CC m_c;")) << a;
+}
+
+TEST_F(GenerateSdkTest, ForwardDeclaresArgumentsOfNonOdrTemplates) {
+    const auto included = Generate(MakeIncludeSnapshot(), source2_gen::Options{});
+    EXPECT_TRUE(included.at("sdk/include/source2sdk/client/CD.hpp").contains("#include \"source2sdk/client/CC.hpp\""));
+
+    const auto declared = Generate(MakeIncludeSnapshot(), source2_gen::Options{.non_odr_templates = {"CUtlVector"}});
+    const auto& d = declared.at("sdk/include/source2sdk/client/CD.hpp");
+    EXPECT_FALSE(d.contains("#include \"source2sdk/client/CC.hpp\"")) << d;
+    EXPECT_TRUE(d.contains("struct CC;")) << d;
+}
+
+TEST_F(GenerateSdkTest, ReportsIncludes) {
+    sdk::GeneratorCache cache{};
+    sdk::GeneratorResult result{};
+    (void)Generate(MakeIncludeSnapshot(), source2_gen::Options{.include_report = "report", .non_odr_templates = {"CUtlVector"}}, cache, &result);
+
+    ASSERT_EQ(result.include_report.size(), 4);
+
+    const auto find = [&result](std::string_view name) {
+        return *std::ranges::find(result.include_report, name, [](const auto& el) { return std::string_view{el.type.name}; });
+    };
+
+    const auto a = find("CA");
+    EXPECT_EQ(a.includes_before, 2);
+    EXPECT_EQ(a.includes_after, 1);
+    EXPECT_EQ(a.closure_before, 2);
+    EXPECT_EQ(a.closure_after, 2);
+
+    const auto d = find("CD");
+    EXPECT_EQ(d.includes_before, 1);
+    EXPECT_EQ(d.includes_after, 0);
+    EXPECT_EQ(d.closure_before, 1);
+    EXPECT_EQ(d.closure_after, 0);
+
+    EXPECT_EQ(result.include_report.front().closure_before, 2);
+}
@@ -0,0 +1,226 @@
+#include "sdk/sdk.h"
+#include "sdk/snapshot.h"
+#include "tools/fnv.h"
+#include <array>
+#include <filesystem>
+#include <format>
+#include <fstream>
+#include <gtest/gtest.h>
+#include <iterator>
+#include <limits>
+#include <sdk/interfaces/client/game/datamap_t.h>
+#include <sdk/interfaces/schemasystem/schema.h>
+
+namespace {
+    std::filesystem::path TemporaryPath(std::string_view name) {
+        return std::filesystem::temp_directory_path() / std::format("source2gen-test-{}", name);
+    }
+
+    /// A class with a field of a templated type and a base class
+    sdk::snapshot::Snapshot MakeSnapshot() {
+        using namespace sdk::snapshot;
+
+        return Snapshot{
+            .game = "CS2",
+            .module_hashes = {ModuleHash{.name = "libclient.so", .hash = 0xcbf29ce484222325}},
+            .scopes = {Scope{.name = "client.dll", .declared_types = {{"C_BaseEntity", "client"}, {"CEntityInstance", "entity2"}}}},
+            .types =
+                {
+                    Type{.name = "C_BaseEntity", .scope = 0, .category = ETypeCategory::Schema_DeclaredClass, .size = 0x10, .declared_class = 0},
+                    Type{.name = "CHandle< C_BaseEntity >", .scope = 0, .category = ETypeCategory::Schema_Atomic, .size = 4, .alignment = 4},
+                    Type{.name = "CEntityInstance", .scope = 0, .category = ETypeCategory::Schema_DeclaredClass, .size = 8, .declared_class = 1},
+                    Type{.name = "int32[3]",
+                         .scope = 0,
+                         .category = ETypeCategory::Schema_FixedArray,
+                         .size = 12,
+                         .alignment = 4,
+                         .element_type = 4,
+                         .element_count = 3},
+                    Type{.name = "int32", .category = ETypeCategory::Schema_Builtin, .size = 4, .alignment = 4},
+                },
+            .classes =
+                {
+                    Class{.name = "C_BaseEntity",
+                          .module = "client",
+                          .scope = 0,
+                          .self_type = 0,
+                          .size = 0x1c,
+                          .flags = 1,
+                          .base_class = 1,
+                          .fields = {Field{.name = "m_hOwner",
+                                           .type = 1,
+                                           .offset = 8,
+                                           .metadata = {Metadata{.name = "MNetworkEnable"}, Metadata{.name = "MNetworkAlias", .value = "owner"}}},
+                                     Field{.name = "m_values", .type = 3, .offset = 0xc}},
+                          .static_fields = {StaticField{.name = "s_nCount", .type = 4, .metadata = {Metadata{.name = "MNotSaved"}}}},
+                          .static_metadata = {Metadata{.name = "MNetworkVarNames", .value = "CHandle m_hOwner"}},
+                          .datamap = {DatamapField{.name = "m_flSimulationTime", .type = fieldtype_t::FIELD_FLOAT32, .size = 1, .offset = -4},
+                                      DatamapField{.name = "m_pEmbedded", .type = fieldtype_t::FIELD_EMBEDDED, .size = 1, .offset = 0x20,
+                                                   .embedded_class = "CEmbedded"}}},
+                    Class{.name = "CEntityInstance", .module = "entity2", .scope = 0, .self_type = 2, .size = 8, .registered_alignment = 8},
+                },
+            .enums = {Enum{.name = "MoveType_t",
+                           .module = "client",
+                           .size = 1,
+                           .alignment = 1,
+                           .enumerators = {Enumerator{.name = "MOVETYPE_NONE", .value = 0},
+                                           Enumerator{.name = "MOVETYPE_MAX", .value = 0xff, .metadata = {Metadata{.name = "MEnumeratorIsNotAFlag"}}}},
+                           .static_metadata = {Metadata{.name = "MEnumFlagsWithOverlappingBits"}}}},
+            .modules = {{"client", ModuleTypes{.enums = {0}, .classes = {0}}}, {"entity2", ModuleTypes{.classes = {1}}}},
+        };
+    }
+
+    void WriteFile(const std::filesystem::path& path, std::string_view contents) {
+        std::ofstream f(path, std::ios::binary);
+        f.write(contents.data(), static_cast<std::streamsize>(contents.size()));
+    }
+
+    std::string ReadFile(const std::filesystem::path& path) {
+        std::ifstream f(path, std::ios::binary);
+        return {std::istreambuf_iterator<char>{f}, std::istreambuf_iterator<char>{}};
+    }
+
+    /// Bindings of the modules "client" and "server", as the schema system would return them. They don't have fields, scopes, or types,
+    /// capturing those would call into the schema system.
+    class FakeBindings {
+    public:
+        /// @param reverse Stores the bindings and inserts them into the dump in reverse order, so they end up at other addresses and in
+        /// another iteration order
+        explicit FakeBindings(bool reverse) {
+            constexpr std::array<std::pair<const char*, const char*>, kClassCount> kClasses{
+                {{"C_BaseEntity", "client"}, {"C_BasePlayerPawn", "client"}, {"C_World", "client"}, {"CServerEntity", "server"}}};
+            constexpr std::array<const char*, kEnumCount> kEnums{"EClientState", "ELifeState", "EDormantState"};
+
+            const auto position = [reverse](std::size_t i, std::size_t count) { return reverse ? count - 1 - i : i; };
+
+            for (std::size_t i = 0; i < kClassCount; ++i) {
+                auto& class_ = _classes[position(i, kClassCount)];
+                class_.m_pszName = kClasses[i].first;
+                class_.m_pszModule = kClasses[i].second;
+                class_.m_unAlignOf = std::numeric_limits<std::uint8_t>::max();
+            }
+            for (std::size_t i = 0; i < kEnumCount; ++i) {
+                auto& enum_ = _enums[position(i, kEnumCount)];
+                enum_.m_pszName = kEnums[i];
+                enum_.m_pszModule = "client";
+                enum_.m_unSizeOf = 4;
+                enum_.m_unAlignOf = 4;
+            }
+
+            // C_BasePlayerPawn -> C_BaseEntity, CServerEntity -> C_World across modules
+            _base_classes[0] = SchemaBaseClassInfoData_t{.m_unOffset = 0, .m_pClass = &_classes[position(0, kClassCount)]};
+            _base_classes[1] = SchemaBaseClassInfoData_t{.m_unOffset = 0, .m_pClass = &_classes[position(2, kClassCount)]};
+            _classes[position(1, kClassCount)].m_nBaseClassSize = 1;
+            _classes[position(1, kClassCount)].m_pBaseClasses = &_base_classes[0];
+            _classes[position(3, kClassCount)].m_nBaseClassSize = 1;
+            _classes[position(3, kClassCount)].m_pBaseClasses = &_base_classes[1];
+
+            for (std::size_t i = 0; i < kClassCount; ++i) {
+                const auto& class_ = _classes[position(i, kClassCount)];
+                _modules[class_.m_pszModule].classes.emplace(&class_);
+            }
+            for (std::size_t i = 0; i < kEnumCount; ++i) {
+                _modules["client"].enums.emplace(&_enums[position(i, kEnumCount)]);
+            }
+        }
+
+        [[nodiscard]] const std::unordered_map<std::string, sdk::ModuleDump>& GetModules() const {
+            return _modules;
+        }
+
+    private:
+        static constexpr std::size_t kClassCount = 4;
+        static constexpr std::size_t kEnumCount = 3;
+
+        std::array<CSchemaClassInfo, kClassCount> _classes{};
+        std::array<CSchemaEnumInfo, kEnumCount> _enums{};
+        std::array<SchemaBaseClassInfoData_t, 2> _base_classes{};
+        std::unordered_map<std::string, sdk::ModuleDump> _modules{};
+    };
+} // namespace
+
+TEST(Snapshot, RoundTrip) {
+    const auto path = TemporaryPath("snapshot-round-trip");
+    const auto snapshot = MakeSnapshot();
+
+    ASSERT_TRUE(sdk::snapshot::Save(snapshot, path));
+    const auto loaded = sdk::snapshot::Load(path);
+    std::filesystem::remove(path);
+
+    ASSERT_TRUE(loaded.has_value()) << loaded.error();
+    EXPECT_EQ(loaded.value(), snapshot);
+}
+
+TEST(Snapshot, RejectsUnknownFormat) {
+    const auto path = TemporaryPath("snapshot-unknown-format");
+    WriteFile(path, "source2gen-snapshot 0\n");
+
+    const auto loaded = sdk::snapshot::Load(path);
+    std::filesystem::remove(path);
+
+    EXPECT_FALSE(loaded.has_value());
+}
+
+TEST(Snapshot, RejectsTruncatedFile) {
+    const auto path = TemporaryPath("snapshot-truncated");
+    ASSERT_TRUE(sdk::snapshot::Save(MakeSnapshot(), path));
+
+    const auto contents = ReadFile(path);
+    WriteFile(path, std::string_view{contents}.substr(0, contents.size() - 3));
+
+    const auto loaded = sdk::snapshot::Load(path);
+    std::filesystem::remove(path);
+
+    EXPECT_FALSE(loaded.has_value());
+}
+
+TEST(Snapshot, RejectsDanglingReference) {
+    const auto path = TemporaryPath("snapshot-dangling-reference");
+    auto snapshot = MakeSnapshot();
+    snapshot.classes[0].base_class = 2;
+    ASSERT_TRUE(sdk::snapshot::Save(snapshot, path));
+
+    const auto loaded = sdk::snapshot::Load(path);
+    std::filesystem::remove(path);
+
+    EXPECT_FALSE(loaded.has_value());
+}
+
+TEST(Snapshot, CaptureDoesntDependOnBindingOrder) {
+    const FakeBindings bindings{false};
+    const FakeBindings reversed_bindings{true};
+
+    const auto snapshot = sdk::snapshot::Capture(bindings.GetModules(), {});
+    const auto reversed = sdk::snapshot::Capture(reversed_bindings.GetModules(), {});
+
+    // Types of a module are in name order
+    const auto& client = snapshot.modules.at("client");
+    ASSERT_EQ(client.classes.size(), 3u);
+    EXPECT_EQ(snapshot.classes[client.classes[0]].name, "C_BaseEntity");
+    EXPECT_EQ(snapshot.classes[client.classes[2]].name, "C_World");
+    ASSERT_EQ(client.enums.size(), 3u);
+    EXPECT_EQ(snapshot.enums[client.enums[0]].name, "EClientState");
+    EXPECT_EQ(snapshot.enums[client.enums[2]].name, "ELifeState");
+    EXPECT_EQ(snapshot.classes[snapshot.classes[snapshot.modules.at("server").classes[0]].base_class].name, "C_World");
+
+    const auto path = TemporaryPath("snapshot-capture-order");
+    const auto reversed_path = TemporaryPath("snapshot-capture-order-reversed");
+    ASSERT_TRUE(sdk::snapshot::Save(snapshot, path));
+    ASSERT_TRUE(sdk::snapshot::Save(reversed, reversed_path));
+
+    EXPECT_EQ(ReadFile(path), ReadFile(reversed_path));
+
+    std::filesystem::remove(path);
+    std::filesystem::remove(reversed_path);
+}
+
+TEST(Snapshot, HashModuleBinary) {
+    const auto path = TemporaryPath("snapshot-module-binary");
+    WriteFile(path, std::string_view{"a\0b", 3});
+
+    const auto hash = sdk::snapshot::HashModuleBinary(path);
+    std::filesystem::remove(path);
+
+    EXPECT_EQ(hash, fnv64::hash_bytes(std::string_view{"a\0b", 3}));
+    EXPECT_EQ(sdk::snapshot::HashModuleBinary(TemporaryPath("snapshot-module-binary-does-not-exist")), std::nullopt);
+}
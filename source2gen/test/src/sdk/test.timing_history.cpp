@@ -0,0 +1,64 @@
+#include "sdk/timing_history.h"
+#include <chrono>
+#include <filesystem>
+#include <format>
+#include <fstream>
+#include <gtest/gtest.h>
+
+namespace {
+    std::filesystem::path TemporaryPath(std::string_view name) {
+        return std::filesystem::temp_directory_path() / std::format("source2gen-test-{}", name);
+    }
+} // namespace
+
+TEST(TimingHistory, RoundTrip) {
+    const auto path = TemporaryPath("timing-history-round-trip");
+
+    sdk::TimingHistory history{};
+    history.Record(sdk::TypeIdentifier{.module = "client", .name = "C_BaseEntity"}, std::chrono::nanoseconds{1234});
+    history.Record(sdk::TypeIdentifier{.module = "server", .name = "CBaseEntity"}, std::chrono::nanoseconds{5678});
+    ASSERT_TRUE(history.Save(path));
+
+    const auto loaded = sdk::TimingHistory::Load(path);
+    std::filesystem::remove(path);
+
+    EXPECT_EQ(loaded.Find(sdk::TypeIdentifier{.module = "client", .name = "C_BaseEntity"}), std::chrono::nanoseconds{1234});
+    EXPECT_EQ(loaded.Find(sdk::TypeIdentifier{.module = "server", .name = "CBaseEntity"}), std::chrono::nanoseconds{5678});
+    EXPECT_EQ(loaded.Find(sdk::TypeIdentifier{.module = "client", .name = "CBaseEntity"}), std::nullopt);
+}
+
+TEST(TimingHistory, MissingFileIsEmpty) {
+    EXPECT_TRUE(sdk::TimingHistory::Load(TemporaryPath("timing-history-does-not-exist")).IsEmpty());
+}
+
+TEST(TimingHistory, SkipsMalformedLines) {
+    const auto path = TemporaryPath("timing-history-malformed");
+
+    {
+        std::ofstream f(path);
+        f << "source2gen-timing-history 1\n"
+          << "client\tC_BaseEntity\t100\n"
+          << "client\tno-duration\n"
+          << "client\tC_BasePlayerPawn\tabc\n";
+    }
+
+    const auto loaded = sdk::TimingHistory::Load(path);
+    std::filesystem::remove(path);
+
+    EXPECT_EQ(loaded.Find(sdk::TypeIdentifier{.module = "client", .name = "C_BaseEntity"}), std::chrono::nanoseconds{100});
+    EXPECT_EQ(loaded.Find(sdk::TypeIdentifier{.module = "client", .name = "C_BasePlayerPawn"}), std::nullopt);
+}
+
+TEST(TimingHistory, IgnoresUnknownFormat) {
+    const auto path = TemporaryPath("timing-history-unknown-format");
+
+    {
+        std::ofstream f(path);
+        f << "client\tC_BaseEntity\t100\n";
+    }
+
+    const auto loaded = sdk::TimingHistory::Load(path);
+    std::filesystem::remove(path);
+
+    EXPECT_TRUE(loaded.IsEmpty());
+}
@@ -0,0 +1,191 @@
+#include "tools/writer/async_writer.h"
+#include "tools/writer/backend_io_uring.h"
+#include "tools/writer/backend_posix.h"
+#include "tools/writer/backend_stream.h"
+#include <atomic>
+#include <filesystem>
+#include <format>
+#include <fstream>
+#include <gtest/gtest.h>
+#include <mutex>
+#include <set>
+#include <sstream>
+
+namespace {
+    /// Records file names instead of writing them. Fails every file whose name starts with "fail".
+    class FakeBackend final : public util::IWriteBackend {
+    public:
+        struct Shared {
+            std::mutex mutex{};
+            std::set<std::string> written{};
+            std::atomic<std::size_t> largest_batch{0};
+        };
+
+        explicit FakeBackend(Shared& shared) : _shared(shared) { }
+
+        void Write(std::span<const util::PendingWrite> batch, std::vector<util::WriteError>& errors) override {
+            std::scoped_lock lock{_shared.mutex};
+
+            _shared.largest_batch = std::max(_shared.largest_batch.load(), batch.size());
+
+            for (const auto& file : batch) {
+                if (file.path.filename().string().starts_with("fail")) {
+                    errors.emplace_back(util::WriteError{.path = file.path, .message = "fake error"});
+                } else {
+                    _shared.written.emplace(file.contents);
+                }
+            }
+        }
+
+    private:
+        Shared& _shared;
+    };
+
+    [[nodiscard]] std::string ReadFile(const std::filesystem::path& path) {
+        std::ifstream f(path);
+        std::stringstream ss{};
+        ss << f.rdbuf();
+        return ss.str();
+    }
+
+    /// Writes a few files with @p backend to a fresh directory and checks their contents
+    void ExpectBackendWritesFiles(util::IWriteBackend& backend, std::string_view name) {
+        const auto directory = std::filesystem::temp_directory_path() / std::format("source2gen-test-writer-{}", name);
+        std::filesystem::remove_all(directory);
+        std::filesystem::create_directories(directory);
+
+        std::vector<util::PendingWrite> batch{};
+        for (int i = 0; i < 300; ++i) {
+            batch.emplace_back(util::PendingWrite{.path = directory / std::format("{}.hpp", i), .contents = std::format("// file {}\n", i)});
+        }
+        batch.emplace_back(util::PendingWrite{.path = directory / "empty.hpp", .contents = ""});
+        batch.emplace_back(util::PendingWrite{.path = directory / "missing" / "directory.hpp", .contents = "unreachable"});
+
+        // Existing files are truncated
+        std::ofstream{directory / "0.hpp"} << "this is longer than the new contents of the file";
+
+        std::vector<util::WriteError> errors{};
+        backend.Write(batch, errors);
+
+        ASSERT_EQ(errors.size(), 1);
+        EXPECT_EQ(errors[0].path, directory / "missing" / "directory.hpp");
+
+        for (std::size_t i = 0; i < batch.size() - 1; ++i) {
+            EXPECT_EQ(ReadFile(batch[i].path), batch[i].contents);
+        }
+
+        std::filesystem::remove_all(directory);
+    }
+} // namespace
+
+TEST(AsyncFileWriter, WritesAllFiles) {
+    FakeBackend::Shared shared{};
+
+    util::AsyncFileWriter writer{[&shared]() { return std::make_unique<FakeBackend>(shared); },
+                                 util::AsyncWriterOptions{.thread_count = 3, .queue_capacity = 8, .batch_size = 4}};
+
+    for (int i = 0; i < 1000; ++i) {
+        writer.Enqueue(std::format("{}.hpp", i), std::to_string(i));
+    }
+
+    const auto summary = writer.Finish();
+    EXPECT_TRUE(summary.errors.empty());
+    EXPECT_EQ(summary.written, 1000);
+    EXPECT_EQ(shared.written.size(), 1000);
+    EXPECT_LE(shared.largest_batch.load(), 4);
+}
+
+TEST(AsyncFileWriter, CollectsErrors) {
+    FakeBackend::Shared shared{};
+
+    util::AsyncFileWriter writer{[&shared]() { return std::make_unique<FakeBackend>(shared); }, util::AsyncWriterOptions{}};
+
+    writer.Enqueue("fail-1.hpp", "");
+    writer.Enqueue("ok.hpp", "ok");
+    writer.Enqueue("fail-2.hpp", "");
+
+    auto errors = writer.Finish().errors;
+    std::ranges::sort(errors, {}, &util::WriteError::path);
+
+    ASSERT_EQ(errors.size(), 2);
+    EXPECT_EQ(errors[0].path, "fail-1.hpp");
+    EXPECT_EQ(errors[1].path, "fail-2.hpp");
+    EXPECT_EQ(shared.written, std::set<std::string>{"ok"});
+}
+
+TEST(AsyncFileWriter, FinishWithoutFiles) {
+    FakeBackend::Shared shared{};
+
+    util::AsyncFileWriter writer{[&shared]() { return std::make_unique<FakeBackend>(shared); }, util::AsyncWriterOptions{}};
+
+    EXPECT_TRUE(writer.Finish().errors.empty());
+}
+
+TEST(AsyncFileWriter, FlushWritesQueuedFiles) {
+    FakeBackend::Shared shared{};
+
+    util::AsyncFileWriter writer{[&shared]() { return std::make_unique<FakeBackend>(shared); }, util::AsyncWriterOptions{}};
+
+    for (int i = 0; i < 100; ++i) {
+        writer.Enqueue(std::format("{}.hpp", i), std::to_string(i));
+    }
+    writer.Flush();
+
+    {
+        std::scoped_lock lock{shared.mutex};
+        EXPECT_EQ(shared.written.size(), 100);
+    }
+
+    writer.Enqueue("after-flush.hpp", "after-flush");
+    EXPECT_EQ(writer.Finish().written, 101);
+}
+
+TEST(AsyncFileWriter, SkipsUnchangedFiles) {
+    const auto directory = std::filesystem::temp_directory_path() / "source2gen-test-writer-skip";
+    std::filesystem::remove_all(directory);
+    std::filesystem::create_directories(directory);
+
+    const auto run = [&](std::string_view changed_contents) {
+        auto index = util::OutputIndex::Load(directory / "index");
+        util::AsyncFileWriter writer{[]() { return std::make_unique<util::StreamWriteBackend>(); }, util::AsyncWriterOptions{}, &index};
+
+        writer.Enqueue(directory / "unchanged.hpp", "unchanged");
+        writer.Enqueue(directory / "changed.hpp", std::string{changed_contents});
+
+        auto summary = writer.Finish();
+        index.Save(directory / "index");
+        return summary;
+    };
+
+    const auto first = run("old");
+    EXPECT_EQ(first.written, 2);
+    EXPECT_EQ(first.skipped, 0);
+
+    const auto second = run("new");
+    EXPECT_EQ(second.written, 1);
+    EXPECT_EQ(second.skipped, 1);
+    EXPECT_EQ(ReadFile(directory / "changed.hpp"), "new");
+
+    std::filesystem::remove_all(directory);
+}
+
+TEST(WriteBackend, Stream) {
+    util::StreamWriteBackend backend{};
+    ExpectBackendWritesFiles(backend, "stream");
+}
+
+#if TARGET_OS == LINUX
+TEST(WriteBackend, Posix) {
+    util::PosixWriteBackend backend{};
+    ExpectBackendWritesFiles(backend, "posix");
+}
+
+TEST(WriteBackend, IoUring) {
+    auto backend = util::IoUringWriteBackend::Create();
+    if (!backend.has_value()) {
+        GTEST_SKIP() << "io_uring is unavailable: " << backend.error();
+    }
+
+    ExpectBackendWritesFiles(*backend.value(), "io-uring");
+}
+#endif
@@ -0,0 +1,76 @@
+#include "tools/json_writer.h"
+#include <gtest/gtest.h>
+#include <sstream>
+
+TEST(JsonWriter, SeparatesValues) {
+    std::ostringstream out{};
+
+    {
+        util::JsonWriter json{out};
+        json.BeginObject();
+        json.Key("a");
+        json.Number(1);
+        json.Key("b");
+        json.BeginArray();
+        json.Bool(true);
+        json.Null();
+        json.BeginObject();
+        json.EndObject();
+        json.BeginArray();
+        json.EndArray();
+        json.Number(-2);
+        json.EndArray();
+        json.Key("c");
+        json.String("d");
+        json.EndObject();
+    }
+
+    EXPECT_EQ(out.str(), R"({"a":1,"b":[true,null,{},[],-2],"c":"d"})");
+}
+
+TEST(JsonWriter, EscapesStrings) {
+    std::ostringstream out{};
+
+    {
+        util::JsonWriter json{out};
+        json.BeginArray();
+        json.String("say \"hi\"\\\n\t\x01");
+        json.String("CHandle< C_BaseEntity >");
+        json.EndArray();
+    }
+
+    EXPECT_EQ(out.str(), R"(["say \"hi\"\\\n\t\u0001","CHandle< C_BaseEntity >"])");
+}
+
+TEST(JsonWriter, WritesLargeNumbers) {
+    std::ostringstream out{};
+
+    {
+        util::JsonWriter json{out};
+        json.BeginArray();
+        json.Number(std::uint64_t{0xffffffffffffffff});
+        json.Number(std::int64_t{-0x7fffffffffffffff - 1});
+        json.Number(std::uint8_t{255});
+        json.EndArray();
+    }
+
+    EXPECT_EQ(out.str(), "[18446744073709551615,-9223372036854775808,255]");
+}
+
+TEST(JsonWriter, FlushesWhileWriting) {
+    std::ostringstream out{};
+    util::JsonWriter json{out};
+
+    json.BeginArray();
+    while (out.str().empty()) {
+        json.String("0123456789abcdef");
+    }
+
+    // Output is handed to the stream in chunks, not all at once at the end
+    EXPECT_GE(out.str().size(), util::JsonWriter::kBufferSize);
+    EXPECT_LT(out.str().size(), util::JsonWriter::kBufferSize + 32);
+
+    json.EndArray();
+    json.Flush();
+    EXPECT_TRUE(out.str().ends_with(R"("0123456789abcdef"])"));
+}
@@ -0,0 +1,91 @@
+#include "tools/writer/output_index.h"
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <gtest/gtest.h>
+
+namespace {
+    class OutputIndexTest : public testing::Test {
+    protected:
+        void SetUp() override {
+            std::filesystem::remove_all(directory);
+            std::filesystem::create_directories(directory);
+        }
+
+        void TearDown() override {
+            std::filesystem::remove_all(directory);
+        }
+
+        /// Writes @p contents to @p name and records it in @p index
+        void WriteAndRecord(util::OutputIndex& index, std::string_view name, std::string_view contents) const {
+            std::ofstream{directory / name} << contents;
+            index.Record(directory / name, util::OutputIndex::MakeEntry(contents));
+        }
+
+        /// Saves and reloads @p index, like a new run would
+        [[nodiscard]] util::OutputIndex Reload(const util::OutputIndex& index) const {
+            EXPECT_TRUE(index.Save(directory / "index"));
+            return util::OutputIndex::Load(directory / "index");
+        }
+
+        const std::filesystem::path directory = std::filesystem::temp_directory_path() / "source2gen-test-output-index";
+    };
+} // namespace
+
+TEST_F(OutputIndexTest, UnchangedFileIsUpToDate) {
+    util::OutputIndex index{};
+    WriteAndRecord(index, "a.hpp", "contents");
+
+    auto reloaded = Reload(index);
+
+    EXPECT_TRUE(reloaded.IsUpToDate(directory / "a.hpp", util::OutputIndex::MakeEntry("contents")));
+    EXPECT_FALSE(reloaded.IsUpToDate(directory / "a.hpp", util::OutputIndex::MakeEntry("new contents")));
+    EXPECT_FALSE(reloaded.IsUpToDate(directory / "b.hpp", util::OutputIndex::MakeEntry("contents")));
+}
+
+TEST_F(OutputIndexTest, DeletedFileIsNotUpToDate) {
+    util::OutputIndex index{};
+    WriteAndRecord(index, "a.hpp", "contents");
+
+    auto reloaded = Reload(index);
+    std::filesystem::remove(directory / "a.hpp");
+
+    EXPECT_FALSE(reloaded.IsUpToDate(directory / "a.hpp", util::OutputIndex::MakeEntry("contents")));
+}
+
+TEST_F(OutputIndexTest, ModifiedFileIsNotUpToDate) {
+    util::OutputIndex index{};
+    WriteAndRecord(index, "a.hpp", "contents");
+
+    auto reloaded = Reload(index);
+
+    // Same size, so only the modification time tells that the file has been touched
+    std::ofstream{directory / "a.hpp"} << "CONTENTS";
+    std::filesystem::last_write_time(directory / "a.hpp", std::filesystem::last_write_time(directory / "index") + std::chrono::seconds{1});
+
+    EXPECT_FALSE(reloaded.IsUpToDate(directory / "a.hpp", util::OutputIndex::MakeEntry("contents")));
+}
+
+TEST_F(OutputIndexTest, UnusedFilesAreStale) {
+    util::OutputIndex index{};
+    WriteAndRecord(index, "kept.hpp", "kept");
+    WriteAndRecord(index, "rewritten.hpp", "old");
+    WriteAndRecord(index, "stale.hpp", "stale");
+
+    auto reloaded = Reload(index);
+    EXPECT_TRUE(reloaded.IsUpToDate(directory / "kept.hpp", util::OutputIndex::MakeEntry("kept")));
+    reloaded.Record(directory / "rewritten.hpp", util::OutputIndex::MakeEntry("new"));
+
+    EXPECT_EQ(reloaded.TakeStaleFiles(), std::vector<std::filesystem::path>{directory / "stale.hpp"});
+    EXPECT_TRUE(reloaded.TakeStaleFiles().empty());
+}
+
+TEST_F(OutputIndexTest, ForgottenFileIsNotUpToDate) {
+    util::OutputIndex index{};
+    WriteAndRecord(index, "a.hpp", "contents");
+    index.Forget(directory / "a.hpp");
+
+    auto reloaded = Reload(index);
+
+    EXPECT_FALSE(reloaded.IsUpToDate(directory / "a.hpp", util::OutputIndex::MakeEntry("contents")));
+}
@@ -0,0 +1,55 @@
+#include "tools/thread_pool.h"
+#include <atomic>
+#include <gtest/gtest.h>
+#include <stdexcept>
+#include <vector>
+
+TEST(ThreadPool, RunsAllTasks) {
+    util::ThreadPool pool{4};
+    std::vector<int> results(1000);
+
+    for (std::size_t i = 0; i < results.size(); ++i) {
+        pool.Submit([&results, i]() { results[i] = static_cast<int>(i) * 2; });
+    }
+
+    pool.Wait();
+
+    for (std::size_t i = 0; i < results.size(); ++i) {
+        EXPECT_EQ(results[i], static_cast<int>(i) * 2);
+    }
+}
+
+TEST(ThreadPool, CanBeReusedAfterWait) {
+    util::ThreadPool pool{2};
+    std::atomic<int> counter{0};
+
+    for (int round = 0; round < 3; ++round) {
+        for (int i = 0; i < 100; ++i) {
+            pool.Submit([&counter]() { ++counter; });
+        }
+        pool.Wait();
+        EXPECT_EQ(counter.load(), (round + 1) * 100);
+    }
+}
+
+TEST(ThreadPool, RethrowsTaskErrors) {
+    util::ThreadPool pool{3};
+    std::atomic<int> counter{0};
+
+    pool.Submit([]() { throw std::runtime_error{"oops"}; });
+    for (int i = 0; i < 50; ++i) {
+        pool.Submit([&counter]() { ++counter; });
+    }
+
+    EXPECT_THROW(pool.Wait(), std::runtime_error);
+    // the failing task doesn't stop the others
+    EXPECT_EQ(counter.load(), 50);
+    // the error has been consumed
+    EXPECT_NO_THROW(pool.Wait());
+}
+
+TEST(ThreadPool, ResolvesThreadCount) {
+    EXPECT_EQ(util::ThreadPool::ResolveThreadCount(5), 5);
+    EXPECT_GE(util::ThreadPool::ResolveThreadCount(0), 1);
+    EXPECT_EQ(util::ThreadPool{3}.GetThreadCount(), 3);
+}